@@ -0,0 +1,149 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (2018) Alexander Stukowski
+//
+//  This file is part of OVITO (Open Visualization Tool).
+//
+//  OVITO is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  OVITO is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+//
+// Microbenchmark for the work-stealing ThreadPool behind parallelFor() and parallelForChunks().
+// Compares it with the former scheme, which started one std::async thread per core on every call
+// and split the index range into equal static chunks. Measures the overhead of a call with a trivial
+// loop body and the wall time of loops whose per-index cost is uniform or concentrated in one region.
+//
+
+#include <core/Core.h>
+#include <core/utilities/concurrent/ParallelFor.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <future>
+
+using namespace Ovito;
+
+namespace {
+
+/// The static scheme used by parallelForChunks() before the introduction of the thread pool.
+template<class Function>
+void staticParallelForChunks(size_t loopCount, size_t numThreads, Function kernel)
+{
+	std::vector<std::future<void>> workers;
+	if(numThreads > loopCount) {
+		if(loopCount == 0) return;
+		numThreads = loopCount;
+	}
+	size_t chunkSize = loopCount / numThreads;
+	size_t startIndex = 0;
+	for(size_t t = 0; t < numThreads; t++) {
+		if(t == numThreads - 1) {
+			chunkSize += loopCount % numThreads;
+			kernel(startIndex, chunkSize);
+		}
+		else {
+			workers.push_back(std::async(std::launch::async, [&kernel, startIndex, chunkSize]() {
+				kernel(startIndex, chunkSize);
+			}));
+		}
+		startIndex += chunkSize;
+	}
+	for(auto& t : workers)
+		t.get();
+}
+
+/// Burns CPU time proportional to the given amount of work.
+double work(size_t amount)
+{
+	double x = 0;
+	for(size_t i = 0; i < amount; i++)
+		x += std::sqrt((double)i + x * 1e-9);
+	return x;
+}
+
+/// Measures the average wall time of a function in microseconds.
+template<class Function>
+double measure(int repetitions, Function func)
+{
+	auto t0 = std::chrono::steady_clock::now();
+	for(int r = 0; r < repetitions; r++)
+		func();
+	auto t1 = std::chrono::steady_clock::now();
+	return std::chrono::duration<double, std::micro>(t1 - t0).count() / repetitions;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	ThreadPool& pool = ThreadPool::instance();
+	size_t numThreads = pool.queueCount();
+	std::printf("Worker threads: %d\n\n", pool.workerCount());
+
+	std::atomic<double> sink{0};
+	auto consume = [&sink](double x) {
+		double expected = sink.load();
+		while(!sink.compare_exchange_weak(expected, expected + x)) {}
+	};
+
+	// Per-call overhead with a trivial loop body.
+	for(size_t count : { (size_t)1, (size_t)64, (size_t)4096 }) {
+		double tStatic = measure(2000, [&]() {
+			staticParallelForChunks(count, numThreads, [](size_t, size_t) {});
+		});
+		double tPool = measure(2000, [&]() {
+			parallelForChunks(count, [](size_t, size_t) {});
+		});
+		std::printf("Call overhead, %5zu elements:   static %8.2f us   pool %8.2f us\n", count, tStatic, tPool);
+	}
+	std::printf("\n");
+
+	// Loops with uniform and imbalanced per-index cost.
+	const size_t count = (argc > 1) ? (size_t)std::atoll(argv[1]) : 20000;
+	struct Scenario { const char* name; size_t (*cost)(size_t index, size_t count); };
+	const Scenario scenarios[] = {
+		{ "uniform",              [](size_t, size_t) -> size_t { return 200; } },
+		{ "hot spot (1/16)",      [](size_t i, size_t n) -> size_t { return (i < n / 16) ? 3000 : 20; } },
+		{ "linear ramp",          [](size_t i, size_t n) -> size_t { return 400 * i / n; } },
+		{ "rare outliers (1/97)", [](size_t i, size_t) -> size_t { return (i % 97 == 0) ? 20000 : 20; } },
+	};
+	for(const Scenario& scenario : scenarios) {
+		auto kernel = [&](size_t startIndex, size_t chunkSize) {
+			double x = 0;
+			for(size_t i = startIndex; i < startIndex + chunkSize; i++)
+				x += work(scenario.cost(i, count));
+			consume(x);
+		};
+		double tStatic = measure(5, [&]() { staticParallelForChunks(count, numThreads, kernel); });
+		double tPool = measure(5, [&]() { parallelForChunks(count, kernel); });
+		std::printf("Load balance, %-22s static %10.1f us   pool %10.1f us   speedup %.2f\n", scenario.name, tStatic, tPool, tStatic / tPool);
+	}
+
+	// Nested parallelism: an outer loop over a few expensive items, each running an inner parallel loop.
+	double tNested = measure(5, [&]() {
+		parallelFor(8, [&](int) {
+			parallelForChunks(count, [&](size_t startIndex, size_t chunkSize) {
+				double x = 0;
+				for(size_t i = startIndex; i < startIndex + chunkSize; i++)
+					x += work(20);
+				consume(x);
+			});
+		});
+	});
+	std::printf("\nNested loops (8 x %zu):         pool %10.1f us\n", count, tNested);
+
+	return 0;
+}
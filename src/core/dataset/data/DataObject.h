@@ -125,6 +125,12 @@ public:
 	/// under the data source section. The default implementation returns false.
 	virtual bool showInPipelineEditor() const { return false; }
 
+	/// Adds the memory buffers held by this data object (not including sub-objects) to the given list.
+	/// Each buffer is identified by its address, so that buffers shared by several data objects can be counted once.
+	/// This is used by the PipelineCache to determine the memory footprint of cached pipeline states.
+	/// The default implementation reports no buffers.
+	virtual void collectMemoryBuffers(std::vector<std::pair<const void*, size_t>>& /*buffers*/) const {}
+
 	/// \brief Visits the direct sub-objects of this data object
 	///        and invokes the given visitor function for every sub-objects.
 	///
@@ -23,12 +23,17 @@
 #include <core/app/PluginManager.h>
 #include <core/utilities/io/FileManager.h>
 #include <core/utilities/concurrent/Promise.h>
+#include <core/utilities/concurrent/Task.h>
+#include <core/utilities/concurrent/ThreadPool.h>
+#include <core/utilities/io/CompressedTextWriter.h>
 #include <core/dataset/DataSet.h>
 #include <core/dataset/DataSetContainer.h>
 #include <core/dataset/scene/PipelineSceneNode.h>
 #include <core/dataset/animation/AnimationSettings.h>
 #include "FileExporter.h"
 
+#include <QBuffer>
+
 namespace Ovito { OVITO_BEGIN_INLINE_NAMESPACE(DataIO)
 
 IMPLEMENT_OVITO_CLASS(FileExporter);
@@ -40,6 +45,7 @@ DEFINE_PROPERTY_FIELD(FileExporter, startFrame);
 DEFINE_PROPERTY_FIELD(FileExporter, endFrame);
 DEFINE_PROPERTY_FIELD(FileExporter, everyNthFrame);
 DEFINE_PROPERTY_FIELD(FileExporter, floatOutputPrecision);
+DEFINE_PROPERTY_FIELD(FileExporter, framesInFlight);
 DEFINE_REFERENCE_FIELD(FileExporter, nodeToExport);
 DEFINE_PROPERTY_FIELD(FileExporter, dataObjectToExport);
 SET_PROPERTY_FIELD_LABEL(FileExporter, outputFilename, "Output filename");
@@ -50,7 +56,84 @@ SET_PROPERTY_FIELD_LABEL(FileExporter, startFrame, "Start frame");
 SET_PROPERTY_FIELD_LABEL(FileExporter, endFrame, "End frame");
 SET_PROPERTY_FIELD_LABEL(FileExporter, everyNthFrame, "Every Nth frame");
 SET_PROPERTY_FIELD_LABEL(FileExporter, floatOutputPrecision, "Output precision");
+SET_PROPERTY_FIELD_LABEL(FileExporter, framesInFlight, "Frames processed in parallel");
 SET_PROPERTY_FIELD_UNITS_AND_RANGE(FileExporter, floatOutputPrecision, IntegerParameterUnit, 1, std::numeric_limits<FloatType>::max_digits10);
+SET_PROPERTY_FIELD_UNITS_AND_RANGE(FileExporter, framesInFlight, IntegerParameterUnit, 1, 64);
+
+namespace {
+
+	/// Formats one animation frame in a worker thread, either into a memory buffer or directly into a separate output file.
+	/// The task does not own the frame writer function, which may hold references to data objects. It is kept alive
+	/// by the caller in the main thread until the task has finished.
+	class FrameExportTask : public AsynchronousTask<QByteArray>
+	{
+	public:
+
+		/// Constructor. An empty output path makes the task write the frame into a memory buffer, which becomes the result of the task.
+		FrameExportTask(const FileExporter::FrameWriterFunction& writer, const QString& outputPath, int floatPrecision, DataSet* context) :
+			_writer(writer), _outputPath(outputPath), _floatPrecision(floatPrecision), _context(context), _operation(SignalPromise::create(true)) {
+			_operationState = _operation.sharedState();
+		}
+
+		/// Interrupts the frame writer. Unlike cancel(), this is noticed by a writer function that is already running.
+		void interrupt() {
+			_operationState->cancel();
+			cancel();
+		}
+
+		/// Is called by the worker thread.
+		virtual void perform() override {
+			if(_operationState->isCanceled())
+				return;
+			AsyncOperation operation(std::move(_operation));
+			if(_outputPath.isEmpty()) {
+				QBuffer buffer;
+				buffer.open(QIODevice::WriteOnly);
+				bool completed;
+				{
+					CompressedTextWriter stream(buffer, QString(), _context);
+					stream.setFloatPrecision(_floatPrecision);
+					completed = _writer(stream, std::move(operation));
+				}
+				if(!completed)
+					cancel();
+				setResult(buffer.data());
+			}
+			else {
+				QFile file(_outputPath);
+				bool completed = false;
+				try {
+					CompressedTextWriter stream(file, _context);
+					stream.setFloatPrecision(_floatPrecision);
+					completed = _writer(stream, std::move(operation));
+				}
+				catch(...) {
+					file.close();
+					file.remove();
+					throw;
+				}
+				file.close();
+				if(!completed) {
+					file.remove();
+					cancel();
+				}
+				setResult(QByteArray());
+			}
+		}
+
+	private:
+
+		const FileExporter::FrameWriterFunction& _writer;
+		QString _outputPath;
+		int _floatPrecision;
+		DataSet* _context;
+
+		/// The operation passed to the frame writer. Its state only keeps track of interrupt requests,
+		/// which makes it safe to cancel it from the main thread.
+		SignalPromise _operation;
+		PromiseStatePtr _operationState;
+	};
+}
 
 /******************************************************************************
 * Constructs a new instance of the class.
@@ -61,7 +144,8 @@ FileExporter::FileExporter(DataSet* dataset) : RefTarget(dataset),
 	_startFrame(0), 
 	_endFrame(-1),
 	_everyNthFrame(1),
-	_floatOutputPrecision(10)
+	_floatOutputPrecision(10),
+	_framesInFlight(1)
 {
 	// Use the entire animation interval as default export interval.
 	int lastFrame = dataset->animationSettings()->timeToFrame(dataset->animationSettings()->animationInterval().end());
@@ -160,8 +244,17 @@ PipelineFlowState FileExporter::getPipelineDataToBeExported(TimePoint time, Asyn
 	if(!pipeline)
 		throwException(tr("The scene object to be exported is not a data pipeline."));
 
+	// Use the pipeline output that has been requested ahead of time during a pipelined export.
+	SharedFuture<PipelineFlowState> evalFuture;
+	if(!requestRenderState) {
+		auto prefetched = std::find_if(_prefetchedStates.begin(), _prefetchedStates.end(), [time](const auto& entry) { return entry.first == time; });
+		if(prefetched != _prefetchedStates.end())
+			evalFuture = prefetched->second;
+	}
+
 	// Evaluate pipeline.
-	auto evalFuture = requestRenderState ? pipeline->evaluateRenderingPipeline(time) : pipeline->evaluatePipeline(time);
+	if(!evalFuture.isValid())
+		evalFuture = requestRenderState ? pipeline->evaluateRenderingPipeline(time) : pipeline->evaluatePipeline(time);
 	if(!operation.waitForFuture(evalFuture))
 		return {};
 	PipelineFlowState state = evalFuture.result();
@@ -224,32 +317,38 @@ bool FileExporter::doExport(AsyncOperation&& operation)
 
 		// Export animation frames.
 		operation.setProgressMaximum(numberOfFrames);			
-		for(int frameIndex = 0; frameIndex < numberOfFrames; frameIndex++) {
-			operation.setProgressValue(frameIndex);
+		if(exportAnimation() && framesInFlight() > 1 && numberOfFrames > 1) {
+			if(!exportFramesPipelined(firstFrameNumber, numberOfFrames, exportTime, operation))
+				return false;
+		}
+		else {
+			for(int frameIndex = 0; frameIndex < numberOfFrames; frameIndex++) {
+				operation.setProgressValue(frameIndex);
 
-			int frameNumber = firstFrameNumber + frameIndex * everyNthFrame();
+				int frameNumber = firstFrameNumber + frameIndex * everyNthFrame();
 
-			if(exportAnimation() && useWildcardFilename()) {
-				// Generate an output filename based on the wildcard pattern.
-				filename = dir.absoluteFilePath(wildcardFilename());
-				filename.replace(QChar('*'), QString::number(frameNumber));
+				if(exportAnimation() && useWildcardFilename()) {
+					// Generate an output filename based on the wildcard pattern.
+					filename = dir.absoluteFilePath(wildcardFilename());
+					filename.replace(QChar('*'), QString::number(frameNumber));
 
-				if(!openOutputFile(filename, 1, operation))
-					return false;
-			}
+					if(!openOutputFile(filename, 1, operation))
+						return false;
+				}
 
-			operation.setProgressText(tr("Exporting frame %1 to file '%2'").arg(frameNumber).arg(filename));
+				operation.setProgressText(tr("Exporting frame %1 to file '%2'").arg(frameNumber).arg(filename));
 
-			exportFrame(frameNumber, exportTime, filename, operation.createSubOperation());
+				exportFrame(frameNumber, exportTime, filename, operation.createSubOperation());
 
-			if(exportAnimation() && useWildcardFilename())
-				closeOutputFile(!operation.isCanceled());
+				if(exportAnimation() && useWildcardFilename())
+					closeOutputFile(!operation.isCanceled());
 
-			if(operation.isCanceled())
-				break;
+				if(operation.isCanceled())
+					break;
 
-			// Go to next animation frame.
-			exportTime += dataset()->animationSettings()->ticksPerFrame() * everyNthFrame();
+				// Go to next animation frame.
+				exportTime += dataset()->animationSettings()->ticksPerFrame() * everyNthFrame();
+			}
 		}
 	}
 	catch(...) {
@@ -266,6 +365,141 @@ bool FileExporter::doExport(AsyncOperation&& operation)
 	return !operation.isCanceled();
 }
 
+/******************************************************************************
+ * Exports a sequence of animation frames. Evaluates the pipeline for the next
+ * frames and formats frames in worker threads while earlier frames are being
+ * written.
+ *****************************************************************************/
+bool FileExporter::exportFramesPipelined(int firstFrameNumber, int numberOfFrames, TimePoint firstTime, AsyncOperation& operation)
+{
+	PipelineSceneNode* pipeline = dynamic_object_cast<PipelineSceneNode>(nodeToExport());
+	if(!pipeline)
+		throwException(tr("The scene object to be exported is not a data pipeline."));
+
+	QDir dir = QFileInfo(outputFilename()).dir();
+	bool separateFiles = useWildcardFilename();
+	TimePoint timeStep = dataset()->animationSettings()->ticksPerFrame() * everyNthFrame();
+
+	// A frame that is being formatted by a worker thread.
+	struct PendingFrame {
+		FrameWriterFunction writer;
+		std::shared_ptr<FrameExportTask> task;
+		Future<QByteArray> future;
+	};
+
+	// The frames handed over to worker threads, in the order of export. Frames formatted
+	// out of order wait in this queue until all earlier frames have been written to the output file.
+	std::deque<PendingFrame> pendingFrames;
+
+	// Waits for the worker formatting the oldest pending frame and appends its text to the output file.
+	auto completeOldestFrame = [&]() {
+		PendingFrame& frame = pendingFrames.front();
+		if(!operation.waitForFuture(frame.future))
+			return false;
+		QByteArray text = frame.future.result();
+		if(!separateFiles)
+			writeFormattedFrame(text);
+		pendingFrames.pop_front();
+		return true;
+	};
+
+	// Stops all workers. The frame writer functions may only be released after the workers are done with them.
+	auto abandonPendingFrames = [&]() {
+		for(PendingFrame& frame : pendingFrames)
+			frame.task->interrupt();
+		for(PendingFrame& frame : pendingFrames) {
+			while(!frame.task->isFinished())
+				QThread::yieldCurrentThread();
+		}
+		pendingFrames.clear();
+		_prefetchedStates.clear();
+	};
+
+	try {
+		int nextPrefetchIndex = 0;
+		for(int frameIndex = 0; frameIndex < numberOfFrames; frameIndex++) {
+			operation.setProgressValue(frameIndex);
+
+			int frameNumber = firstFrameNumber + frameIndex * everyNthFrame();
+			TimePoint time = firstTime + frameIndex * timeStep;
+
+			// Request the pipeline output for the next frames, which gets computed in the background while the current frame is being written.
+			for(; nextPrefetchIndex < std::min(numberOfFrames, frameIndex + framesInFlight()); nextPrefetchIndex++) {
+				TimePoint prefetchTime = firstTime + nextPrefetchIndex * timeStep;
+				_prefetchedStates.emplace_back(prefetchTime, pipeline->evaluatePipeline(prefetchTime));
+			}
+
+			QString filename = outputFilename();
+			if(separateFiles) {
+				// Generate an output filename based on the wildcard pattern.
+				filename = dir.absoluteFilePath(wildcardFilename());
+				filename.replace(QChar('*'), QString::number(frameNumber));
+			}
+
+			operation.setProgressText(tr("Exporting frame %1 to file '%2'").arg(frameNumber).arg(filename));
+
+			PipelineFlowState state = getPipelineDataToBeExported(time, operation);
+			if(operation.isCanceled())
+				break;
+			FrameWriterFunction writer = prepareFrameWriter(state, frameNumber, time, filename);
+
+			if(writer) {
+				// Limit the number of frames being formatted at the same time.
+				while(pendingFrames.size() >= (size_t)framesInFlight()) {
+					if(!completeOldestFrame())
+						break;
+				}
+				if(operation.isCanceled())
+					break;
+
+				pendingFrames.push_back(PendingFrame{ std::move(writer) });
+				PendingFrame& frame = pendingFrames.back();
+				frame.task = std::make_shared<FrameExportTask>(frame.writer, separateFiles ? filename : QString(), floatOutputPrecision(), dataset());
+				frame.future = frame.task->future();
+				std::shared_ptr<FrameExportTask> task = frame.task;
+				ThreadPool::instance().submit([task]() { task->run(); });
+			}
+			else {
+				// The exporter can write this frame only in the main thread.
+				// Earlier frames must be written first to keep the order of frames in the output file.
+				while(!pendingFrames.empty()) {
+					if(!completeOldestFrame())
+						break;
+				}
+				if(operation.isCanceled())
+					break;
+
+				if(separateFiles && !openOutputFile(filename, 1, operation)) {
+					abandonPendingFrames();
+					return false;
+				}
+				exportFrame(frameNumber, time, filename, operation.createSubOperation());
+				if(separateFiles)
+					closeOutputFile(!operation.isCanceled());
+				if(operation.isCanceled())
+					break;
+			}
+
+			// The pipeline output for this frame is no longer needed.
+			while(!_prefetchedStates.empty() && _prefetchedStates.front().first <= time)
+				_prefetchedStates.pop_front();
+		}
+
+		// Write the remaining frames.
+		while(!pendingFrames.empty() && !operation.isCanceled()) {
+			if(!completeOldestFrame())
+				break;
+		}
+	}
+	catch(...) {
+		abandonPendingFrames();
+		throw;
+	}
+	abandonPendingFrames();
+
+	return true;
+}
+
 /******************************************************************************
  * Exports a single animation frame to the current output file.
  *****************************************************************************/
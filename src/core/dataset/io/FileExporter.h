@@ -27,6 +27,11 @@
 #include <core/dataset/DataSet.h>
 #include <core/dataset/scene/SceneNode.h>
 #include <core/dataset/data/DataObjectReference.h>
+#include <core/dataset/pipeline/PipelineFlowState.h>
+#include <core/utilities/concurrent/SharedFuture.h>
+
+#include <deque>
+#include <functional>
 
 namespace Ovito { OVITO_BEGIN_INLINE_NAMESPACE(DataIO)
 
@@ -107,6 +112,10 @@ public:
 	/// \brief Returns a string with the list of available data objects of the given type.
 	QString getAvailableDataObjectList(const PipelineFlowState& state, const DataObject::OOMetaClass& objectType) const;
 
+	/// Function that writes one animation frame to a text stream. It is executed in a worker thread and
+	/// returns \c false if the operation has been canceled.
+	using FrameWriterFunction = std::function<bool(CompressedTextWriter& stream, AsyncOperation&& operation)>;
+
 protected:
 
 	/// Initializes the object.
@@ -121,8 +130,28 @@ protected:
 	/// \brief Exports a single animation frame to the current output file.
 	virtual bool exportFrame(int frameNumber, TimePoint time, const QString& filePath, AsyncOperation&& operation);
 
+	/// \brief Prepares the export of a single animation frame in a worker thread.
+	/// \param state The pipeline output to be exported.
+	/// \param frameNumber The animation frame to be written.
+	/// \param time The animation time to be written.
+	/// \param filePath The path of the output file.
+	/// \return A function that formats the frame, or an empty function if the frame must be exported in the main thread by exportFrame().
+	///
+	/// This is called from the main thread during a pipelined export (see framesInFlight()). The returned function
+	/// may only read the pipeline output and must not modify the state of the exporter, because several frames get formatted at the same time.
+	/// The default implementation returns an empty function.
+	virtual FrameWriterFunction prepareFrameWriter(const PipelineFlowState& state, int frameNumber, TimePoint time, const QString& filePath) { return {}; }
+
+	/// \brief Appends the text of a frame produced by a FrameWriterFunction to the current output file.
+	/// Must be implemented by exporters that return a FrameWriterFunction from prepareFrameWriter() and support multi-frame files.
+	virtual void writeFormattedFrame(const QByteArray& text) {}
+
 private:
 
+	/// Exports a sequence of animation frames. Evaluates the pipeline for the next frames and formats frames in worker threads
+	/// while earlier frames are being written. Returns false if an output file could not be opened.
+	bool exportFramesPipelined(int firstFrameNumber, int numberOfFrames, TimePoint firstTime, AsyncOperation& operation);
+
 	/// The output file path.
 	DECLARE_PROPERTY_FIELD(QString, outputFilename);
 
@@ -147,11 +176,17 @@ private:
 	/// Controls the desired precision with which floating-point numbers are written if the format is text-based.
 	DECLARE_MODIFIABLE_PROPERTY_FIELD(int, floatOutputPrecision, setFloatOutputPrecision);
 
+	/// The number of animation frames that are processed at the same time during export. A value of 1 exports one frame after the other.
+	DECLARE_MODIFIABLE_PROPERTY_FIELD(int, framesInFlight, setFramesInFlight);
+
 	/// The scene node to be exported.
 	DECLARE_MODIFIABLE_REFERENCE_FIELD_FLAGS(SceneNode, nodeToExport, setNodeToExport, PROPERTY_FIELD_NO_SUB_ANIM);
 
 	/// The specific data object from the pipeline output to be exported.
 	DECLARE_MODIFIABLE_PROPERTY_FIELD(DataObjectReference, dataObjectToExport, setDataObjectToExport);
+
+	/// The pipeline outputs that have been requested ahead of time during a pipelined export.
+	std::deque<std::pair<TimePoint, SharedFuture<PipelineFlowState>>> _prefetchedStates;
 };
 
 OVITO_END_INLINE_NAMESPACE
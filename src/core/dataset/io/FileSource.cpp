@@ -31,6 +31,7 @@
 #include <core/dataset/io/FileImporter.h>
 #include <core/dataset/DataSetContainer.h>
 #include <core/dataset/UndoStack.h>
+#include <core/utilities/concurrent/ThreadPool.h>
 #include "FileSource.h"
 
 namespace Ovito { OVITO_BEGIN_INLINE_NAMESPACE(DataIO)
@@ -365,62 +366,56 @@ Future<PipelineFlowState> FileSource::requestFrameInternal(int frame)
 
 			const FileSourceImporter::Frame& frameInfo = sourceFrames[frame];
 
-			// Retrieve the file.
-			Future<PipelineFlowState> loadFrameFuture = Application::instance()->fileManager()->fetchUrl(dataset()->container()->taskManager(), frameInfo.sourceFile)
-				.then(executor(), [this, frameInfo, frame, interval](const QString& filename) -> Future<PipelineFlowState> {
-					
-					// Without an importer object we have to give up immediately.
-					if(!importer()) {
-						// In case of an error, just return the stale data that we have cached.
-						return PipelineFlowState(dataCollection(), PipelineStatus(PipelineStatus::Error, tr("The file source path has not been set.")));
+			// Without an importer object we have to give up immediately.
+			if(!importer()) {
+				// In case of an error, just return the stale data that we have cached.
+				return PipelineFlowState(dataCollection(), PipelineStatus(PipelineStatus::Error, tr("The file source path has not been set.")));
+			}
+
+			// Load the frame data in a background thread, unless this has already been started by the prefetcher.
+			// Collect results from the loader in the UI thread once it has finished running.
+			Future<PipelineFlowState> loadFrameFuture = loadFrameData(frame, frameInfo, false)
+				.then(executor(), [this, frame, frameInfo, interval](const FileSourceImporter::FrameDataPtr& frameData) {
+
+					UndoSuspender noUndo(this);
+
+					// Remember the size of the frame, which serves as an estimate for frames that are still being loaded ahead of time.
+					_loadedFrameMemoryUsage = frameData->memoryUsage();
+
+					// Let the file importer work with the data collection of this FileSource if there is one from a previous load operation.
+					OORef<DataCollection> oldData = dataCollection();
+
+					// Make a copy of the existing data collection when not loading the current timestep.
+					// That's because we want the data collection of the FileSource to always reflect the current time only,
+					// so the importer should not touch the original data collection.
+					if(!interval.contains(dataset()->animationSettings()->time())) {
+						oldData = CloneHelper().cloneObject(oldData, true);
 					}
 
-					// Create the frame loader for the requested frame.
-					FileSourceImporter::FrameLoaderPtr frameLoader = importer()->createFrameLoader(frameInfo, filename);
-					OVITO_ASSERT(frameLoader);
-					
-					// Execute the loader in a background thread.
-					// Collect results from the loader in the UI thread once it has finished running.
-					return dataset()->container()->taskManager().runTaskAsync(frameLoader)
-						.then(executor(), [this, frame, frameInfo, interval](FileSourceImporter::FrameDataPtr&& frameData) {
-
-							UndoSuspender noUndo(this);
-
-							// Let the file importer work with the data collection of this FileSource if there is one from a previous load operation.
-							OORef<DataCollection> oldData = dataCollection();
-
-							// Make a copy of the existing data collection when not loading the current timestep.
-							// That's because we want the data collection of the FileSource to always reflect the current time only,
-							// so the importer should not touch the original data collection.
-							if(!interval.contains(dataset()->animationSettings()->time())) {
-								oldData = CloneHelper().cloneObject(oldData, true);
-							}
-
-							// Let the data container insert its data into the pipeline state.
-							_handOverInProgress = true;
-							try {
-								OORef<DataCollection> loadedData = frameData->handOver(oldData, _isNewFile, this);
-								oldData.reset();
-								_isNewFile = false;
-								_handOverInProgress = false;
-								loadedData->addAttribute(QStringLiteral("SourceFrame"), frame, this);
-								loadedData->addAttribute(QStringLiteral("SourceFile"), frameInfo.sourceFile.toString(QUrl::RemovePassword | QUrl::PreferLocalFile | QUrl::PrettyDecoded), this);
-								
-								// When loading the current frame, make the new data collection the data collection of this 
-								// FileSource so that it appears in the pipeline editor.
-								if(interval.contains(dataset()->animationSettings()->time())) {
-									setDataCollection(loadedData);
-									setStoredFrameIndex(frame);
-								}
-
-								// Build and return the result pipeline state.
-								return PipelineFlowState(std::move(loadedData), frameData->status(), interval);
-							}
-							catch(...) {
-								_handOverInProgress = false;
-								throw;
-							}
-						});
+					// Let the data container insert its data into the pipeline state.
+					_handOverInProgress = true;
+					try {
+						OORef<DataCollection> loadedData = frameData->handOver(oldData, _isNewFile, this);
+						oldData.reset();
+						_isNewFile = false;
+						_handOverInProgress = false;
+						loadedData->addAttribute(QStringLiteral("SourceFrame"), frame, this);
+						loadedData->addAttribute(QStringLiteral("SourceFile"), frameInfo.sourceFile.toString(QUrl::RemovePassword | QUrl::PreferLocalFile | QUrl::PrettyDecoded), this);
+						
+						// When loading the current frame, make the new data collection the data collection of this 
+						// FileSource so that it appears in the pipeline editor.
+						if(interval.contains(dataset()->animationSettings()->time())) {
+							setDataCollection(loadedData);
+							setStoredFrameIndex(frame);
+						}
+
+						// Build and return the result pipeline state.
+						return PipelineFlowState(std::move(loadedData), frameData->status(), interval);
+					}
+					catch(...) {
+						_handOverInProgress = false;
+						throw;
+					}
 				});
 
 			// Change status to 'pending' during long-running load operations.
@@ -461,6 +456,138 @@ Future<PipelineFlowState> FileSource::requestFrameInternal(int frame)
 			});
 }
 
+/******************************************************************************
+* Loads the data of a source frame, or picks up the results of an earlier
+* prefetch operation for that frame.
+******************************************************************************/
+SharedFuture<FileSourceImporter::FrameDataPtr> FileSource::loadFrameData(int frame, const FileSourceImporter::Frame& frameInfo, bool isPrefetch)
+{
+	// Use the frame data loaded ahead of time if it belongs to the same version of the frame.
+	auto prefetched = _prefetchedFrames.find(frame);
+	if(prefetched != _prefetchedFrames.end()) {
+		SharedFuture<FileSourceImporter::FrameDataPtr> future = std::move(prefetched->second.future);
+		bool isUsable = !(prefetched->second.frameInfo != frameInfo) && !future.isCanceled();
+		_prefetchedFrames.erase(prefetched);
+		if(isUsable)
+			return future;
+	}
+
+	// Retrieve the file.
+	return Application::instance()->fileManager()->fetchUrl(dataset()->container()->taskManager(), frameInfo.sourceFile)
+		.then(executor(), [this, frameInfo, isPrefetch](const QString& filename) -> Future<FileSourceImporter::FrameDataPtr> {
+
+			// Without an importer object we have to give up immediately.
+			if(!importer())
+				throwException(tr("The file source path has not been set."));
+
+			// Create the frame loader for the requested frame.
+			FileSourceImporter::FrameLoaderPtr frameLoader = importer()->createFrameLoader(frameInfo, filename);
+			OVITO_ASSERT(frameLoader);
+
+			// Execute the loader in a background thread. Frames loaded ahead of time are not registered
+			// with the task manager, because they should not show up in the user interface.
+			if(isPrefetch) {
+				ThreadPool::instance().submit([frameLoader]() { frameLoader->run(); });
+				return frameLoader->future();
+			}
+			return dataset()->container()->taskManager().runTaskAsync(frameLoader);
+		});
+}
+
+/******************************************************************************
+* Starts loading the source frames that follow the given frame in the current
+* playback direction.
+******************************************************************************/
+void FileSource::prefetchFrames(int frame)
+{
+	// Detect a sequential access pattern from the sequence of requested frames. Playback visits neighboring frames,
+	// while rendering or exporting every n-th frame makes several steps of the same size. Any other request, e.g. a
+	// one-off evaluation of some frame, stops the prefetching.
+	if(frame != _lastRequestedFrame) {
+		int step = (_lastRequestedFrame >= 0) ? (frame - _lastRequestedFrame) : 0;
+		_prefetchStride = (step == 1 || step == -1 || (step != 0 && step == _lastFrameStep)) ? step : 0;
+		_lastFrameStep = step;
+		_lastRequestedFrame = frame;
+	}
+
+	// Discard frames that are no longer ahead of the requested one. This cancels their loaders if still running.
+	// The requested frame itself is kept, because the request may not have picked it up yet.
+	int depth = (_prefetchStride != 0) ? prefetchDepth() : 0;
+	for(auto iter = _prefetchedFrames.begin(); iter != _prefetchedFrames.end(); ) {
+		int offset = iter->first - frame;
+		if(offset != 0 && (_prefetchStride == 0 || offset % _prefetchStride != 0 || offset / _prefetchStride < 0 || offset / _prefetchStride > depth))
+			iter = _prefetchedFrames.erase(iter);
+		else
+			++iter;
+	}
+	if(!importer() || _frames.empty() || depth <= 0)
+		return;
+
+	// Account for the memory taken up by frames that have already been loaded. Frames that are still being
+	// loaded are estimated to be as large as the most recently loaded frame.
+	size_t memoryLimit = prefetchMemoryLimit();
+	size_t memoryUsage = 0;
+	for(const auto& entry : _prefetchedFrames) {
+		const SharedFuture<FileSourceImporter::FrameDataPtr>& future = entry.second.future;
+		if(!future.isFinished()) {
+			memoryUsage += _loadedFrameMemoryUsage;
+		}
+		else if(!future.isCanceled()) {
+			try { memoryUsage += future.result()->memoryUsage(); }
+			catch(const Exception&) {}
+		}
+	}
+
+	for(int distance = 1; distance <= depth && memoryUsage + _loadedFrameMemoryUsage <= memoryLimit; distance++) {
+		int nextFrame = frame + distance * _prefetchStride;
+		if(nextFrame < 0 || nextFrame >= _frames.size())
+			break;
+		if(_prefetchedFrames.find(nextFrame) != _prefetchedFrames.end())
+			continue;
+
+		// Skip frames whose pipeline output is still cached.
+		if(pipelineCache().contains(sourceFrameToAnimationTime(nextFrame)))
+			continue;
+
+		// Only prefetch local files. Remote files are downloaded when actually needed.
+		const FileSourceImporter::Frame& frameInfo = _frames[nextFrame];
+		if(!frameInfo.sourceFile.isLocalFile())
+			continue;
+
+		_prefetchedFrames.emplace(nextFrame, PrefetchedFrame{ frameInfo, loadFrameData(nextFrame, frameInfo, true) });
+		memoryUsage += _loadedFrameMemoryUsage;
+	}
+}
+
+/******************************************************************************
+* Returns the source frames that are being loaded or have been loaded ahead of time.
+******************************************************************************/
+std::vector<int> FileSource::prefetchedFrames() const
+{
+	std::vector<int> frames;
+	for(const auto& entry : _prefetchedFrames)
+		frames.push_back(entry.first);
+	return frames;
+}
+
+/******************************************************************************
+* Returns the number of source frames that are loaded ahead of time.
+******************************************************************************/
+int FileSource::prefetchDepth()
+{
+	static const int depth = QSettings().value("core/file_source/prefetch_depth", 2).toInt();
+	return depth;
+}
+
+/******************************************************************************
+* Returns the maximum amount of memory that frames loaded ahead of time may occupy.
+******************************************************************************/
+size_t FileSource::prefetchMemoryLimit()
+{
+	static const size_t limit = (size_t)QSettings().value("core/file_source/prefetch_memory_limit", QVariant::fromValue((qulonglong)1024 << 20)).toULongLong();
+	return limit;
+}
+
 /******************************************************************************
 * This will trigger a reload of an animation frame upon next request.
 ******************************************************************************/
@@ -486,6 +613,10 @@ void FileSource::invalidateFrameCache(int frameIndex)
 	if(frameIndex == -1 || frameIndex == storedFrameIndex()) {
 		setStoredFrameIndex(-1);
 	}
+	if(frameIndex == -1)
+		_prefetchedFrames.clear();
+	else
+		_prefetchedFrames.erase(frameIndex);
 	invalidatePipelineCache();
 }
 
@@ -630,7 +761,14 @@ SharedFuture<PipelineFlowState> FileSource::evaluate(TimePoint time, bool breakO
 			pipelineCache().insert(PipelineFlowState(dataCollection(), oldCachedState.status(), oldCachedState.stateValidity()), this);
 		}
 	}
-	return CachingPipelineObject::evaluate(time, breakOnError);
+	SharedFuture<PipelineFlowState> future = CachingPipelineObject::evaluate(time, breakOnError);
+
+	// Load the next frames in the background while the requested one is being processed.
+	int frame = animationTimeToSourceFrame(time);
+	if(frame >= 0 && frame < numberOfFrames())
+		prefetchFrames(frame);
+
+	return future;
 }
 
 /******************************************************************************
@@ -96,6 +96,15 @@ public:
 	/// Returns the current status of the pipeline object.
 	virtual PipelineStatus status() const override;
 
+	/// Returns the number of source frames that are loaded in the background ahead of the frame currently being requested.
+	static int prefetchDepth();
+
+	/// Returns the maximum amount of memory (in bytes) that may be occupied by frames loaded ahead of time.
+	static size_t prefetchMemoryLimit();
+
+	/// Returns the source frames that are being loaded or have been loaded ahead of time, in ascending order.
+	std::vector<int> prefetchedFrames() const;
+
 	/// Returns the list of data objects that are managed by this data source.
 	/// The returned data objects will be displayed as sub-objects of the data source in the pipeline editor.
 	virtual DataCollection* getSourceDataCollection() const override { return dataCollection(); }
@@ -138,6 +147,12 @@ private:
 	/// Clears the cache entry for the given input frame.
 	void invalidateFrameCache(int frameIndex = -1);
 
+	/// Loads the data of a source frame, or picks up the results of an earlier prefetch operation for that frame.
+	SharedFuture<FileSourceImporter::FrameDataPtr> loadFrameData(int frame, const FileSourceImporter::Frame& frameInfo, bool isPrefetch);
+
+	/// Starts loading the source frames that follow the given frame in the current playback direction.
+	void prefetchFrames(int frame);
+
 private:
 
 	/// The associated importer object that is responsible for parsing the input file.
@@ -186,6 +201,27 @@ private:
 	/// Indicates that the cached pipeline state should be updated with the current contents of the data collection 
 	/// of this FileSource.
 	bool _updateCacheWithDataCollection = false;
+
+	/// A source frame being loaded ahead of time.
+	struct PrefetchedFrame {
+		FileSourceImporter::Frame frameInfo;
+		SharedFuture<FileSourceImporter::FrameDataPtr> future;
+	};
+
+	/// The source frames being loaded ahead of time, indexed by frame number.
+	std::map<int, PrefetchedFrame> _prefetchedFrames;
+
+	/// The source frame that was requested most recently.
+	int _lastRequestedFrame = -1;
+
+	/// The difference between the two most recently requested source frames.
+	int _lastFrameStep = 0;
+
+	/// The step between the source frames that are loaded ahead of time, or zero if the frames are not being traversed sequentially.
+	int _prefetchStride = 0;
+
+	/// The memory usage of the most recently loaded source frame.
+	size_t _loadedFrameMemoryUsage = 0;
 };
 
 OVITO_END_INLINE_NAMESPACE
@@ -28,14 +28,37 @@
 #include <core/dataset/animation/AnimationSettings.h>
 #include <core/viewport/ViewportConfiguration.h>
 #include <core/utilities/io/FileManager.h>
+#include <core/utilities/io/DiskCache.h>
 #include <core/app/Application.h>
 #include "FileSourceImporter.h"
 #include "FileSource.h"
 
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QSaveFile>
+#include <typeinfo>
+
 namespace Ovito { OVITO_BEGIN_INLINE_NAMESPACE(DataIO)
 
 IMPLEMENT_OVITO_CLASS(FileSourceImporter);
 
+namespace {
+	/// Identifies persistent frame index files.
+	constexpr quint32 FrameIndexMagic = 0x4F564649;
+	/// Version of the frame index file format.
+	constexpr quint32 FrameIndexVersion = 2;
+	/// Number of bytes hashed to detect modifications of the indexed part of a file.
+	constexpr qint64 FingerprintLength = 4096;
+
+	/// Computes a hash of the file contents in the range [offset, min(offset + FingerprintLength, limit)).
+	QByteArray fileFingerprint(QFile& file, qint64 offset, qint64 limit)
+	{
+		if(!file.seek(offset))
+			return {};
+		return QCryptographicHash::hash(file.read(std::max<qint64>(0, std::min(FingerprintLength, limit - offset))), QCryptographicHash::Md5);
+	}
+}
+
 /******************************************************************************
 * Sends a request to the FileSource owning this importer to reload
 * the input file.
@@ -319,6 +342,25 @@ void FileSourceImporter::FrameFinder::perform()
 {
 	QVector<Frame> frameList;
 
+	// Take the file size and modification time before scanning, because the file may still be growing.
+	QFileInfo fileInfo(_localFilename);
+	QString filePath = fileInfo.absoluteFilePath();
+	qint64 fileSize = fileInfo.size();
+	QDateTime lastModified = fileInfo.lastModified();
+
+	// Reuse the frame list of an earlier scan of the same local file.
+	IndexState indexState = _sourceUrl.isLocalFile() ? loadFrameIndex(filePath, fileSize, lastModified, frameList) : IndexState::Missing;
+	if(indexState == IndexState::Current) {
+		setResult(std::move(frameList));
+		return;
+	}
+	else if(indexState == IndexState::Appended) {
+		// Scan only the data following the last indexed frame, which itself may have been incomplete.
+		_scanStartOffset = frameList.back().byteOffset;
+		_scanStartLineNumber = frameList.back().lineNumber;
+		frameList.pop_back();
+	}
+
 	// Scan file.
 	try {
 		QFile file(_localFilename);
@@ -333,9 +375,116 @@ void FileSourceImporter::FrameFinder::perform()
 			frameList.pop_back();		// Remove last discovered frame because it may be corrupted or only partially written.
 	}
 
+	// Remember the frames for the next time the file is opened.
+	if(_sourceUrl.isLocalFile() && frameList.size() > 1 && !isCanceled())
+		saveFrameIndex(filePath, fileSize, lastModified, frameList);
+
 	setResult(std::move(frameList));
 }
 
+/******************************************************************************
+* Returns the path of the persistent frame index for the given file.
+******************************************************************************/
+QString FileSourceImporter::FrameFinder::frameIndexPath(const QString& filePath)
+{
+	DiskCache cache = DiskCache::frameIndexCache();
+	if(!cache.isValid())
+		return {};
+	QByteArray key = QCryptographicHash::hash(filePath.toUtf8(), QCryptographicHash::Sha1).toHex();
+	return cache.filePath(QString::fromLatin1(key) + QStringLiteral(".idx"));
+}
+
+/******************************************************************************
+* Loads the frame list from the persistent index of the file.
+******************************************************************************/
+FileSourceImporter::FrameFinder::IndexState FileSourceImporter::FrameFinder::loadFrameIndex(const QString& filePath, qint64 fileSize, const QDateTime& lastModified, QVector<Frame>& frames)
+{
+	QString indexPath = frameIndexPath(filePath);
+	if(indexPath.isEmpty())
+		return IndexState::Missing;
+	QFile indexFile(indexPath);
+	if(!indexFile.open(QIODevice::ReadOnly))
+		return IndexState::Missing;
+	QDataStream stream(&indexFile);
+	stream.setVersion(QDataStream::Qt_5_4);
+
+	quint32 magic, version;
+	stream >> magic >> version;
+	if(stream.status() != QDataStream::Ok || magic != FrameIndexMagic || version != FrameIndexVersion)
+		return IndexState::Missing;
+
+	// The index must have been written by the same kind of frame finder for the same file.
+	QString finderType, indexedPath;
+	qint64 indexedSize, indexedModificationTime;
+	QByteArray headFingerprint, tailFingerprint;
+	qint32 frameCount;
+	stream >> finderType >> indexedPath >> indexedSize >> indexedModificationTime >> headFingerprint >> tailFingerprint >> frameCount;
+	if(stream.status() != QDataStream::Ok || finderType != QLatin1String(typeid(*this).name()) || indexedPath != filePath || frameCount <= 0)
+		return IndexState::Missing;
+
+	// Data appended to a compressed file cannot be scanned incrementally.
+	bool isUnchanged = (indexedSize == fileSize && indexedModificationTime == lastModified.toMSecsSinceEpoch());
+	bool isAppended = !isUnchanged && fileSize > indexedSize && canResumeScan() && !filePath.endsWith(QStringLiteral(".gz"), Qt::CaseInsensitive);
+	if(!isUnchanged && !isAppended)
+		return IndexState::Missing;
+
+	QVector<Frame> indexedFrames;
+	indexedFrames.reserve(frameCount);
+	for(qint32 i = 0; i < frameCount; i++) {
+		Frame frame(_sourceUrl, 0, 1, lastModified);
+		stream >> frame.byteOffset >> frame.lineNumber >> frame.label >> frame.parserData;
+		indexedFrames.push_back(std::move(frame));
+	}
+	if(stream.status() != QDataStream::Ok)
+		return IndexState::Missing;
+
+	// Make sure the indexed part of the file has not been rewritten in the meantime by comparing
+	// the beginning of the file and the beginning of the last indexed frame.
+	QFile file(filePath);
+	if(!file.open(QIODevice::ReadOnly) ||
+			fileFingerprint(file, 0, indexedSize) != headFingerprint ||
+			fileFingerprint(file, indexedFrames.back().byteOffset, indexedSize) != tailFingerprint)
+		return IndexState::Missing;
+
+	// Protect the index from eviction, because it is likely to be needed again.
+	indexFile.close();
+	DiskCache::markUsed(indexPath);
+
+	frames = std::move(indexedFrames);
+	return isUnchanged ? IndexState::Current : IndexState::Appended;
+}
+
+/******************************************************************************
+* Writes the frame list to the persistent index of the file.
+******************************************************************************/
+void FileSourceImporter::FrameFinder::saveFrameIndex(const QString& filePath, qint64 fileSize, const QDateTime& lastModified, const QVector<Frame>& frames)
+{
+	// Failures are silently ignored, because the index only serves to speed up the next scan.
+	QString indexPath = frameIndexPath(filePath);
+	if(indexPath.isEmpty() || !QDir().mkpath(QFileInfo(indexPath).path()))
+		return;
+	QFile file(filePath);
+	if(!file.open(QIODevice::ReadOnly))
+		return;
+	QSaveFile indexFile(indexPath);
+	if(!indexFile.open(QIODevice::WriteOnly))
+		return;
+	QDataStream stream(&indexFile);
+	stream.setVersion(QDataStream::Qt_5_4);
+
+	stream << FrameIndexMagic << FrameIndexVersion;
+	stream << QString::fromLatin1(typeid(*this).name()) << filePath << fileSize << lastModified.toMSecsSinceEpoch();
+	stream << fileFingerprint(file, 0, fileSize) << fileFingerprint(file, frames.back().byteOffset, fileSize);
+	stream << (qint32)frames.size();
+	for(const Frame& frame : frames)
+		stream << frame.byteOffset << frame.lineNumber << frame.label << frame.parserData;
+
+	if(stream.status() == QDataStream::Ok && indexFile.commit()) {
+		// Delete the least recently used indices if they take up too much space.
+		DiskCache::frameIndexCache().trim();
+	}
+}
+
 /******************************************************************************
 * Scans the given file for source frames
 ******************************************************************************/
@@ -468,7 +617,7 @@ bool FileSourceImporter::matchesWildcardPattern(const QString& pattern, const QS
 ******************************************************************************/
 SaveStream& operator<<(SaveStream& stream, const FileSourceImporter::Frame& frame)
 {
-	stream.beginChunk(0x03);
+	stream.beginChunk(0x04);
 	stream << frame.sourceFile << frame.byteOffset << frame.lineNumber << frame.lastModificationTime << frame.label << frame.parserData;
 	stream.endChunk();
 	return stream;
@@ -479,8 +628,18 @@ SaveStream& operator<<(SaveStream& stream, const FileSourceImporter::Frame& fram
 ******************************************************************************/
 LoadStream& operator>>(LoadStream& stream, FileSourceImporter::Frame& frame)
 {
-	stream.expectChunk(0x03);
-	stream >> frame.sourceFile >> frame.byteOffset >> frame.lineNumber >> frame.lastModificationTime >> frame.label >> frame.parserData;
+	quint32 formatVersion = stream.expectChunkRange(0x03, 1);
+	stream >> frame.sourceFile >> frame.byteOffset;
+	if(formatVersion >= 1) {
+		stream >> frame.lineNumber;
+	}
+	else {
+		// Older session states store the line number as 32-bit integer.
+		int lineNumber;
+		stream >> lineNumber;
+		frame.lineNumber = lineNumber;
+	}
+	stream >> frame.lastModificationTime >> frame.label >> frame.parserData;
 	stream.closeChunk();
 	return stream;
 }
@@ -490,9 +649,18 @@ LoadStream& operator>>(LoadStream& stream, FileSourceImporter::Frame& frame)
 ******************************************************************************/
 void FileSourceImporter::FrameLoader::perform()
 {
+	// Skip parsing if the data of the frame is still cached from an earlier load.
+	if(FrameDataPtr frameData = loadFromCache()) {
+		setResult(std::move(frameData));
+		return;
+	}
+
 	// Let the subclass implementation parse the file.
 	QFile file(_localFilename);
-	setResult(loadFile(file));
+	FrameDataPtr frameData = loadFile(file);
+	if(frameData && !isCanceled())
+		storeInCache(frameData);
+	setResult(std::move(frameData));
 }
 
 OVITO_END_INLINE_NAMESPACE
@@ -47,7 +47,7 @@ public:
 		Frame() = default;
 
 		/// Initialization constructor.
-		Frame(QUrl url, qint64 offset = 0, int linenum = 1, const QDateTime& modTime = QDateTime(), const QString& name = QString(), qint64 parserInfo = 0)	:
+		Frame(QUrl url, qint64 offset = 0, qint64 linenum = 1, const QDateTime& modTime = QDateTime(), const QString& name = QString(), qint64 parserInfo = 0)	:
 			sourceFile(std::move(url)), byteOffset(offset), lineNumber(linenum), lastModificationTime(modTime), label(name), parserData(parserInfo) {}
 
 		/// The source file that contains the data of the animation frame.
@@ -57,7 +57,7 @@ public:
 		qint64 byteOffset = 0;
 
 		/// The line number in the source file where the frame data is stored, if the file has a text-based format.
-		int lineNumber = 1;
+		qint64 lineNumber = 1;
 
 		/// The last modification time of the source file.
 		/// This is used to detect changes of the source file, which let the stored byte offset become invalid.
@@ -91,6 +91,10 @@ public:
 		/// has finished. An implementation of this method should try to re-use any existing data objects from the provided data collection.
 		virtual OORef<DataCollection> handOver(const DataCollection* existing, bool isNewFile, FileSource* fileSource) = 0;
 
+		/// Returns the approximate number of bytes occupied by the loaded data, or zero if unknown.
+		/// This is used to limit the amount of memory taken up by frames loaded in advance.
+		virtual size_t memoryUsage() const { return 0; }
+
 		/// Returns the status of the load operation.
 		const PipelineStatus& status() const { return _status; }
 
@@ -128,6 +132,16 @@ public:
 		/// Loads the frame data from the given file.
 		virtual FrameDataPtr loadFile(QFile& file) = 0;
 
+		/// Returns the frame data from an earlier load operation if the loader keeps a cache.
+		/// Returns null if the file needs to be parsed.
+		virtual FrameDataPtr loadFromCache() { return {}; }
+
+		/// Is called after the file has been parsed successfully to let the loader cache the frame data.
+		virtual void storeInCache(const FrameDataPtr& frameData) {}
+
+		/// Returns the path of the local copy of the input file.
+		const QString& localFilename() const { return _localFilename; }
+
 	private:
 
 		/// The source file information.
@@ -160,15 +174,48 @@ public:
 	protected:
 
 		/// Scans the given file for source frames.
+		/// If scanStartOffset() is non-zero, the list already contains the frames preceding that offset,
+		/// and the implementation should only scan the remainder of the file.
 		virtual void discoverFramesInFile(QFile& file, const QUrl& sourceUrl, QVector<Frame>& frames);
 
+		/// Indicates whether discoverFramesInFile() can continue a scan at scanStartOffset().
+		/// Implementations returning true allow frames appended to a file since the last scan to be discovered
+		/// without rescanning the entire file.
+		virtual bool canResumeScan() const { return false; }
+
+		/// Returns the byte offset at which discoverFramesInFile() should start scanning the file.
+		qint64 scanStartOffset() const { return _scanStartOffset; }
+
+		/// Returns the line number at which discoverFramesInFile() should start scanning the file.
+		qint64 scanStartLineNumber() const { return _scanStartLineNumber; }
+
 	private:
 
+		/// Result of the lookup of a frame index stored by an earlier scan.
+		enum class IndexState {
+			Missing,	///< No valid index exists for the file.
+			Current,	///< The index describes the file as it is.
+			Appended	///< Data has been appended to the file since the index was written.
+		};
+
+		/// Returns the path of the persistent frame index for the given file.
+		static QString frameIndexPath(const QString& filePath);
+
+		/// Loads the frame list from the persistent index of the file, given the file's current size and modification time.
+		IndexState loadFrameIndex(const QString& filePath, qint64 fileSize, const QDateTime& lastModified, QVector<Frame>& frames);
+
+		/// Writes the frame list to the persistent index of the file, given the file's size and modification time before the scan.
+		void saveFrameIndex(const QString& filePath, qint64 fileSize, const QDateTime& lastModified, const QVector<Frame>& frames);
+
 		/// The source file information.
 		QUrl _sourceUrl;
 
 		/// The local copy of the file.
 		QString _localFilename;
+
+		/// The position at which discoverFramesInFile() should start scanning.
+		qint64 _scanStartOffset = 0;
+		qint64 _scanStartLineNumber = 0;
 	};
 
 	/// A managed pointer to a FrameFinder instance.
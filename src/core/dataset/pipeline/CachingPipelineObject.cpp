@@ -68,11 +68,14 @@ SharedFuture<PipelineFlowState> CachingPipelineObject::evaluate(TimePoint time,
 		}
 	}
 
-	// Let the subclass perform the actual pipeline evaluation.
+	// Let the subclass perform the actual pipeline evaluation. The evaluation time includes any work
+	// the subclass does synchronously before it returns the future.
+	QElapsedTimer evaluationTimer;
+	evaluationTimer.start();
 	Future<PipelineFlowState> stateFuture = evaluateInternal(time, breakOnError);
 
 	// Cache the results in our local pipeline cache.
-	if(_pipelineCache.insert(stateFuture, time, this)) {
+	if(_pipelineCache.insert(stateFuture, time, this, evaluationTimer)) {
 		// If the cache was updated, we also have a new preliminary state.
 		// Inform the pipeline about it.
 		if(performPreliminaryUpdateAfterEvaluation()) {
@@ -26,13 +26,95 @@
 
 namespace Ovito { OVITO_BEGIN_INLINE_NAMESPACE(ObjectSystem) OVITO_BEGIN_INLINE_NAMESPACE(Scene)
 
+namespace {
+
+	/// Global bookkeeping for the frame histories of all pipeline caches.
+	/// Pipeline caches are only accessed from the main thread.
+	struct FrameHistoryRegistry {
+		/// The caches that currently have frames in their history.
+		std::vector<PipelineCache*> caches;
+		/// The memory buffers referenced by cached frames: their size and the number of frames referencing them.
+		std::unordered_map<const void*, std::pair<size_t, int>> buffers;
+		/// The total size of all distinct buffers referenced by cached frames.
+		size_t totalBytes = 0;
+		/// The inflation value of the GreedyDual-Size policy, i.e. the priority of the most recently evicted frame.
+		double inflation = 0;
+	};
+
+	FrameHistoryRegistry& frameHistoryRegistry()
+	{
+		static FrameHistoryRegistry registry;
+		return registry;
+	}
+
+	/// The memory budget, which is loaded from the application settings on first use.
+	size_t cacheMemoryBudget = 0;
+	bool cacheMemoryBudgetLoaded = false;
+
+	/// The default memory budget for the frame histories.
+	constexpr size_t DefaultMemoryBudget = size_t(512) << 20;
+
+	/// Collects the memory buffers of a data object and all its sub-objects.
+	void collectMemoryBuffersRecursive(const DataObject* obj, std::vector<std::pair<const void*, size_t>>& buffers)
+	{
+		obj->collectMemoryBuffers(buffers);
+		obj->visitSubObjects([&buffers](const DataObject* subObject) {
+			collectMemoryBuffersRecursive(subObject, buffers);
+			return false;
+		});
+	}
+
+	/// Returns whether two time intervals have at least one time in common.
+	bool overlap(TimeInterval a, const TimeInterval& b)
+	{
+		a.intersect(b);
+		return !a.isEmpty();
+	}
+}
+
+/******************************************************************************
+* Returns the memory budget for the frame histories of all pipeline caches.
+******************************************************************************/
+size_t PipelineCache::memoryBudget()
+{
+	if(!cacheMemoryBudgetLoaded) {
+		QSettings settings;
+		cacheMemoryBudget = (size_t)settings.value("core/pipeline_cache/memory_budget", QVariant::fromValue((qulonglong)DefaultMemoryBudget)).toULongLong();
+		cacheMemoryBudgetLoaded = true;
+	}
+	return cacheMemoryBudget;
+}
+
+/******************************************************************************
+* Sets the memory budget for the frame histories of all pipeline caches.
+******************************************************************************/
+void PipelineCache::setMemoryBudget(size_t bytes, bool storeInSettings)
+{
+	cacheMemoryBudget = bytes;
+	cacheMemoryBudgetLoaded = true;
+	if(storeInSettings) {
+		QSettings settings;
+		settings.setValue("core/pipeline_cache/memory_budget", QVariant::fromValue((qulonglong)bytes));
+	}
+	enforceMemoryBudget();
+}
+
+/******************************************************************************
+* Destructor.
+******************************************************************************/
+PipelineCache::~PipelineCache()
+{
+	while(!_frames.empty())
+		removeFrame(_frames.size() - 1);
+}
+
 /******************************************************************************
 * Determines whether the cache contains a cached pipeline state for the 
 * given animation time. 
 ******************************************************************************/
 bool PipelineCache::contains(TimePoint time) const
 {
-	return _mostRecentState.stateValidity().contains(time) || _currentAnimState.stateValidity().contains(time);
+	return _mostRecentState.stateValidity().contains(time) || _currentAnimState.stateValidity().contains(time) || findFrame(time) != nullptr;
 }
 
 /******************************************************************************
@@ -48,6 +130,11 @@ const PipelineFlowState& PipelineCache::getAt(TimePoint time) const
 	else if(_currentAnimState.stateValidity().contains(time)) {
 		return _currentAnimState;
 	}
+	else if(const CachedFrame* frame = findFrame(time)) {
+		// Mark the frame as recently used.
+		frame->inflation = frameHistoryRegistry().inflation;
+		return frame->state;
+	}
 	else {
 		const static PipelineFlowState emptyState;
 		return emptyState;
@@ -59,12 +146,24 @@ const PipelineFlowState& PipelineCache::getAt(TimePoint time) const
 * The cache may decide not to cache the state, in which case the method returns 
 * false.
 ******************************************************************************/
-bool PipelineCache::insert(PipelineFlowState state, const RefTarget* ownerObject)
+bool PipelineCache::insert(PipelineFlowState state, const RefTarget* ownerObject, qint64 evaluationTime)
 {
 	OVITO_ASSERT(ownerObject);
+
+	// The new state supersedes any cached state for the same animation times.
+	removeFrames(state.stateValidity());
+
+	// Keep the state being replaced in the frame history if it belongs to other animation times.
+	if(!_mostRecentState.isEmpty() && !overlap(_mostRecentState.stateValidity(), state.stateValidity()) && memoryBudget() != 0)
+		addFrame(std::move(_mostRecentState), _mostRecentEvaluationTime);
+
 	if(state.stateValidity().contains(ownerObject->dataset()->animationSettings()->time()))
 		_currentAnimState = state;
 	_mostRecentState = std::move(state);
+	_mostRecentEvaluationTime = evaluationTime;
+
+	enforceMemoryBudget();
+
 	ownerObject->notifyDependents(ReferenceEvent::PipelineCacheUpdated);
 	return true;
 }
@@ -74,11 +173,15 @@ bool PipelineCache::insert(PipelineFlowState state, const RefTarget* ownerObject
 * Depending on the given state validity interval, the cache may decide not to 
 * cache the state, in which case the method returns false.
 ******************************************************************************/
-bool PipelineCache::insert(Future<PipelineFlowState>& stateFuture, const TimeInterval& validityInterval, const RefTarget* ownerObject)
+bool PipelineCache::insert(Future<PipelineFlowState>& stateFuture, const TimeInterval& validityInterval, const RefTarget* ownerObject, QElapsedTimer evaluationTimer)
 {
+	// Measure the evaluation time, which determines the value of keeping the state in the cache.
+	if(!evaluationTimer.isValid())
+		evaluationTimer.start();
+
 	// Wait for computation to complete, then cache the results.
-	stateFuture = stateFuture.then(ownerObject->executor(), [this, ownerObject](PipelineFlowState&& state) {
-		insert(state, ownerObject);
+	stateFuture = stateFuture.then(ownerObject->executor(), [this, ownerObject, evaluationTimer](PipelineFlowState&& state) {
+		insert(state, ownerObject, evaluationTimer.elapsed());
 		return std::move(state);
 	});
 	return true;
@@ -98,6 +201,130 @@ void PipelineCache::invalidate(bool keepStaleContents, TimeInterval keepInterval
 		_mostRecentState.reset();
 	if(_currentAnimState.stateValidity().isEmpty() && !keepStaleContents)
 		_currentAnimState.reset();
+
+	// The same applies to the frame history.
+	for(size_t index = _frames.size(); index-- != 0; ) {
+		_frames[index].state.intersectStateValidity(keepInterval);
+		if(_frames[index].state.stateValidity().isEmpty())
+			removeFrame(index);
+	}
+}
+
+/******************************************************************************
+* Looks up a state in the frame history that is valid at the given animation time.
+******************************************************************************/
+const PipelineCache::CachedFrame* PipelineCache::findFrame(TimePoint time) const
+{
+	for(const CachedFrame& frame : _frames) {
+		if(frame.state.stateValidity().contains(time))
+			return &frame;
+	}
+	return nullptr;
+}
+
+/******************************************************************************
+* Moves a state into the frame history.
+******************************************************************************/
+void PipelineCache::addFrame(PipelineFlowState&& state, qint64 evaluationTime)
+{
+	FrameHistoryRegistry& registry = frameHistoryRegistry();
+
+	CachedFrame frame;
+	frame.evaluationTime = evaluationTime;
+	frame.inflation = registry.inflation;
+	if(state.data())
+		collectMemoryBuffersRecursive(state.data(), frame.buffers);
+	frame.state = std::move(state);
+
+	// A buffer may be referenced by several objects of the same state.
+	std::sort(frame.buffers.begin(), frame.buffers.end(), [](const auto& a, const auto& b) { return std::less<const void*>()(a.first, b.first); });
+	frame.buffers.erase(std::unique(frame.buffers.begin(), frame.buffers.end(), [](const auto& a, const auto& b) { return a.first == b.first; }), frame.buffers.end());
+
+	for(const auto& buffer : frame.buffers) {
+		auto& entry = registry.buffers[buffer.first];
+		if(entry.second++ == 0) {
+			entry.first = buffer.second;
+			registry.totalBytes += buffer.second;
+		}
+	}
+
+	if(_frames.empty())
+		registry.caches.push_back(this);
+	_frames.push_back(std::move(frame));
+}
+
+/******************************************************************************
+* Removes a state from the frame history.
+******************************************************************************/
+void PipelineCache::removeFrame(size_t index)
+{
+	OVITO_ASSERT(index < _frames.size());
+	FrameHistoryRegistry& registry = frameHistoryRegistry();
+
+	for(const auto& buffer : _frames[index].buffers) {
+		auto entry = registry.buffers.find(buffer.first);
+		OVITO_ASSERT(entry != registry.buffers.end());
+		if(--entry->second.second == 0) {
+			registry.totalBytes -= entry->second.first;
+			registry.buffers.erase(entry);
+		}
+	}
+
+	_frames.erase(_frames.begin() + index);
+	if(_frames.empty())
+		registry.caches.erase(std::find(registry.caches.begin(), registry.caches.end(), this));
+}
+
+/******************************************************************************
+* Removes all states from the frame history that are valid at some time of
+* the given interval.
+******************************************************************************/
+void PipelineCache::removeFrames(const TimeInterval& interval)
+{
+	for(size_t index = _frames.size(); index-- != 0; ) {
+		if(overlap(_frames[index].state.stateValidity(), interval))
+			removeFrame(index);
+	}
+}
+
+/******************************************************************************
+* Evicts frames from the histories of all caches until the global memory
+* budget is met.
+******************************************************************************/
+void PipelineCache::enforceMemoryBudget()
+{
+	FrameHistoryRegistry& registry = frameHistoryRegistry();
+	size_t budget = memoryBudget();
+
+	while(registry.totalBytes > budget || (budget == 0 && !registry.caches.empty())) {
+		// Find the frame with the lowest priority. The priority of a frame is the inflation value at the time
+		// of its last use plus its evaluation cost per byte of memory that would be freed by evicting it.
+		PipelineCache* victimCache = nullptr;
+		size_t victimIndex = 0;
+		double victimPriority = std::numeric_limits<double>::max();
+		for(PipelineCache* cache : registry.caches) {
+			for(size_t index = 0; index < cache->_frames.size(); index++) {
+				const CachedFrame& frame = cache->_frames[index];
+				size_t freedBytes = 0;
+				for(const auto& buffer : frame.buffers) {
+					const auto& entry = registry.buffers[buffer.first];
+					if(entry.second == 1)
+						freedBytes += entry.first;
+				}
+				double priority = frame.inflation + (double)(frame.evaluationTime + 1) / ((double)freedBytes + 1.0);
+				if(priority < victimPriority) {
+					victimCache = cache;
+					victimIndex = index;
+					victimPriority = priority;
+				}
+			}
+		}
+		if(!victimCache)
+			break;
+
+		registry.inflation = victimPriority;
+		victimCache->removeFrame(victimIndex);
+	}
 }
 
 OVITO_END_INLINE_NAMESPACE
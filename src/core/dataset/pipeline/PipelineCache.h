@@ -26,15 +26,43 @@
 #include <core/dataset/animation/TimeInterval.h>
 #include <core/dataset/pipeline/PipelineFlowState.h>
 
+#include <QElapsedTimer>
+
 namespace Ovito { OVITO_BEGIN_INLINE_NAMESPACE(ObjectSystem) OVITO_BEGIN_INLINE_NAMESPACE(Scene)
 
 /**
  * \brief A local cache for PipelineFlowState objects.
+ *
+ * The cache always keeps the most recently inserted state and the state for the current animation time.
+ * In addition, states for other animation times that are pushed out by newer states are kept in a frame history,
+ * which allows revisiting a window of animation frames without re-evaluating the pipeline.
+ * The frame histories of all caches share a global memory budget (see memoryBudget()). When it is exceeded,
+ * frames are evicted according to the GreedyDual-Size policy, which favors keeping recently used frames that were
+ * expensive to compute and free little memory. Memory buffers shared by several cached states (e.g. property arrays
+ * passed unmodified through a modifier) are counted only once.
  */
 class OVITO_CORE_EXPORT PipelineCache
 {
 public:
 
+	/// Constructor.
+	PipelineCache() = default;
+
+	/// Destructor.
+	~PipelineCache();
+
+	/// The cache registers itself in a global list and must not be copied.
+	PipelineCache(const PipelineCache&) = delete;
+	PipelineCache& operator=(const PipelineCache&) = delete;
+
+	/// Returns the maximum amount of memory (in bytes) that all pipeline caches together may use for keeping
+	/// the states of additional animation frames. A value of zero disables the frame history.
+	static size_t memoryBudget();
+
+	/// Sets the memory budget for the frame histories of all pipeline caches. Unless \a storeInSettings is false,
+	/// the value is also stored in the application settings and applies to future program sessions.
+	static void setMemoryBudget(size_t bytes, bool storeInSettings = true);
+
 	/// Determines whether the cache contains a cached pipeline state for the given animation time. 
 	bool contains(TimePoint time) const;
 
@@ -48,12 +76,15 @@ public:
 
 	/// Puts the given pipeline state into the cache for later retrieval. 
 	/// The cache may decide not to cache the state, in which case the method returns false.
-	bool insert(PipelineFlowState state, const RefTarget* ownerObject);
+	/// The evaluation time (in milliseconds) is used to decide which frames to keep when the memory budget is exceeded.
+	bool insert(PipelineFlowState state, const RefTarget* ownerObject, qint64 evaluationTime = 0);
 
 	/// Puts the given pipeline state into the cache when it comes available. 
 	/// Depending on the given state validity interval, the cache may decide not to cache the state, 
 	/// in which case the method returns false.
-	bool insert(Future<PipelineFlowState>& stateFuture, const TimeInterval& validityInterval, const RefTarget* ownerObject);
+	/// The evaluation time is measured with the given timer, which the caller should start before it begins the evaluation.
+	/// If the timer has not been started, the time is measured from this call on.
+	bool insert(Future<PipelineFlowState>& stateFuture, const TimeInterval& validityInterval, const RefTarget* ownerObject, QElapsedTimer evaluationTimer = QElapsedTimer());
 
 	/// Marks the contents of the cache as outdated and throws away the stored data.
 	///
@@ -63,13 +94,49 @@ public:
 	///                     will be reduced to this interval.
 	void invalidate(bool keepStaleContents = false, TimeInterval keepInterval = TimeInterval::empty());
 
+	/// Returns the number of states kept in the frame history of this cache.
+	size_t frameHistorySize() const { return _frames.size(); }
+
 private:
 
+	/// A state in the frame history.
+	struct CachedFrame {
+		/// The cached pipeline state.
+		PipelineFlowState state;
+		/// The memory buffers referenced by the state and their sizes in bytes.
+		std::vector<std::pair<const void*, size_t>> buffers;
+		/// The time it took to compute the state (in milliseconds).
+		qint64 evaluationTime;
+		/// The value of the global inflation counter at the time the frame was last used.
+		mutable double inflation;
+	};
+
+	/// Looks up a state in the frame history that is valid at the given animation time.
+	const CachedFrame* findFrame(TimePoint time) const;
+
+	/// Moves a state into the frame history.
+	void addFrame(PipelineFlowState&& state, qint64 evaluationTime);
+
+	/// Removes a state from the frame history.
+	void removeFrame(size_t index);
+
+	/// Removes all states from the frame history that are valid at some time of the given interval.
+	void removeFrames(const TimeInterval& interval);
+
+	/// Evicts frames from the histories of all caches until the global memory budget is met.
+	static void enforceMemoryBudget();
+
 	/// Keeps the most recently inserted state.
 	PipelineFlowState _mostRecentState;
 
+	/// The time it took to compute the most recently inserted state (in milliseconds).
+	qint64 _mostRecentEvaluationTime = 0;
+
 	/// Keeps the state for the current animation time.
 	PipelineFlowState _currentAnimState;
+
+	/// The states of further animation frames.
+	mutable std::vector<CachedFrame> _frames;
 };
 
 OVITO_END_INLINE_NAMESPACE
@@ -118,16 +118,20 @@ SharedFuture<PipelineFlowState> PipelineSceneNode::evaluatePipeline(TimePoint ti
 	if(!dataProvider())
 		return Future<PipelineFlowState>::createImmediateEmplace();
 
+	// Measure the evaluation time, which determines the value of keeping the results in the cache.
+	QElapsedTimer evaluationTimer;
+	evaluationTimer.start();
+
 	// Evaluate the pipeline and store the obtained results in the cache before returning them to the caller.
 	return dataProvider()->evaluate(time, breakOnError)
-		.then(executor(), [this, time](PipelineFlowState state) {
+		.then(executor(), [this, time, evaluationTimer](PipelineFlowState state) {
 			UndoSuspender noUndo(this);
 
 			// The pipeline should never return a state without proper validity interval.
 			OVITO_ASSERT(state.stateValidity().contains(time));
 
 			// We maintain a data cache for the current animation time.
-			if(_pipelineCache.insert(state, this)) {
+			if(_pipelineCache.insert(state, this, evaluationTimer.elapsed())) {
 				const_cast<PipelineSceneNode*>(this)->updateVisElementList(dataset()->animationSettings()->time());
 			}
 
@@ -23,13 +23,18 @@
 
 
 #include <core/Core.h>
-#include <core/app/Application.h>
 #include "PromiseState.h"
-
-#include <future>
+#include "ThreadPool.h"
 
 namespace Ovito { OVITO_BEGIN_INLINE_NAMESPACE(Util) OVITO_BEGIN_INLINE_NAMESPACE(Concurrency)
 
+/// Number of pieces per thread into which parallelFor() initially splits the loop. Idle threads steal pieces, which are split further.
+constexpr size_t ParallelForPiecesPerThread = 16;
+
+/// Number of pieces per thread for parallelForChunks(). This is lower, because the kernels typically
+/// allocate and merge thread-local buffers for every chunk.
+constexpr size_t ParallelForChunksPiecesPerThread = 4;
+
 template<class Function, typename T>
 bool parallelFor(
 		T loopCount,
@@ -39,143 +44,67 @@ bool parallelFor(
 {
 	promise.setProgressMaximum(loopCount / progressChunkSize);
 	promise.setProgressValue(0);
-
-	std::vector<std::future<void>> workers;
-	size_t num_threads = Application::instance()->idealThreadCount();
-	T chunkSize = loopCount / num_threads;
-	T startIndex = 0;
-	T endIndex = chunkSize;
-	for(size_t t = 0; t < num_threads; t++) {
-		if(t == num_threads - 1)
-			endIndex += loopCount % num_threads;
-		workers.push_back(std::async(std::launch::async, [&promise, &kernel, startIndex, endIndex, progressChunkSize]() {
-			for(T i = startIndex; i < endIndex;) {
+	if(loopCount <= 0)
+		return !promise.isCanceled();
+
+	// Each piece of the loop counts its completed progress chunks locally and reports them with a
+	// single call at the end, so that the worker threads do not contend for the shared promise state.
+	// Cancellation is polled once per progress chunk.
+	ThreadPool& pool = ThreadPool::instance();
+	pool.parallelRange((size_t)loopCount, pool.grainSize((size_t)loopCount, ParallelForPiecesPerThread), [&promise, &kernel, progressChunkSize](size_t startIndex, size_t endIndex) {
+		T i = (T)startIndex;
+		while(i < (T)endIndex) {
+			T chunkEnd = std::min((T)endIndex, (i / progressChunkSize + 1) * progressChunkSize);
+			for(; i < chunkEnd; ++i) {
 				// Execute kernel.
 				kernel(i);
-
-				i++;
-
-				// Update progress indicator.
-				if((i % progressChunkSize) == 0) {
-					OVITO_ASSERT(i != 0);
-					promise.incrementProgressValue();
-				}
-				if(promise.isCanceled())
-					return;
 			}
-		}));
-		startIndex = endIndex;
-		endIndex += chunkSize;
-	}
+			if(promise.isCanceled())
+				break;
+		}
 
-	for(auto& t : workers)
-		t.wait();
-	for(auto& t : workers)
-		t.get();
+		// Update progress indicator.
+		T completedChunks = i / progressChunkSize - (T)startIndex / progressChunkSize;
+		if(completedChunks != 0)
+			promise.incrementProgressValue(completedChunks);
+	}, &promise);
 
-	promise.incrementProgressValue(loopCount % progressChunkSize);
-	return !promise.isCanceled();
+	if(promise.isCanceled())
+		return false;
+	promise.setProgressValue(loopCount / progressChunkSize);
+	return true;
 }
 
 template<class Function, typename T>
 void parallelFor(T loopCount, Function kernel)
 {
-	std::vector<std::future<void>> workers;
-	size_t num_threads = Application::instance()->idealThreadCount();
-	if(num_threads > loopCount) {
-		if(loopCount <= 0) return;
-		num_threads = loopCount;
-	}
-	T chunkSize = loopCount / num_threads;
-	T startIndex = 0;
-	T endIndex = chunkSize;
-	for(size_t t = 0; t < num_threads; t++) {
-		if(t == num_threads - 1) {
-			OVITO_ASSERT(endIndex + (loopCount % num_threads) == loopCount);
-			endIndex = loopCount;
-			for(T i = startIndex; i < endIndex; ++i) {
-				kernel(i);
-			}
+	if(loopCount <= 0) return;
+	ThreadPool& pool = ThreadPool::instance();
+	pool.parallelRange((size_t)loopCount, pool.grainSize((size_t)loopCount, ParallelForPiecesPerThread), [&kernel](size_t startIndex, size_t endIndex) {
+		for(T i = (T)startIndex; i < (T)endIndex; ++i) {
+			kernel(i);
 		}
-		else {
-			OVITO_ASSERT(endIndex <= loopCount);
-			workers.push_back(std::async(std::launch::async, [&kernel, startIndex, endIndex]() {
-				for(T i = startIndex; i < endIndex; ++i) {
-					kernel(i);
-				}
-			}));
-		}
-		startIndex = endIndex;
-		endIndex += chunkSize;
-	}
-
-	for(auto& t : workers)
-		t.wait();
-	for(auto& t : workers)
-		t.get();
+	});
 }
 
 template<class Function>
 bool parallelForChunks(size_t loopCount, PromiseState& promise, Function kernel)
 {
-	std::vector<std::future<void>> workers;
-	size_t num_threads = Application::instance()->idealThreadCount();
-	if(num_threads > loopCount) {
-		if(loopCount <= 0) return true;
-		num_threads = loopCount;
-	}
-	size_t chunkSize = loopCount / num_threads;
-	size_t startIndex = 0;
-	for(size_t t = 0; t < num_threads; t++) {
-		if(t == num_threads - 1) {
-			chunkSize += loopCount % num_threads;
-			OVITO_ASSERT(startIndex + chunkSize == loopCount);
-			kernel(startIndex, chunkSize, promise);
-		}
-		else {
-			workers.push_back(std::async(std::launch::async, [&kernel, startIndex, chunkSize, &promise]() {
-				kernel(startIndex, chunkSize, promise);
-			}));
-		}
-		startIndex += chunkSize;
-	}
-	for(auto& t : workers)
-		t.wait();
-	for(auto& t : workers)
-		t.get();
+	ThreadPool& pool = ThreadPool::instance();
+	pool.parallelRange(loopCount, pool.grainSize(loopCount, ParallelForChunksPiecesPerThread), [&kernel, &promise](size_t startIndex, size_t endIndex) {
+		kernel(startIndex, endIndex - startIndex, promise);
+	}, &promise);
 
 	return !promise.isCanceled();
 }
 
-
 template<class Function>
 void parallelForChunks(size_t loopCount, Function kernel)
 {
-	std::vector<std::future<void>> workers;
-	size_t num_threads = Application::instance()->idealThreadCount();
-	if(num_threads > loopCount) {
-		if(loopCount <= 0) return;
-		num_threads = loopCount;
-	}
-	size_t chunkSize = loopCount / num_threads;
-	size_t startIndex = 0;
-	for(size_t t = 0; t < num_threads; t++) {
-		if(t == num_threads - 1) {
-			chunkSize += loopCount % num_threads;
-			OVITO_ASSERT(startIndex + chunkSize == loopCount);
-			kernel(startIndex, chunkSize);
-		}
-		else {
-			workers.push_back(std::async(std::launch::async, [&kernel, startIndex, chunkSize]() {
-				kernel(startIndex, chunkSize);
-			}));
-		}
-		startIndex += chunkSize;
-	}
-	for(auto& t : workers)
-		t.wait();
-	for(auto& t : workers)
-		t.get();
+	ThreadPool& pool = ThreadPool::instance();
+	pool.parallelRange(loopCount, pool.grainSize(loopCount, ParallelForChunksPiecesPerThread), [&kernel](size_t startIndex, size_t endIndex) {
+		kernel(startIndex, endIndex - startIndex);
+	});
 }
 
 OVITO_END_INLINE_NAMESPACE
@@ -60,7 +60,7 @@ void PromiseState::cancel() noexcept
 {
 	if(isCanceled() || isFinished()) return;
 	
-	_state = State(_state | Canceled);
+	_state.fetch_or(Canceled, std::memory_order_acq_rel);
 
 	for(PromiseWatcher* watcher = _watchers; watcher != nullptr; watcher = watcher->_nextInList)
 		QMetaObject::invokeMethod(watcher, "promiseCanceled", Qt::QueuedConnection);
@@ -75,7 +75,7 @@ bool PromiseState::setStarted()
 	}
 
     OVITO_ASSERT(!isFinished());
-    _state = State(_state | Started);
+    _state.fetch_or(Started, std::memory_order_acq_rel);
 
 	for(PromiseWatcher* watcher = _watchers; watcher != nullptr; watcher = watcher->_nextInList)
 		QMetaObject::invokeMethod(watcher, "promiseStarted", Qt::QueuedConnection);
@@ -102,7 +102,7 @@ void PromiseState::setFinishedNoSelfLock()
 	OVITO_ASSERT(!isFinished());
 	
 	// Change state.
-	_state = State(_state | Finished);
+	_state.fetch_or(Finished, std::memory_order_acq_rel);
 
 	// Make sure that a result has been set (if not in canceled or error state).
 	OVITO_ASSERT_MSG(_exceptionStore || isCanceled() || _resultSet.load() || !_resultsTuple, 
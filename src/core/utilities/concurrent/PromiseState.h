@@ -55,13 +55,14 @@ public:
     virtual ~PromiseState();
 
     /// Returns whether this shared state has been canceled by a previous call to cancel().
-    bool isCanceled() const { return (_state & Canceled); }
+    /// This is a relaxed atomic read, which is cheap enough to be polled by worker threads in tight loops.
+    bool isCanceled() const { return (_state.load(std::memory_order_relaxed) & Canceled); }
 
     /// Returns true if the promise is in the 'started' state.
-    bool isStarted() const { return (_state & Started); }
+    bool isStarted() const { return (_state.load(std::memory_order_acquire) & Started); }
 
     /// Returns true if the promise is in the 'finished' state.
-    bool isFinished() const { return (_state & Finished); }
+    bool isFinished() const { return (_state.load(std::memory_order_acquire) & Finished); }
 
     /// Returns the maximum value for progress reporting. 
     virtual qlonglong progressMaximum() const { return 0; }
@@ -229,8 +230,8 @@ protected:
     /// List of continuation functions that will be called when this shared state enters the 'finished' state.
     QVarLengthArray<std::function<void()>, 1> _continuations;
 
-    /// The current state value.
-    State _state;
+    /// The current state value (a combination of State flags).
+    std::atomic_int _state;
 
     /// The number of Future objects currently referring to this shared state.
     std::atomic_uint _shareCount{0};
@@ -38,7 +38,7 @@ AsynchronousTaskBase::~AsynchronousTaskBase()
 }
 
 /******************************************************************************
-* Implementation of QRunnable.
+* Runs the task in the calling thread.
 ******************************************************************************/
 void AsynchronousTaskBase::run() 
 {
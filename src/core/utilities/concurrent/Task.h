@@ -52,17 +52,15 @@ public:
 	/// This virtual function is responsible for computing the results of the task.
 	virtual void perform() = 0;		
 
+	/// Runs the task in the calling thread. This is called by the thread pool.
+	virtual void run() override;
+
 protected:
 
 	/// Constructor.
 	AsynchronousTaskBase() {
 		QRunnable::setAutoDelete(false);
 	}
-
-private:
-	
-	/// Implementation of QRunnable.
-	virtual void run() override;
 };
 
 template<typename... R>
@@ -24,8 +24,8 @@
 
 #include <core/Core.h>
 #include "PromiseState.h"
+#include "ThreadPool.h"
 
-#include <QThreadPool>
 #include <QMetaObject>
 
 namespace Ovito { OVITO_BEGIN_INLINE_NAMESPACE(Util) OVITO_BEGIN_INLINE_NAMESPACE(Concurrency)
@@ -60,11 +60,12 @@ public:
 
 	/// \brief Executes an asynchronous task in a background thread.
 	///
+	/// The task is run by the global ThreadPool, which also executes the parallel loops started by the task.
 	/// This function is thread-safe. It returns a Future that is fulfilled when the task completed.
 	template<class TaskType>
 	auto runTaskAsync(const std::shared_ptr<TaskType>& task) {
 		OVITO_ASSERT(task);
-		QThreadPool::globalInstance()->start(task.get());
+		ThreadPool::instance().submit([task]() { task->run(); });
 		registerTask(task);
 		return task->future();
 	}
@@ -0,0 +1,308 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (2018) Alexander Stukowski
+//
+//  This file is part of OVITO (Open Visualization Tool).
+//
+//  OVITO is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  OVITO is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <core/Core.h>
+#include <core/app/Application.h>
+#include "ThreadPool.h"
+#include "PromiseState.h"
+
+namespace Ovito { OVITO_BEGIN_INLINE_NAMESPACE(Util) OVITO_BEGIN_INLINE_NAMESPACE(Concurrency)
+
+namespace {
+	/// The pool owning the calling thread, if it is a worker thread.
+	thread_local const ThreadPool* currentPool = nullptr;
+	/// The queue index of the calling worker thread.
+	thread_local int currentQueue = 0;
+
+	/// Number of unsuccessful attempts to find work before a thread goes to sleep.
+	constexpr int SpinCount = 256;
+}
+
+/******************************************************************************
+* Returns the global thread pool.
+******************************************************************************/
+ThreadPool& ThreadPool::instance()
+{
+	static ThreadPool pool(Application::instance() ? Application::instance()->idealThreadCount() : std::max(1, QThread::idealThreadCount()));
+	return pool;
+}
+
+/******************************************************************************
+* Constructor, which starts the worker threads.
+******************************************************************************/
+ThreadPool::ThreadPool(int workerCount)
+{
+	workerCount = std::max(1, workerCount);
+	for(int i = 0; i <= workerCount; i++)
+		_queues.push_back(std::make_unique<WorkQueue>());
+	for(int i = 0; i < workerCount; i++)
+		_workers.emplace_back(&ThreadPool::workerMain, this, i);
+}
+
+/******************************************************************************
+* Destructor, which stops the worker threads.
+******************************************************************************/
+ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(_sleepMutex);
+		_shutdown = true;
+	}
+	_wakeup.notify_all();
+	for(std::thread& worker : _workers)
+		worker.join();
+}
+
+/******************************************************************************
+* Returns the index of the work queue used by the calling thread.
+******************************************************************************/
+int ThreadPool::currentQueueIndex() const
+{
+	return (currentPool == this) ? currentQueue : workerCount();
+}
+
+/******************************************************************************
+* Queues a function for asynchronous execution.
+******************************************************************************/
+void ThreadPool::submit(std::function<void()> job)
+{
+	{
+		std::lock_guard<std::mutex> lock(_taskMutex);
+		_tasks.push_back(std::move(job));
+	}
+	_pendingJobs.fetch_add(1);
+	notifyWorker();
+}
+
+/******************************************************************************
+* Executes a loop and helps the other threads until the loop is complete.
+******************************************************************************/
+void ThreadPool::runLoop(Loop& loop)
+{
+	int queueIndex = currentQueueIndex();
+	executeRange(RangeJob{&loop, 0, loop.count}, queueIndex);
+
+	int spins = 0;
+	while(!loop.done.load(std::memory_order_acquire)) {
+		// Work on pieces of this or other loops while waiting.
+		RangeJob job;
+		if(popLocal(queueIndex, job) || steal(queueIndex, job)) {
+			executeRange(job, queueIndex);
+			spins = 0;
+		}
+		else if(++spins < SpinCount) {
+			std::this_thread::yield();
+		}
+		else {
+			// The remaining pieces are being processed by other threads.
+			// Sleep until they are done, but look for new pieces from time to time.
+			std::unique_lock<std::mutex> lock(loop.mutex);
+			loop.finished.wait_for(lock, std::chrono::microseconds(200), [&loop]() { return loop.done.load(); });
+		}
+	}
+
+	// The thread that completed the loop sets the 'done' flag while holding the mutex.
+	// Acquire it once to make sure that thread is no longer accessing the loop object.
+	{ std::lock_guard<std::mutex> lock(loop.mutex); }
+
+	if(loop.exception)
+		std::rethrow_exception(loop.exception);
+}
+
+/******************************************************************************
+* Executes a piece of a loop.
+******************************************************************************/
+void ThreadPool::executeRange(const RangeJob& job, int queueIndex)
+{
+	Loop& loop = *job.loop;
+	size_t begin = job.begin;
+	size_t end = job.end;
+
+	// Split off the upper halves so that idle threads can steal them.
+	while(end - begin > loop.grainSize && !loop.aborted.load(std::memory_order_relaxed)) {
+		size_t mid = begin + (end - begin) / 2;
+		push(queueIndex, RangeJob{&loop, mid, end});
+		end = mid;
+	}
+
+	if(!loop.aborted.load(std::memory_order_relaxed)) {
+		if(loop.promise && loop.promise->isCanceled()) {
+			loop.aborted.store(true, std::memory_order_relaxed);
+		}
+		else {
+			try {
+				loop.invoke(loop.body, begin, end);
+			}
+			catch(...) {
+				std::lock_guard<std::mutex> lock(loop.mutex);
+				if(!loop.exception)
+					loop.exception = std::current_exception();
+				loop.aborted.store(true, std::memory_order_relaxed);
+			}
+		}
+	}
+
+	if(loop.remaining.fetch_sub(end - begin, std::memory_order_acq_rel) == end - begin) {
+		std::lock_guard<std::mutex> lock(loop.mutex);
+		loop.done.store(true, std::memory_order_release);
+		loop.finished.notify_all();
+	}
+}
+
+/******************************************************************************
+* Puts a loop piece onto the given queue.
+******************************************************************************/
+void ThreadPool::push(int queueIndex, const RangeJob& job)
+{
+	WorkQueue& queue = *_queues[queueIndex];
+	{
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		queue.jobs.push_back(job);
+		queue.size.fetch_add(1, std::memory_order_relaxed);
+	}
+	_pendingJobs.fetch_add(1);
+	notifyWorker();
+}
+
+/******************************************************************************
+* Takes the most recently pushed loop piece from the given queue.
+******************************************************************************/
+bool ThreadPool::popLocal(int queueIndex, RangeJob& job)
+{
+	WorkQueue& queue = *_queues[queueIndex];
+	if(queue.size.load(std::memory_order_relaxed) == 0)
+		return false;
+	std::lock_guard<std::mutex> lock(queue.mutex);
+	if(queue.jobs.empty())
+		return false;
+	job = queue.jobs.back();
+	queue.jobs.pop_back();
+	queue.size.fetch_sub(1, std::memory_order_relaxed);
+	_pendingJobs.fetch_sub(1);
+	return true;
+}
+
+/******************************************************************************
+* Takes the oldest loop piece from one of the other queues.
+******************************************************************************/
+bool ThreadPool::steal(int queueIndex, RangeJob& job)
+{
+	int n = queueCount();
+	for(int i = 1; i < n; i++) {
+		WorkQueue& queue = *_queues[(queueIndex + i) % n];
+		if(queue.size.load(std::memory_order_relaxed) == 0)
+			continue;
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		if(queue.jobs.empty())
+			continue;
+		job = queue.jobs.front();
+		queue.jobs.pop_front();
+		queue.size.fetch_sub(1, std::memory_order_relaxed);
+		_pendingJobs.fetch_sub(1);
+		return true;
+	}
+	return false;
+}
+
+/******************************************************************************
+* Takes the next asynchronous task from the FIFO queue.
+******************************************************************************/
+bool ThreadPool::popTask(std::function<void()>& task)
+{
+	std::lock_guard<std::mutex> lock(_taskMutex);
+	if(_tasks.empty())
+		return false;
+	task = std::move(_tasks.front());
+	_tasks.pop_front();
+	_pendingJobs.fetch_sub(1);
+	return true;
+}
+
+/******************************************************************************
+* Executes an asynchronous task and reports the exceptions it lets escape.
+******************************************************************************/
+void ThreadPool::runTask(std::function<void()>& task)
+{
+	// Tasks are expected to store their exceptions in their promise, as AsynchronousTaskBase::run() does.
+	// Nobody waits for the task function itself, so an exception reaching this point can only be logged.
+	try {
+		task();
+	}
+	catch(const Exception& ex) {
+		qWarning() << "Asynchronous task has thrown an exception:" << ex.messages().join(QChar('\n'));
+	}
+	catch(const std::exception& ex) {
+		qWarning() << "Asynchronous task has thrown an exception:" << ex.what();
+	}
+	catch(...) {
+		qWarning() << "Asynchronous task has thrown an unknown exception.";
+	}
+}
+
+/******************************************************************************
+* Wakes up a sleeping worker after new work has been queued.
+******************************************************************************/
+void ThreadPool::notifyWorker()
+{
+	// The pending job counter has been incremented before. A worker going to sleep increments the
+	// sleeper count before checking the job counter, so at least one of the two threads sees the other.
+	if(_sleepingWorkers.load() != 0) {
+		std::lock_guard<std::mutex> lock(_sleepMutex);
+		_wakeup.notify_one();
+	}
+}
+
+/******************************************************************************
+* The main function of the worker threads.
+******************************************************************************/
+void ThreadPool::workerMain(int queueIndex)
+{
+	currentPool = this;
+	currentQueue = queueIndex;
+
+	int spins = 0;
+	while(!_shutdown.load(std::memory_order_relaxed)) {
+		RangeJob job;
+		std::function<void()> task;
+		if(popLocal(queueIndex, job) || steal(queueIndex, job)) {
+			executeRange(job, queueIndex);
+			spins = 0;
+		}
+		else if(popTask(task)) {
+			runTask(task);
+			spins = 0;
+		}
+		else if(++spins < SpinCount) {
+			std::this_thread::yield();
+		}
+		else {
+			std::unique_lock<std::mutex> lock(_sleepMutex);
+			_sleepingWorkers.fetch_add(1);
+			_wakeup.wait(lock, [this]() { return _shutdown || _pendingJobs.load() != 0; });
+			_sleepingWorkers.fetch_sub(1);
+			spins = 0;
+		}
+	}
+}
+
+OVITO_END_INLINE_NAMESPACE
+OVITO_END_INLINE_NAMESPACE
+}	// End of namespace
@@ -0,0 +1,175 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (2018) Alexander Stukowski
+//
+//  This file is part of OVITO (Open Visualization Tool).
+//
+//  OVITO is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  OVITO is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+
+#include <core/Core.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace Ovito { OVITO_BEGIN_INLINE_NAMESPACE(Util) OVITO_BEGIN_INLINE_NAMESPACE(Concurrency)
+
+/**
+ * \brief Process-wide pool of worker threads with work-stealing scheduling.
+ *
+ * Parallel loops are split recursively into halves. The split-off halves are pushed onto the
+ * work queue of the thread executing the loop, from where idle threads steal them. Thus, an expensive
+ * part of the index range is automatically subdivided further by the threads that become idle.
+ * A thread waiting for a loop to complete executes pending pieces of work in the meantime,
+ * which makes it safe to start parallel loops from within a parallel loop.
+ *
+ * Asynchronous tasks submitted with submit() are kept in a separate FIFO queue, which is only served
+ * by workers that have no loop work to do.
+ */
+class OVITO_CORE_EXPORT ThreadPool
+{
+public:
+
+	/// Returns the global thread pool, which gets created on first use with Application::idealThreadCount() workers.
+	static ThreadPool& instance();
+
+	/// Constructor, which starts the given number of worker threads.
+	explicit ThreadPool(int workerCount);
+
+	/// Destructor, which stops the worker threads. Pending asynchronous tasks are discarded.
+	~ThreadPool();
+
+	/// Returns the number of worker threads of the pool.
+	int workerCount() const { return (int)_workers.size(); }
+
+	/// Returns the number of work queues. There is one queue per worker and one queue shared by all other threads.
+	int queueCount() const { return (int)_queues.size(); }
+
+	/// Returns the index of the work queue used by the calling thread.
+	int currentQueueIndex() const;
+
+	/// Returns the grain size for splitting a loop of the given length into about the given number of pieces per thread.
+	size_t grainSize(size_t count, size_t piecesPerThread) const {
+		return std::max<size_t>(1, count / (piecesPerThread * queueCount()));
+	}
+
+	/// Queues a function for asynchronous execution by one of the worker threads.
+	/// The function should report errors through a promise. Exceptions it lets escape are logged with qWarning().
+	/// This function is thread-safe.
+	void submit(std::function<void()> job);
+
+	/// Calls body(begin, end) for a set of subranges that cover [0, count) exactly, using all worker threads.
+	/// Ranges are split until they are no longer than grainSize. Returns after all subranges have been processed.
+	/// No further subranges are started once the given promise (if any) has been canceled or once
+	/// body has thrown an exception, which is re-thrown to the caller.
+	template<class Body>
+	void parallelRange(size_t count, size_t grainSize, Body&& body, const PromiseState* promise = nullptr) {
+		if(count == 0) return;
+		Loop loop(&invokeBody<std::remove_reference_t<Body>>, const_cast<void*>(static_cast<const void*>(&body)), std::max<size_t>(grainSize, 1), count, promise);
+		runLoop(loop);
+	}
+
+private:
+
+	/// Shared state of a parallel loop, which lives on the stack of the thread that started it.
+	struct Loop {
+		Loop(void (*invoke)(void*, size_t, size_t), void* body, size_t grainSize, size_t count, const PromiseState* promise) :
+			invoke(invoke), body(body), grainSize(grainSize), count(count), promise(promise), remaining(count) {}
+
+		void (*const invoke)(void*, size_t, size_t);
+		void* const body;
+		const size_t grainSize;
+		const size_t count;
+		const PromiseState* const promise;
+		std::atomic<size_t> remaining;
+		std::atomic<bool> aborted{false};
+		std::atomic<bool> done{false};
+		std::exception_ptr exception;
+		std::mutex mutex;
+		std::condition_variable finished;
+	};
+
+	/// A piece of a parallel loop.
+	struct RangeJob {
+		Loop* loop;
+		size_t begin;
+		size_t end;
+	};
+
+	/// The deque of loop pieces belonging to one thread.
+	struct WorkQueue {
+		std::mutex mutex;
+		std::deque<RangeJob> jobs;
+		std::atomic<size_t> size{0};
+	};
+
+	/// Type-erased invocation of a loop body.
+	template<class Body>
+	static void invokeBody(void* body, size_t begin, size_t end) {
+		(*static_cast<Body*>(body))(begin, end);
+	}
+
+	/// Executes a loop on the calling thread and helps the other threads until the loop is complete.
+	void runLoop(Loop& loop);
+
+	/// Executes a piece of a loop, splitting off halves into the given queue as long as the piece is too large.
+	void executeRange(const RangeJob& job, int queueIndex);
+
+	/// Puts a loop piece onto the given queue.
+	void push(int queueIndex, const RangeJob& job);
+
+	/// Takes the most recently pushed loop piece from the given queue.
+	bool popLocal(int queueIndex, RangeJob& job);
+
+	/// Takes the oldest (and typically largest) loop piece from one of the other queues.
+	bool steal(int queueIndex, RangeJob& job);
+
+	/// Takes the next asynchronous task from the FIFO queue.
+	bool popTask(std::function<void()>& task);
+
+	/// Executes an asynchronous task and logs the exceptions it lets escape.
+	void runTask(std::function<void()>& task);
+
+	/// Wakes up a sleeping worker after new work has been queued.
+	void notifyWorker();
+
+	/// The main function of the worker threads.
+	void workerMain(int queueIndex);
+
+	std::vector<std::unique_ptr<WorkQueue>> _queues;
+	std::vector<std::thread> _workers;
+
+	std::mutex _taskMutex;
+	std::deque<std::function<void()>> _tasks;
+
+	/// Number of loop pieces and tasks waiting in the queues.
+	std::atomic<size_t> _pendingJobs{0};
+
+	std::mutex _sleepMutex;
+	std::condition_variable _wakeup;
+	std::atomic<int> _sleepingWorkers{0};
+	std::atomic<bool> _shutdown{false};
+};
+
+OVITO_END_INLINE_NAMESPACE
+OVITO_END_INLINE_NAMESPACE
+}	// End of namespace
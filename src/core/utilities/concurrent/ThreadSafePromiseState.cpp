@@ -97,30 +97,47 @@ void ThreadSafePromiseState::setProgressMaximum(qlonglong maximum)
 bool ThreadSafePromiseState::setProgressValue(qlonglong value)
 {
     QMutexLocker locker(&_mutex);
+	// The absolute value supersedes any increments that have not been published yet.
+	_pendingProgressIncrement.store(0, std::memory_order_relaxed);
     return PromiseStateWithProgress::setProgressValue(value);
 }
 
 bool ThreadSafePromiseState::incrementProgressValue(qlonglong increment)
 {
-    QMutexLocker locker(&_mutex);
-	return PromiseStateWithProgress::incrementProgressValue(increment);
+	_pendingProgressIncrement.fetch_add(increment, std::memory_order_relaxed);
+	if(isCanceled())
+		return false;
+
+	// Publish the accumulated increments only occasionally. If another thread is currently
+	// holding the lock, leave the increment to be published by a later call.
+	if(progressClock() < _nextProgressPublishTime.load(std::memory_order_relaxed))
+		return true;
+	if(!_mutex.tryLock())
+		return !isCanceled();
+	_nextProgressPublishTime.store(progressClock() + ProgressPublishInterval, std::memory_order_relaxed);
+	bool result = PromiseStateWithProgress::incrementProgressValue(_pendingProgressIncrement.exchange(0, std::memory_order_relaxed));
+	_mutex.unlock();
+	return result;
 }
 
 void ThreadSafePromiseState::beginProgressSubStepsWithWeights(std::vector<int> weights)
 {
     QMutexLocker locker(&_mutex);
+	_pendingProgressIncrement.store(0, std::memory_order_relaxed);
     PromiseStateWithProgress::beginProgressSubStepsWithWeights(std::move(weights));
 }
 
 void ThreadSafePromiseState::nextProgressSubStep()
 {
 	QMutexLocker locker(&_mutex);
+	_pendingProgressIncrement.store(0, std::memory_order_relaxed);
 	PromiseStateWithProgress::nextProgressSubStep();
 }
 
 void ThreadSafePromiseState::endProgressSubSteps()
 {
 	QMutexLocker locker(&_mutex);
+	_pendingProgressIncrement.store(0, std::memory_order_relaxed);
 	PromiseStateWithProgress::endProgressSubSteps();
 }
 
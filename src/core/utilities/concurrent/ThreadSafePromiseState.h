@@ -27,6 +27,8 @@
 
 #include <QMutex>
 
+#include <chrono>
+
 namespace Ovito { OVITO_BEGIN_INLINE_NAMESPACE(Util) OVITO_BEGIN_INLINE_NAMESPACE(Concurrency)
 
 /******************************************************************************
@@ -54,6 +56,8 @@ public:
 
 	/// Increments the progress value by 1.
 	/// Returns false if the promise has been canceled.
+	/// Concurrent callers do not block each other: increments are accumulated in an atomic counter
+	/// and published to the watchers at most every ProgressPublishInterval milliseconds.
     virtual bool incrementProgressValue(qlonglong increment = 1) override;
 
 	/// Changes the status text of this promise.
@@ -92,6 +96,22 @@ protected:
 	virtual void addContinuationImpl(std::function<void()>&& cont) override;
 
 	QMutex _mutex;
+
+private:
+
+	/// Minimum time between two progress updates published by incrementProgressValue() (in milliseconds).
+	static constexpr qint64 ProgressPublishInterval = 20;
+
+	/// Returns the monotonic clock used for rate-limiting progress updates (in milliseconds).
+	static qint64 progressClock() {
+		return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+
+	/// Progress increments that have not been published yet.
+	std::atomic<qlonglong> _pendingProgressIncrement{0};
+
+	/// Time after which incrementProgressValue() publishes the pending increments again.
+	std::atomic<qint64> _nextProgressPublishTime{0};
 };
 
 
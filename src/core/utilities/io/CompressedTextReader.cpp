@@ -20,10 +20,24 @@
 ///////////////////////////////////////////////////////////////////////////////
 
 #include <core/Core.h>
+#include <core/utilities/io/DiskCache.h>
 #include "CompressedTextReader.h"
 
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QSaveFile>
+
 namespace Ovito { OVITO_BEGIN_INLINE_NAMESPACE(Util) OVITO_BEGIN_INLINE_NAMESPACE(IO)
 
+namespace {
+	/// Spacing of the decompression checkpoints in the uncompressed data.
+	std::atomic<qint64> defaultCheckpointInterval(16 << 20);
+	/// Identifies checkpoint index files.
+	constexpr quint32 CheckpointIndexMagic = 0x4F56475A;
+	/// Version of the checkpoint index file format.
+	constexpr quint32 CheckpointIndexVersion = 1;
+}
+
 /******************************************************************************
 * Opens the stream for reading.
 ******************************************************************************/
@@ -43,6 +57,8 @@ CompressedTextReader::CompressedTextReader(QFileDevice& input, const QString& or
 		if(!_uncompressor.open(QIODevice::ReadOnly))
 			throw Exception(tr("Failed to open input file: %1").arg(_uncompressor.errorString()));
 		_stream = &_uncompressor;
+		_uncompressor.setCheckpointInterval(defaultCheckpointInterval.load());
+		loadCheckpoints();
 	}
 	else {
 		// Open uncompressed file for reading.
@@ -52,6 +68,117 @@ CompressedTextReader::CompressedTextReader(QFileDevice& input, const QString& or
 	}
 }
 
+/******************************************************************************
+* Destructor.
+******************************************************************************/
+CompressedTextReader::~CompressedTextReader()
+{
+	if(isCompressed() && _uncompressor.checkpoints().size() > _knownCheckpointCount)
+		saveCheckpoints();
+}
+
+/******************************************************************************
+* Returns the spacing of the decompression checkpoints recorded by new readers.
+******************************************************************************/
+qint64 CompressedTextReader::checkpointInterval()
+{
+	return defaultCheckpointInterval.load();
+}
+
+/******************************************************************************
+* Sets the spacing of the decompression checkpoints recorded by new readers.
+******************************************************************************/
+void CompressedTextReader::setCheckpointInterval(qint64 interval)
+{
+	OVITO_ASSERT(interval > 0);
+	defaultCheckpointInterval.store(interval);
+}
+
+/******************************************************************************
+* Returns the path of the file storing the decompression checkpoints.
+******************************************************************************/
+QString CompressedTextReader::checkpointIndexPath() const
+{
+	// The checkpoints are kept next to the frame indices written by FileSourceImporter.
+	DiskCache cache = DiskCache::frameIndexCache();
+	if(!cache.isValid() || _device.fileName().isEmpty())
+		return {};
+	QByteArray key = QCryptographicHash::hash(QFileInfo(_device.fileName()).absoluteFilePath().toUtf8(), QCryptographicHash::Sha1).toHex();
+	return cache.filePath(QString::fromLatin1(key) + QStringLiteral(".gzi"));
+}
+
+/******************************************************************************
+* Loads the decompression checkpoints recorded by an earlier reader.
+******************************************************************************/
+void CompressedTextReader::loadCheckpoints()
+{
+	// Files written by the parallel gzip compressor carry their own seek index.
+	std::vector<GzipIODevice::Checkpoint> seekIndex = GzipIODevice::readSeekIndex(_device);
+	if(!seekIndex.empty()) {
+		_knownCheckpointCount = seekIndex.size();
+		_uncompressor.setCheckpoints(std::move(seekIndex));
+		return;
+	}
+
+	QString indexPath = checkpointIndexPath();
+	if(indexPath.isEmpty())
+		return;
+	QFile indexFile(indexPath);
+	if(!indexFile.open(QIODevice::ReadOnly))
+		return;
+	QDataStream stream(&indexFile);
+	stream.setVersion(QDataStream::Qt_5_4);
+
+	// The checkpoints are only valid for the same version of the file.
+	QFileInfo fileInfo(_device.fileName());
+	quint32 magic, version;
+	qint64 fileSize, lastModified;
+	qint32 count;
+	stream >> magic >> version >> fileSize >> lastModified >> count;
+	if(stream.status() != QDataStream::Ok || magic != CheckpointIndexMagic || version != CheckpointIndexVersion ||
+			fileSize != fileInfo.size() || lastModified != fileInfo.lastModified().toMSecsSinceEpoch() || count < 0)
+		return;
+
+	std::vector<GzipIODevice::Checkpoint> checkpoints(count);
+	for(GzipIODevice::Checkpoint& checkpoint : checkpoints) {
+		qint32 bits;
+		stream >> checkpoint.uncompressedOffset >> checkpoint.compressedOffset >> bits >> checkpoint.window;
+		checkpoint.bits = bits;
+	}
+	if(stream.status() != QDataStream::Ok)
+		return;
+
+	_knownCheckpointCount = checkpoints.size();
+	_uncompressor.setCheckpoints(std::move(checkpoints));
+	indexFile.close();
+	DiskCache::markUsed(indexPath);
+}
+
+/******************************************************************************
+* Stores the decompression checkpoints recorded so far.
+******************************************************************************/
+void CompressedTextReader::saveCheckpoints()
+{
+	// Failures are silently ignored, because the checkpoints only serve to speed up seeking.
+	QString indexPath = checkpointIndexPath();
+	if(indexPath.isEmpty() || !QDir().mkpath(QFileInfo(indexPath).path()))
+		return;
+	QSaveFile indexFile(indexPath);
+	if(!indexFile.open(QIODevice::WriteOnly))
+		return;
+	QDataStream stream(&indexFile);
+	stream.setVersion(QDataStream::Qt_5_4);
+
+	QFileInfo fileInfo(_device.fileName());
+	const std::vector<GzipIODevice::Checkpoint>& checkpoints = _uncompressor.checkpoints();
+	stream << CheckpointIndexMagic << CheckpointIndexVersion << fileInfo.size() << fileInfo.lastModified().toMSecsSinceEpoch() << (qint32)checkpoints.size();
+	for(const GzipIODevice::Checkpoint& checkpoint : checkpoints)
+		stream << checkpoint.uncompressedOffset << checkpoint.compressedOffset << (qint32)checkpoint.bits << checkpoint.window;
+
+	if(stream.status() == QDataStream::Ok && indexFile.commit())
+		DiskCache::frameIndexCache().trim();
+}
+
 /******************************************************************************
 * Reads in the next line.
 ******************************************************************************/
@@ -37,6 +37,10 @@ namespace Ovito { OVITO_BEGIN_INLINE_NAMESPACE(Util) OVITO_BEGIN_INLINE_NAMESPAC
  * read can be accessed via the line() method. The class keeps track of the
  * current line number, which is returned by lineNumber().
  *
+ * For compressed files, the reader records decompression checkpoints while reading and stores
+ * them in the user's cache directory when it is destroyed. Later readers of the same file load
+ * them, which lets seek() jump to any position without decompressing the file from the beginning.
+ *
  * \sa CompressedTextWriter
  */
 class OVITO_CORE_EXPORT CompressedTextReader : public QObject
@@ -49,6 +53,15 @@ public:
 	/// \throw Exception if an I/O error has occurred.
 	CompressedTextReader(QFileDevice& input, const QString& originalFilePath);
 
+	/// Destructor, which stores the decompression checkpoints recorded while reading a compressed file.
+	~CompressedTextReader();
+
+	/// Returns the spacing (in uncompressed bytes) of the decompression checkpoints recorded by new readers.
+	static qint64 checkpointInterval();
+
+	/// Sets the spacing (in uncompressed bytes) of the decompression checkpoints recorded by new readers.
+	static void setCheckpointInterval(qint64 interval);
+
 	/// Returns the name of the input file (without the path), which was passed to the constructor.
 	const QString& filename() const { return _filename; }
 
@@ -99,7 +112,7 @@ public:
 	QString lineString() const { return QString::fromUtf8(_line.data()); }
 
 	/// Returns the current line number.
-	int lineNumber() const { return _lineNumber; }
+	qint64 lineNumber() const { return _lineNumber; }
 
 	/// Returns the current read position in the (uncompressed) input stream.
 	/// \sa underlyingByteOffset(), seek()
@@ -110,7 +123,7 @@ public:
 	/// Jumps to the given byte position in the (uncompressed) input stream.
 	/// \throw Exception if an I/O error has occurred.
 	/// \sa byteOffset()
-	void seek(qint64 pos, int lineNumber = 0) {
+	void seek(qint64 pos, qint64 lineNumber = 0) {
 		if(!_stream->seek(pos))
 			throw Exception(tr("Failed to seek to byte offset %1 in file %2: %3").arg(pos).arg(_filename).arg(_stream->errorString()));
 		_byteOffset = pos;
@@ -145,6 +158,15 @@ public:
 
 private:
 
+	/// Returns the path of the file storing the decompression checkpoints of the input file.
+	QString checkpointIndexPath() const;
+
+	/// Loads the decompression checkpoints recorded by an earlier reader of the input file.
+	void loadCheckpoints();
+
+	/// Stores the decompression checkpoints recorded so far.
+	void saveCheckpoints();
+
 	/// The name of the input file (if known).
 	QString _filename;
 
@@ -152,7 +174,7 @@ private:
 	std::vector<char> _line;
 
 	/// The current line number.
-	int _lineNumber;
+	qint64 _lineNumber;
 
 	/// The current position in the uncompressed data stream.
 	qint64 _byteOffset;
@@ -169,6 +191,9 @@ private:
 	/// The pointer to the memory-mapped data.
 	uchar* _mmapPointer;
 
+	/// The number of decompression checkpoints that were already known when the file was opened.
+	size_t _knownCheckpointCount = 0;
+
 	Q_OBJECT
 };
 
@@ -27,25 +27,40 @@
 
 namespace Ovito { OVITO_BEGIN_INLINE_NAMESPACE(Util) OVITO_BEGIN_INLINE_NAMESPACE(IO)
 
+namespace {
+	/// Size of the blocks that are compressed in parallel when writing gzip files.
+	constexpr qint64 CompressionBlockSize = 128 << 10;
+	/// Spacing of the seek index entries in written gzip files. Matches the checkpoint interval of CompressedTextReader.
+	constexpr qint64 SeekIndexInterval = 16 << 20;
+}
+
 /******************************************************************************
 * Opens the output file for writing.
 ******************************************************************************/
 CompressedTextWriter::CompressedTextWriter(QFileDevice& output, DataSet* context) :
-	_device(output), _compressor(&output), _context(context)
+	CompressedTextWriter(output, output.fileName(), context)
 {
-	_filename = output.fileName();
+}
 
+/******************************************************************************
+* Opens the output device for writing.
+******************************************************************************/
+CompressedTextWriter::CompressedTextWriter(QIODevice& output, const QString& filename, DataSet* context) :
+	_filename(filename), _device(output), _compressor(&output), _context(context)
+{
 	// Check if file should be compressed (i.e. filename ends with .gz).
 	if(_filename.endsWith(".gz", Qt::CaseInsensitive)) {
 		// Open file for writing.
 		_compressor.setStreamFormat(GzipIODevice::GzipFormat);
+		_compressor.setParallelBlockSize(CompressionBlockSize);
+		_compressor.setSeekIndexInterval(SeekIndexInterval);
 		if(!_compressor.open(QIODevice::WriteOnly))
 			throw Exception(tr("Failed to open output file '%1' for writing: %2").arg(_compressor.errorString()), _context);
 		_stream = &_compressor;
 	}
 	else {
-		// Open file for writing.
-		if(!output.open(QIODevice::WriteOnly | QIODevice::Text))
+		// Open file for writing unless the caller has already opened the device.
+		if(!output.isOpen() && !output.open(QIODevice::WriteOnly | QIODevice::Text))
 			throw Exception(tr("Failed to open output file '%1' for writing: %2").arg(_filename).arg(output.errorString()), _context);
 		_stream = &output;
 	}
@@ -31,7 +31,8 @@ namespace Ovito { OVITO_BEGIN_INLINE_NAMESPACE(Util) OVITO_BEGIN_INLINE_NAMESPAC
  * \brief A helper class for writing text-based files that are compressed (gzip format).
  *
  * If the destination filename has a .gz suffix, this output stream class compresses the
- * text data on the fly if.
+ * text data on the fly if. The compression is performed by the worker threads of the ThreadPool in parallel,
+ * and the written file contains a seek index that speeds up random access by CompressedTextReader.
  *
  * \sa CompressedTextReader
  */
@@ -45,11 +46,19 @@ public:
 	/// \throw Exception if an I/O error has occurred.
 	CompressedTextWriter(QFileDevice& output, DataSet* context = nullptr);
 
+	/// Opens the given output device for writing. The given filename determines if the data gets compressed.
+	/// This can be used to write text data into a memory buffer. An uncompressed output device that is already open is used as is.
+	/// \param output The underlying Qt output device from to data should be written.
+	/// \param filename The name of the output file, which is used to decide whether compression is enabled and in error messages.
+	/// \param context The DataSet which provides a context for error messages generated by this writer.
+	/// \throw Exception if an I/O error has occurred.
+	CompressedTextWriter(QIODevice& output, const QString& filename, DataSet* context = nullptr);
+
 	/// Returns the name of the output file.
 	const QString& filename() const { return _filename; }
 
 	/// Returns the underlying I/O device.
-	QFileDevice& device() { return _device; }
+	QIODevice& device() { return _device; }
 
 	/// Returns whether data written to this stream is being compressed.
 	bool isCompressed() const { return _stream != &_device; }
@@ -91,6 +100,13 @@ public:
 	/// Writes a Qt string string to the text-based output file.
 	CompressedTextWriter& operator<<(const QString& s) { return *this << s.toLocal8Bit().constData(); }
 
+	/// Writes a block of already formatted text to the output file.
+	CompressedTextWriter& operator<<(const QByteArray& s) {
+		if(_stream->write(s) != s.size())
+			reportWriteError();
+		return *this;
+	}
+
 	/// Returns the current output precision for floating-point numbers.
 	unsigned int floatPrecision() const { return _floatPrecision; }
 
@@ -108,7 +124,7 @@ private:
 	QString _filename;
 
 	/// The underlying output device.
-	QFileDevice& _device;
+	QIODevice& _device;
 
 	/// The compression filter stream.
 	GzipIODevice _compressor;
@@ -0,0 +1,108 @@
+///////////////////////////////////////////////////////////////////////////////
+// 
+//  Copyright (2018) Alexander Stukowski
+//
+//  This file is part of OVITO (Open Visualization Tool).
+//
+//  OVITO is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  OVITO is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <core/Core.h>
+#include "DiskCache.h"
+
+#include <QStandardPaths>
+
+namespace Ovito { OVITO_BEGIN_INLINE_NAMESPACE(Util) OVITO_BEGIN_INLINE_NAMESPACE(IO)
+
+/******************************************************************************
+* Constructor.
+******************************************************************************/
+DiskCache::DiskCache(const QString& subdirectory, qint64 sizeLimit) : _sizeLimit(sizeLimit)
+{
+	QString cacheLocation = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+	if(!cacheLocation.isEmpty())
+		_directoryPath = cacheLocation + QChar('/') + subdirectory;
+}
+
+/******************************************************************************
+* Returns the cache directory holding the frame indices of trajectory files.
+******************************************************************************/
+DiskCache DiskCache::frameIndexCache()
+{
+	static const qint64 sizeLimit = QSettings().value("core/file_source/frame_index_size_limit", QVariant::fromValue((qlonglong)64 << 20)).toLongLong();
+	return DiskCache(QStringLiteral("frame_index"), sizeLimit);
+}
+
+/******************************************************************************
+* Returns the total size of the files in the cache directory.
+******************************************************************************/
+qint64 DiskCache::totalSize() const
+{
+	qint64 size = 0;
+	if(isValid()) {
+		for(const QFileInfo& fileInfo : QDir(_directoryPath).entryInfoList(QDir::Files))
+			size += fileInfo.size();
+	}
+	return size;
+}
+
+/******************************************************************************
+* Marks the given cache file as recently used.
+******************************************************************************/
+void DiskCache::markUsed(const QString& filePath)
+{
+#if QT_VERSION >= QT_VERSION_CHECK(5, 10, 0)
+	QFile file(filePath);
+	if(file.open(QIODevice::ReadWrite))
+		file.setFileTime(QDateTime::currentDateTimeUtc(), QFileDevice::FileModificationTime);
+#else
+	// Older Qt versions cannot set the time of a file. The files then get evicted in the order in which they were written.
+	Q_UNUSED(filePath);
+#endif
+}
+
+/******************************************************************************
+* Deletes the least recently used files until the total size is within the limit.
+******************************************************************************/
+void DiskCache::trim() const
+{
+	if(!isValid())
+		return;
+	QFileInfoList files = QDir(_directoryPath).entryInfoList(QDir::Files, QDir::Time | QDir::Reversed);
+	qint64 size = 0;
+	for(const QFileInfo& fileInfo : files)
+		size += fileInfo.size();
+	for(const QFileInfo& fileInfo : files) {
+		if(size <= _sizeLimit)
+			break;
+		if(QFile::remove(fileInfo.absoluteFilePath()))
+			size -= fileInfo.size();
+	}
+}
+
+/******************************************************************************
+* Deletes all files of the cache directory.
+******************************************************************************/
+void DiskCache::clear() const
+{
+	if(!isValid())
+		return;
+	for(const QFileInfo& fileInfo : QDir(_directoryPath).entryInfoList(QDir::Files))
+		QFile::remove(fileInfo.absoluteFilePath());
+}
+
+OVITO_END_INLINE_NAMESPACE
+OVITO_END_INLINE_NAMESPACE
+}	// End of namespace
@@ -0,0 +1,83 @@
+///////////////////////////////////////////////////////////////////////////////
+// 
+//  Copyright (2018) Alexander Stukowski
+//
+//  This file is part of OVITO (Open Visualization Tool).
+//
+//  OVITO is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  OVITO is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+
+#include <core/Core.h>
+
+namespace Ovito { OVITO_BEGIN_INLINE_NAMESPACE(Util) OVITO_BEGIN_INLINE_NAMESPACE(IO)
+
+/**
+ * \brief A directory of files in the user's cache location, which speed up later program sessions.
+ *
+ * The total size of the files is limited. When the limit is exceeded, the least recently used files get deleted.
+ * The modification time of a file serves as its time of last use, which markUsed() updates whenever the file is read.
+ * All methods may be called from any thread. Files that cannot be deleted, e.g. because they are still open, are skipped.
+ */
+class OVITO_CORE_EXPORT DiskCache
+{
+public:
+
+	/// Constructor. The files are kept in the given subdirectory of the user's cache location and may together
+	/// take up at most the given number of bytes.
+	DiskCache(const QString& subdirectory, qint64 sizeLimit);
+
+	/// Returns the cache directory holding the frame indices of trajectory files and the decompression checkpoints
+	/// of gzipped files. Its size is limited by the application setting core/file_source/frame_index_size_limit (64 MB by default).
+	static DiskCache frameIndexCache();
+
+	/// Returns whether a cache location is available on this system.
+	bool isValid() const { return !_directoryPath.isEmpty(); }
+
+	/// Returns the path of the cache directory.
+	const QString& directoryPath() const { return _directoryPath; }
+
+	/// Returns the maximum total size of the files in bytes.
+	qint64 sizeLimit() const { return _sizeLimit; }
+
+	/// Returns the path of the cache file with the given name.
+	QString filePath(const QString& fileName) const { return _directoryPath + QChar('/') + fileName; }
+
+	/// Returns the total size of the files in the cache directory in bytes.
+	qint64 totalSize() const;
+
+	/// Marks the given cache file as recently used, which protects it from being deleted by trim().
+	static void markUsed(const QString& filePath);
+
+	/// Deletes the least recently used files until the total size is within the limit.
+	void trim() const;
+
+	/// Deletes all files of the cache directory.
+	void clear() const;
+
+private:
+
+	/// The cache directory.
+	QString _directoryPath;
+
+	/// The maximum total size of the files in bytes.
+	qint64 _sizeLimit;
+};
+
+OVITO_END_INLINE_NAMESPACE
+OVITO_END_INLINE_NAMESPACE
+}	// End of namespace
@@ -21,9 +21,13 @@
 
 
 #include <core/Core.h>
+#include <core/utilities/concurrent/ThreadPool.h>
 #include "GzipIODevice.h"
 #include <zlib.h>
 
+#include <QtEndian>
+#include <cstring>
+
 namespace Ovito { OVITO_BEGIN_INLINE_NAMESPACE(Util)
 
 using ZlibByte = Bytef;
@@ -31,6 +35,148 @@ using ZlibSize = uInt;
 
 OVITO_STATIC_ASSERT((std::is_same<ZlibByte, unsigned char>::value));
 
+namespace {
+
+    /// The size of the window of preceding data that deflate refers back to.
+    constexpr int DeflateWindowSize = 32768;
+
+    /// Identifies the extra field of the gzip members holding the seek index entries.
+    const char SeekIndexFieldId[2] = { 'O', 'I' };
+    /// Identifies the extra field of the last gzip member, which records where the seek index starts.
+    const char SeekLocatorFieldId[2] = { 'O', 'L' };
+    /// The maximum number of seek index entries per gzip member, limited by the size of the extra field.
+    constexpr size_t SeekIndexEntriesPerMember = 4000;
+    /// The size of an empty gzip member with an extra field, not counting the field's payload.
+    constexpr int EmptyMemberSize = 26;
+    /// The size of the payload of the locator field.
+    constexpr int SeekLocatorSize = 12;
+
+    /// A piece of the data deflated by one thread of the parallel compressor.
+    struct CompressionBlock {
+        const char* input;
+        qint64 size;
+        bool isLast;
+        /// The uncompressed data preceding the block, which the block may refer back to.
+        QByteArray dictionary;
+        /// The index of the seek index entry pointing to the start of this block, or -1.
+        int checkpointIndex;
+        QByteArray output;
+        uLong crc;
+        int status;
+    };
+
+    /// Deflates a block of the parallel compressor into a raw deflate stream that ends at a byte boundary.
+    void deflateBlock(CompressionBlock& block, int compressionLevel)
+    {
+        z_stream stream;
+        stream.zalloc = Z_NULL;
+        stream.zfree = Z_NULL;
+        stream.opaque = Z_NULL;
+        block.status = ::deflateInit2(&stream, compressionLevel, Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY);
+        if(block.status != Z_OK)
+            return;
+        if(!block.dictionary.isEmpty())
+            ::deflateSetDictionary(&stream, reinterpret_cast<const ZlibByte*>(block.dictionary.constData()), block.dictionary.size());
+
+        // A sync flush ends the data with an empty stored block, which aligns the next block to a byte boundary.
+        const int flushMode = block.isLast ? Z_FINISH : Z_SYNC_FLUSH;
+        block.output.resize(::deflateBound(&stream, block.size) + 16);
+        stream.next_in = reinterpret_cast<ZlibByte*>(const_cast<char*>(block.input));
+        stream.avail_in = block.size;
+        stream.next_out = reinterpret_cast<ZlibByte*>(block.output.data());
+        stream.avail_out = block.output.size();
+        for(;;) {
+            block.status = ::deflate(&stream, flushMode);
+            if(block.status == Z_STREAM_END || (flushMode != Z_FINISH && stream.avail_in == 0 &&
+                    ((block.status == Z_OK && stream.avail_out != 0) || block.status == Z_BUF_ERROR))) {
+                block.status = Z_OK;
+                break;
+            }
+            if(block.status != Z_OK)
+                break;
+            // The output buffer is full. Enlarge it and continue.
+            int outputSize = block.output.size();
+            block.output.resize(outputSize * 2);
+            stream.next_out = reinterpret_cast<ZlibByte*>(block.output.data()) + outputSize;
+            stream.avail_out = block.output.size() - outputSize;
+        }
+        block.output.resize(block.output.size() - stream.avail_out);
+        block.crc = ::crc32(0, reinterpret_cast<const ZlibByte*>(block.input), block.size);
+        ::deflateEnd(&stream);
+    }
+
+    /// Builds a gzip member that contains no data, but an extra field with the given payload.
+    /// Gzip decompressors skip such members.
+    QByteArray emptyGzipMember(const char fieldId[2], const QByteArray& payload)
+    {
+        uchar lengths[4];
+        qToLittleEndian<quint16>(payload.size() + 4, lengths);
+        qToLittleEndian<quint16>(payload.size(), lengths + 2);
+        // Header with the FEXTRA flag, no modification time, and unknown OS.
+        QByteArray member("\x1f\x8b\x08\x04\0\0\0\0\0\xff", 10);
+        member.append(reinterpret_cast<const char*>(lengths), 2);
+        member.append(fieldId, 2);
+        member.append(reinterpret_cast<const char*>(lengths) + 2, 2);
+        member.append(payload);
+        // An empty final deflate block, followed by the CRC-32 and the size of the empty data.
+        member.append("\x03\0\0\0\0\0\0\0\0\0", 10);
+        return member;
+    }
+
+    /// Parses a gzip member built by emptyGzipMember(). Returns the size of the member, or zero if the data does not start with such a member.
+    int parseEmptyGzipMember(const char* data, qint64 size, const char fieldId[2], QByteArray& payload)
+    {
+        if(size < EmptyMemberSize || std::memcmp(data, "\x1f\x8b\x08\x04", 4) != 0 || data[12] != fieldId[0] || data[13] != fieldId[1])
+            return 0;
+        int extraLength = qFromLittleEndian<quint16>(reinterpret_cast<const uchar*>(data) + 10);
+        int payloadLength = qFromLittleEndian<quint16>(reinterpret_cast<const uchar*>(data) + 14);
+        if(extraLength != payloadLength + 4 || size < EmptyMemberSize + payloadLength ||
+                std::memcmp(data + 16 + payloadLength, "\x03\0\0\0\0\0\0\0\0\0", 10) != 0)
+            return 0;
+        payload = QByteArray(data + 16, payloadLength);
+        return EmptyMemberSize + payloadLength;
+    }
+
+    /// Reads the seek index stored at the end of the given device.
+    std::vector<GzipIODevice::Checkpoint> parseSeekIndex(QIODevice& device)
+    {
+        // The last member of the file records the position of the members holding the index entries.
+        qint64 fileSize = device.size();
+        if(fileSize < EmptyMemberSize + SeekLocatorSize || !device.seek(fileSize - EmptyMemberSize - SeekLocatorSize))
+            return {};
+        QByteArray locator = device.read(EmptyMemberSize + SeekLocatorSize);
+        QByteArray payload;
+        if(parseEmptyGzipMember(locator.constData(), locator.size(), SeekLocatorFieldId, payload) != locator.size() || payload.size() != SeekLocatorSize)
+            return {};
+        qint64 indexStart = qFromLittleEndian<quint64>(reinterpret_cast<const uchar*>(payload.constData()));
+        quint32 count = qFromLittleEndian<quint32>(reinterpret_cast<const uchar*>(payload.constData()) + 8);
+        qint64 indexEnd = fileSize - locator.size();
+        if(indexStart < 0 || indexStart > indexEnd || !device.seek(indexStart))
+            return {};
+
+        QByteArray index = device.read(indexEnd - indexStart);
+        if(index.size() != indexEnd - indexStart)
+            return {};
+        std::vector<GzipIODevice::Checkpoint> checkpoints;
+        for(const char* p = index.constData(); p != index.constData() + index.size(); ) {
+            int memberSize = parseEmptyGzipMember(p, index.constData() + index.size() - p, SeekIndexFieldId, payload);
+            if(memberSize == 0 || payload.size() % 16 != 0)
+                return {};
+            for(const uchar* entry = reinterpret_cast<const uchar*>(payload.constData()); entry != reinterpret_cast<const uchar*>(payload.constData()) + payload.size(); entry += 16) {
+                qint64 uncompressedOffset = qFromLittleEndian<quint64>(entry);
+                qint64 compressedOffset = qFromLittleEndian<quint64>(entry + 8);
+                if(compressedOffset < 0 || compressedOffset >= indexStart || (!checkpoints.empty() && uncompressedOffset <= checkpoints.back().uncompressedOffset))
+                    return {};
+                checkpoints.push_back({ uncompressedOffset, compressedOffset, 0, QByteArray() });
+            }
+            p += memberSize;
+        }
+        if(checkpoints.size() != count)
+            return {};
+        return checkpoints;
+    }
+}
+
 struct ZLibState
 {
     z_stream _zlibStream;
@@ -78,26 +224,144 @@ void GzipIODevice::flushZlib(int flushMode)
         OVITO_ASSERT(status == Z_OK);
 }
 
-// Writes outputSize bytes from buffer to the inderlying device.
-bool GzipIODevice::writeBytes(qint64 outputSize)
+// Writes a block of bytes to the inderlying device.
+bool GzipIODevice::writeBytes(const char* data, qint64 size)
 {
-    ZlibSize totalBytesWritten = 0;
+    qint64 totalBytesWritten = 0;
     // Loop until all bytes are written to the underlying device.
-    do {
-        const qint64 bytesWritten = _device->write(reinterpret_cast<char*>(_buffer.get()), outputSize);
+    while(totalBytesWritten != size) {
+        const qint64 bytesWritten = _device->write(data + totalBytesWritten, size - totalBytesWritten);
         if(bytesWritten == -1) {
             setErrorString(tr("Error writing to underlying I/O device: %1").arg(_device->errorString()));
             return false;
         }
         totalBytesWritten += bytesWritten;
-    } 
-    while(totalBytesWritten != outputSize);
+    }
+    _compressedPos += size;
 
     // Put up a flag so that the device will be flushed on close.
     _state = BytesWritten;
     return true;
 }
 
+/// Deflates the pending input data in parallel and writes the compressed blocks to the underlying device.
+bool GzipIODevice::compressBlocks(int flushMode)
+{
+    // The gzip header precedes the first block: deflate method, no flags, no modification time, unknown OS.
+    if(_state == NoBytesWritten) {
+        if(!writeBytes("\x1f\x8b\x08\0\0\0\0\0\0\xff", 10))
+            return false;
+        _crc = ::crc32(0, Z_NULL, 0);
+    }
+
+    // Split the pending input into blocks. Keep an incomplete block for later unless the stream is being flushed.
+    std::vector<CompressionBlock> blocks;
+    qint64 available = _pendingInput.size();
+    qint64 offset = 0;
+    qint64 lastIndexedOffset = _checkpoints.empty() ? 0 : _checkpoints.back().uncompressedOffset;
+    for(;;) {
+        qint64 size = std::min(_parallelBlockSize, available - offset);
+        bool isLast = (flushMode == Z_FINISH && offset + size == available);
+        if(!isLast && (size == 0 || (size < _parallelBlockSize && flushMode == Z_NO_FLUSH)))
+            break;
+        CompressionBlock block{ _pendingInput.constData() + offset, size, isLast, QByteArray(), -1 };
+        qint64 uncompressedOffset = _uncompressedPos + offset;
+        if(_seekIndexInterval > 0 && uncompressedOffset != 0 && uncompressedOffset - lastIndexedOffset >= _seekIndexInterval) {
+            // Decompression can start at a block that does not refer back to the preceding data.
+            block.checkpointIndex = _checkpoints.size();
+            _checkpoints.push_back({ uncompressedOffset, 0, 0, QByteArray() });
+            lastIndexedOffset = uncompressedOffset;
+        }
+        else {
+            // The block may only refer back to data following the last checkpoint, because decompression restarted there
+            // has no other history. This matters if a flush() has cut a block short right after a checkpoint.
+            qint64 history = std::min<qint64>(DeflateWindowSize, uncompressedOffset - lastIndexedOffset);
+            if(offset >= history)
+                block.dictionary = QByteArray::fromRawData(_pendingInput.constData() + offset - history, (int)history);
+            else
+                block.dictionary = (_dictionary + _pendingInput.left(offset)).right((int)history);
+        }
+        blocks.push_back(std::move(block));
+        offset += size;
+        if(isLast)
+            break;
+    }
+    if(blocks.empty())
+        return true;
+
+    ThreadPool::instance().parallelRange(blocks.size(), 1, [this, &blocks](size_t begin, size_t end) {
+        for(size_t i = begin; i < end; i++)
+            deflateBlock(blocks[i], _compressionLevel);
+    });
+
+    // Write the compressed blocks in order and combine their checksums.
+    for(const CompressionBlock& block : blocks) {
+        if(block.status != Z_OK) {
+            _state = Error;
+            setZlibError(tr("Internal zlib error when compressing: "), block.status);
+            return false;
+        }
+        if(block.checkpointIndex >= 0)
+            _checkpoints[block.checkpointIndex].compressedOffset = _compressedPos;
+        if(!writeBytes(block.output.constData(), block.output.size()))
+            return false;
+        _crc = ::crc32_combine(_crc, block.crc, block.size);
+        _uncompressedPos += block.size;
+    }
+
+    // Keep the end of the compressed data as dictionary for the following block.
+    if(offset >= DeflateWindowSize)
+        _dictionary = _pendingInput.mid(offset - DeflateWindowSize, DeflateWindowSize);
+    else
+        _dictionary = (_dictionary + _pendingInput.left(offset)).right(DeflateWindowSize);
+    _pendingInput.remove(0, offset);
+    return true;
+}
+
+/// Writes the gzip trailer and the seek index after the final block of the parallel compressor.
+bool GzipIODevice::writeTrailer()
+{
+    uchar trailer[8];
+    qToLittleEndian<quint32>(_crc, trailer);
+    qToLittleEndian<quint32>((quint32)_uncompressedPos, trailer + 4);
+    if(!writeBytes(reinterpret_cast<const char*>(trailer), sizeof(trailer)))
+        return false;
+    if(_seekIndexInterval <= 0 || _checkpoints.empty())
+        return true;
+
+    // The seek index is stored in the extra fields of empty gzip members following the compressed data.
+    // A last member of fixed size records where the index starts, so that readers can find it from the end of the file.
+    qint64 indexStart = _compressedPos;
+    for(size_t first = 0; first < _checkpoints.size(); first += SeekIndexEntriesPerMember) {
+        size_t last = std::min(first + SeekIndexEntriesPerMember, _checkpoints.size());
+        QByteArray payload((last - first) * 16, Qt::Uninitialized);
+        uchar* entry = reinterpret_cast<uchar*>(payload.data());
+        for(size_t i = first; i < last; i++, entry += 16) {
+            qToLittleEndian<quint64>(_checkpoints[i].uncompressedOffset, entry);
+            qToLittleEndian<quint64>(_checkpoints[i].compressedOffset, entry + 8);
+        }
+        QByteArray member = emptyGzipMember(SeekIndexFieldId, payload);
+        if(!writeBytes(member.constData(), member.size()))
+            return false;
+    }
+    uchar locator[SeekLocatorSize];
+    qToLittleEndian<quint64>(indexStart, locator);
+    qToLittleEndian<quint32>(_checkpoints.size(), locator + 8);
+    QByteArray member = emptyGzipMember(SeekLocatorFieldId, QByteArray(reinterpret_cast<const char*>(locator), sizeof(locator)));
+    return writeBytes(member.constData(), member.size());
+}
+
+/// Reads the seek index stored at the end of a gzip file written by the parallel compressor.
+std::vector<GzipIODevice::Checkpoint> GzipIODevice::readSeekIndex(QIODevice& device)
+{
+    if(device.isSequential())
+        return {};
+    qint64 originalPos = device.pos();
+    std::vector<Checkpoint> checkpoints = parseSeekIndex(device);
+    device.seek(originalPos);
+    return checkpoints;
+}
+
 // Sets the error string to errorMessage + zlib error string for zlibErrorCode
 void GzipIODevice::setZlibError(const QString& errorMessage, int zlibErrorCode)
 {
@@ -134,16 +398,28 @@ bool GzipIODevice::seek(qint64 pos)
     if(isWritable())
 		return false;
 
-	OpenMode mode = openMode();
-	close();
-    if(_device->isOpen()) {
-    	if(!_device->reset())
-    		return false;
-    }
-	if(!open(mode))
-		return false;
+	// Find the closest checkpoint preceding the requested position.
+	auto checkpoint = std::upper_bound(_checkpoints.cbegin(), _checkpoints.cend(), pos, [](qint64 p, const Checkpoint& c) { return p < c.uncompressedOffset; });
+	qint64 startPos = (checkpoint != _checkpoints.cbegin()) ? std::prev(checkpoint)->uncompressedOffset : 0;
+
+	// Keep decompressing from the current read position if that is closer. Otherwise restart the stream.
+	qint64 currentPos = isOpen() ? (_uncompressedPos - QIODevice::bytesAvailable()) : -1;
+	if(currentPos < startPos || currentPos > pos) {
+		OpenMode mode = openMode();
+		close();
+		if(_device->isOpen()) {
+			if(!_device->reset())
+				return false;
+		}
+		if(!open(mode))
+			return false;
+		if(startPos != 0 && !restartAt(*std::prev(checkpoint)))
+			return false;
+		currentPos = startPos;
+	}
 
 	char buffer[0x10000];
+	pos -= currentPos;
 	while(pos > 0) {
 		qint64 s = read(buffer, std::min(pos, (qint64)sizeof(buffer)));
 		if(s <= 0)
@@ -154,6 +430,54 @@ bool GzipIODevice::seek(qint64 pos)
 	return true;
 }
 
+/// Restarts decompression at the given checkpoint.
+bool GzipIODevice::restartAt(const Checkpoint& checkpoint)
+{
+    z_stream& stream = _zlibStruct->_zlibStream;
+
+    // Decompression continues in the middle of the raw deflate stream, without gzip header.
+    if(::inflateReset2(&stream, -15) != Z_OK)
+        return false;
+
+    // If the checkpoint is located in the middle of a byte, feed the remaining bits of that byte to the decompressor first.
+    if(!_device->seek(checkpoint.compressedOffset - (checkpoint.bits ? 1 : 0)))
+        return false;
+    if(checkpoint.bits) {
+        char c;
+        if(!_device->getChar(&c))
+            return false;
+        ::inflatePrime(&stream, checkpoint.bits, (unsigned char)c >> (8 - checkpoint.bits));
+    }
+
+    // Back-references of the next blocks may point into the 32 KB preceding the checkpoint.
+    // Checkpoints read from a seek index have no window, because the compressor did not refer back across them.
+    if(!checkpoint.window.isEmpty()) {
+        QByteArray window = qUncompress(checkpoint.window);
+        if(::inflateSetDictionary(&stream, reinterpret_cast<const ZlibByte*>(window.constData()), window.size()) != Z_OK)
+            return false;
+    }
+
+    stream.next_in = nullptr;
+    stream.avail_in = 0;
+    _uncompressedPos = checkpoint.uncompressedOffset;
+    _compressedPos = checkpoint.compressedOffset;
+    _state = InStream;
+    return true;
+}
+
+/// Records a checkpoint at the current position if the last one is far enough behind.
+void GzipIODevice::recordCheckpoint()
+{
+    if(_uncompressedPos - (_checkpoints.empty() ? 0 : _checkpoints.back().uncompressedOffset) < _checkpointInterval)
+        return;
+
+    ZlibByte window[32768];
+    uInt windowSize = sizeof(window);
+    if(::inflateGetDictionary(&_zlibStruct->_zlibStream, window, &windowSize) != Z_OK)
+        return;
+    _checkpoints.push_back({ _uncompressedPos, _compressedPos, _zlibStruct->_zlibStream.data_type & 7, qCompress(window, windowSize) });
+}
+
 /*!
     Opens the GzipIODevice in \a mode. Only ReadOnly and WriteOnly is supported.
     This functon will return false if you try to open in other modes.
@@ -228,6 +552,8 @@ bool GzipIODevice::open(OpenMode mode)
     int status;
     if(read) {
         _state = NotReadFirstByte;
+        _uncompressedPos = 0;
+        _compressedPos = _device->pos();
         _zlibStruct->_zlibStream.next_in = nullptr;
         _zlibStruct->_zlibStream.avail_in = 0;
         if(streamFormat() == ZlibFormat) {
@@ -239,7 +565,15 @@ bool GzipIODevice::open(OpenMode mode)
     } 
     else {
         _state = NoBytesWritten;
-        if(streamFormat() == ZlibFormat)
+        _uncompressedPos = 0;
+        _compressedPos = _device->pos();
+        _checkpoints.clear();
+        _pendingInput.clear();
+        _dictionary.clear();
+        // The parallel compressor sets up a separate zlib stream for each block.
+        if(isParallelCompressor())
+            status = Z_OK;
+        else if(streamFormat() == ZlibFormat)
             status = ::deflateInit(&_zlibStruct->_zlibStream, _compressionLevel);
         else
             status = ::deflateInit2(&_zlibStruct->_zlibStream, _compressionLevel, Z_DEFLATED, windowBits, 8, Z_DEFAULT_STRATEGY);
@@ -264,6 +598,14 @@ void GzipIODevice::close()
         _state = NotReadFirstByte;
         ::inflateEnd(&_zlibStruct->_zlibStream);
     } 
+    else if(isParallelCompressor()) {
+        if(_state == BytesWritten || !_pendingInput.isEmpty()) { // Only flush if we have written anything.
+            if(compressBlocks(Z_FINISH))
+                writeTrailer();
+        }
+        _pendingInput.clear();
+        _dictionary.clear();
+    }
     else {
         if(_state == BytesWritten) { // Only flush if we have written anything.
             _state = NoBytesWritten;
@@ -299,7 +641,10 @@ void GzipIODevice::flush()
     if(!isOpen() || openMode() & ReadOnly)
         return;
 
-    flushZlib(Z_SYNC_FLUSH);
+    if(isParallelCompressor())
+        compressBlocks(Z_SYNC_FLUSH);
+    else
+        flushZlib(Z_SYNC_FLUSH);
 }
 
 /*!
@@ -375,8 +720,12 @@ qint64 GzipIODevice::readData(char* data, qint64 maxSize)
             }
         }
 
-        // Decompress.
-        status = ::inflate(&_zlibStruct->_zlibStream, Z_SYNC_FLUSH);
+        // Decompress. When recording checkpoints, stop at each deflate block boundary.
+        const ZlibSize availIn = _zlibStruct->_zlibStream.avail_in;
+        const ZlibSize availOut = _zlibStruct->_zlibStream.avail_out;
+        status = ::inflate(&_zlibStruct->_zlibStream, (_checkpointInterval > 0) ? Z_BLOCK : Z_SYNC_FLUSH);
+        _compressedPos += availIn - _zlibStruct->_zlibStream.avail_in;
+        _uncompressedPos += availOut - _zlibStruct->_zlibStream.avail_out;
         switch(status) {
             case Z_NEED_DICT:
             case Z_DATA_ERROR:
@@ -387,6 +736,10 @@ qint64 GzipIODevice::readData(char* data, qint64 maxSize)
             case Z_BUF_ERROR: // No more input and zlib can not privide more output - Not an error, we can try to read again when we have more input.
                 return 0;
         }
+
+        // Decompression can be restarted at the end of any deflate block except the last one.
+        if(_checkpointInterval > 0 && (_zlibStruct->_zlibStream.data_type & 128) && !(_zlibStruct->_zlibStream.data_type & 64))
+            recordCheckpoint();
     // Loop until data buffer is full or we reach the end of the input stream.
     } 
     while(_zlibStruct->_zlibStream.avail_out != 0 && status != Z_STREAM_END);
@@ -411,6 +764,16 @@ qint64 GzipIODevice::writeData(const char* data, qint64 maxSize)
 {
     if(maxSize < 1)
         return 0;
+
+    if(isParallelCompressor()) {
+        if(_state == Error)
+            return -1;
+        // Collect enough data to keep all worker threads busy before compressing it.
+        _pendingInput.append(data, maxSize);
+        if(_pendingInput.size() >= _parallelBlockSize * ThreadPool::instance().queueCount() * 2 && !compressBlocks(Z_NO_FLUSH))
+            return -1;
+        return maxSize;
+    }
     _zlibStruct->_zlibStream.next_in = reinterpret_cast<ZlibByte*>(const_cast<char*>(data));
     _zlibStruct->_zlibStream.avail_in = maxSize;
 
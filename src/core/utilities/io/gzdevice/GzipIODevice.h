@@ -38,9 +38,19 @@ struct ZLibState;   // Internal data structure
  * the data will be read from the underlying device and then
  * decompressed.
  * 
- * GzipIODevice is a sequential device, which means that it does
- * not support seeks or random access. Internally, GzipIODevice
- * uses the zlib library to compress and uncompress data.
+ * GzipIODevice is a sequential device. In read mode, seek() is nevertheless
+ * supported by decompressing the stream up to the requested position. To make
+ * random access fast, the device can record checkpoints while reading, at which
+ * decompression can later be restarted (see setCheckpointInterval()). seek() then
+ * only needs to decompress the data following the closest checkpoint.
+ *
+ * In write mode, the gzip format can optionally be produced by several threads in parallel
+ * (see setParallelBlockSize()). The data is then split into blocks, which are deflated independently
+ * by the worker threads of the ThreadPool and concatenated into a single gzip member, like the pigz tool does.
+ * Such a stream can be followed by a seek index (see setSeekIndexInterval()), which is ignored by other
+ * gzip decompressors, but provides checkpoints to readers of the file (see readSeekIndex()).
+ *
+ * Internally, GzipIODevice uses the zlib library to compress and uncompress data.
  */
 class OVITO_CORE_EXPORT GzipIODevice : public QIODevice
 {
@@ -55,6 +65,18 @@ public:
 		RawZipFormat
 	};
 
+    /// A position in the compressed stream at which decompression can be restarted.
+    struct Checkpoint {
+        /// The position in the uncompressed data.
+        qint64 uncompressedOffset;
+        /// The position of the first byte in the underlying device that has not been consumed completely.
+        qint64 compressedOffset;
+        /// The number of bits of the byte preceding compressedOffset that belong to the next deflate block.
+        int bits;
+        /// The 32 KB of uncompressed data preceding the checkpoint, compressed with qCompress().
+        QByteArray window;
+    };
+
     /// Constructor.
     ///
     /// The allowed value range for \a compressionLevel is 0 to 9, where 0 means no compression
@@ -83,6 +105,31 @@ public:
     qint64 bytesAvailable() const override;
     bool seek(qint64 pos) override;
 
+    /// Makes the device record a checkpoint approximately every \a interval bytes of uncompressed data while reading.
+    /// A value of zero turns off the recording.
+    void setCheckpointInterval(qint64 interval) { _checkpointInterval = interval; }
+
+    /// Returns the checkpoints recorded so far, sorted by offset.
+    const std::vector<Checkpoint>& checkpoints() const { return _checkpoints; }
+
+    /// Sets the checkpoints to be used by seek(), e.g. the ones recorded by an earlier reading pass over the same file.
+    void setCheckpoints(std::vector<Checkpoint> checkpoints) { _checkpoints = std::move(checkpoints); }
+
+    /// Makes the device compress the written data in blocks of the given size, which are deflated in parallel.
+    /// Each block is primed with the 32 KB of data preceding it to retain the compression ratio of a single stream.
+    /// Only supported for the GzipFormat in write mode. Must be called before open(). A block size of zero
+    /// (the default) selects the sequential compressor.
+    void setParallelBlockSize(qint64 blockSize) { _parallelBlockSize = blockSize; }
+
+    /// Makes the parallel compressor append a seek index to the gzip stream. Approximately every \a interval bytes of
+    /// uncompressed data, a block is compressed without reference to the preceding data, and its position is stored in the index.
+    /// A value of zero (the default) turns off the index. After the device has been closed, checkpoints() returns the index entries.
+    void setSeekIndexInterval(qint64 interval) { _seekIndexInterval = interval; }
+
+    /// Reads the seek index stored at the end of a gzip file written by the parallel compressor.
+    /// Returns an empty list if the device contains no such index. The device must support random access.
+    static std::vector<Checkpoint> readSeekIndex(QIODevice& device);
+
 protected:
 
     qint64 readData(char * data, qint64 maxSize) override;
@@ -111,7 +158,26 @@ private:
     void flushZlib(int flushMode);
 
     /// Writes outputSize bytes from buffer to the inderlying device.
-    bool writeBytes(qint64 outputSize);
+    bool writeBytes(qint64 outputSize) { return writeBytes(reinterpret_cast<const char*>(_buffer.get()), outputSize); }
+
+    /// Writes a block of bytes to the inderlying device.
+    bool writeBytes(const char* data, qint64 size);
+
+    /// Returns whether the written data is compressed by the parallel compressor.
+    bool isParallelCompressor() const { return _parallelBlockSize > 0 && _streamFormat == GzipFormat; }
+
+    /// Deflates the pending input data in parallel and writes the compressed blocks to the underlying device.
+    /// With Z_NO_FLUSH, only complete blocks are compressed. With Z_FINISH, the final block of the stream is written.
+    bool compressBlocks(int flushMode);
+
+    /// Writes the gzip trailer and the seek index after the final block of the parallel compressor.
+    bool writeTrailer();
+
+    /// Records a checkpoint at the current position if the last one is far enough behind.
+    void recordCheckpoint();
+
+    /// Restarts decompression at the given checkpoint.
+    bool restartAt(const Checkpoint& checkpoint);
 
     bool _manageDevice = false;
     int _compressionLevel;
@@ -121,6 +187,25 @@ private:
     ZLibState* _zlibStruct;
     qint64 _bufferSize;
     std::unique_ptr<unsigned char[]> _buffer;
+
+    /// The number of bytes decompressed so far, i.e. the position of the decompressor in the uncompressed stream.
+    qint64 _uncompressedPos = 0;
+    /// The number of compressed bytes consumed so far, i.e. the position of the decompressor in the underlying device.
+    qint64 _compressedPos = 0;
+
+    qint64 _checkpointInterval = 0;
+    std::vector<Checkpoint> _checkpoints;
+
+    /// The block size of the parallel compressor, or zero if the data is compressed sequentially.
+    qint64 _parallelBlockSize = 0;
+    /// The spacing of the seek index entries written by the parallel compressor.
+    qint64 _seekIndexInterval = 0;
+    /// The data passed to the parallel compressor that has not been compressed yet.
+    QByteArray _pendingInput;
+    /// The 32 KB of uncompressed data preceding the pending input.
+    QByteArray _dictionary;
+    /// The CRC-32 checksum of the data compressed so far by the parallel compressor.
+    quint32 _crc = 0;
 };
 
 OVITO_END_INLINE_NAMESPACE
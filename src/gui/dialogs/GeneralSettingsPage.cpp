@@ -21,6 +21,7 @@
 
 #include <gui/GUI.h>
 #include <opengl_renderer/OpenGLSceneRenderer.h>
+#include <core/dataset/pipeline/PipelineCache.h>
 #include "GeneralSettingsPage.h"
 
 namespace Ovito { OVITO_BEGIN_INLINE_NAMESPACE(Gui) OVITO_BEGIN_INLINE_NAMESPACE(Internal)
@@ -125,6 +126,22 @@ void GeneralSettingsPage::insertSettingsDialogPage(ApplicationSettingsDialog* se
 	connect(_overrideUseOfGeometryShaders, &QCheckBox::toggled, _restartRequiredLabel, &QLabel::show);
 	connect(_geometryShaderMode, &QComboBox::currentTextChanged, _restartRequiredLabel, &QLabel::show);
 
+	QGroupBox* cacheGroupBox = new QGroupBox(tr("Pipeline cache"), page);
+	layout1->addWidget(cacheGroupBox);
+	layout2 = new QGridLayout(cacheGroupBox);
+
+	layout2->addWidget(new QLabel(tr("Memory for caching further animation frames:")), 0, 0);
+	_pipelineCacheMemoryBudget = new QSpinBox(cacheGroupBox);
+	_pipelineCacheMemoryBudget->setToolTip(tr(
+			"<p>The pipeline results for animation frames visited before are kept in memory up to this limit, "
+			"so that going back to these frames does not require recomputing them. Set to zero to only cache the current frame.</p>"));
+	_pipelineCacheMemoryBudget->setRange(0, 1024*1024);
+	_pipelineCacheMemoryBudget->setSingleStep(256);
+	_pipelineCacheMemoryBudget->setSuffix(tr(" MB"));
+	_pipelineCacheMemoryBudget->setValue((int)(PipelineCache::memoryBudget() >> 20));
+	layout2->addWidget(_pipelineCacheMemoryBudget, 0, 1);
+	layout2->setColumnStretch(2, 1);
+
 #if !defined(OVITO_BUILD_APPSTORE_VERSION)
 	QGroupBox* updateGroupBox = new QGroupBox(tr("Program updates"), page);
 	layout1->addWidget(updateGroupBox);
@@ -164,6 +181,7 @@ bool GeneralSettingsPage::saveValues(ApplicationSettingsDialog* settingsDialog,
 	settings.setValue("updates/check_for_updates", _enableUpdateChecks->isChecked());
 	settings.setValue("updates/transmit_id", _enableUsageStatistics->isChecked());
 #endif
+	PipelineCache::setMemoryBudget((size_t)_pipelineCacheMemoryBudget->value() << 20);
 	if(_overrideGLContextSharing->isChecked())
 		settings.setValue("display/share_opengl_context", _contextSharingMode->currentIndex() == 0);
 	else
@@ -60,6 +60,7 @@ private:
 	QComboBox* _pointSpriteMode;
 	QCheckBox* _overrideUseOfGeometryShaders;
 	QComboBox* _geometryShaderMode;
+	QSpinBox* _pipelineCacheMemoryBudget;
 #if !defined(OVITO_BUILD_APPSTORE_VERSION)
 	QCheckBox* _enableUpdateChecks;
 	QCheckBox* _enableUsageStatistics;
@@ -76,7 +76,7 @@ void CAImporter::FrameFinder::discoverFramesInFile(QFile& file, const QUrl& sour
 			byteOffset = stream.byteOffset();
 			stream.readLine();
 		}
-		int startLineNumber = stream.lineNumber();
+		qint64 startLineNumber = stream.lineNumber();
 
 		if(stream.line()[0] == '\0') break;
 		if(!stream.lineStartsWith("CA_FILE_VERSION "))
@@ -31,6 +31,11 @@ namespace Ovito { namespace Particles { OVITO_BEGIN_INLINE_NAMESPACE(Export)
 
 IMPLEMENT_OVITO_CLASS(ParticleExporter);	
 
+namespace {
+	/// The stream of the frame that is being formatted by the current thread during a pipelined export.
+	thread_local CompressedTextWriter* frameTextStream = nullptr;
+}
+
 /******************************************************************************
 * Constructs a new instance of the class.
 ******************************************************************************/
@@ -45,7 +50,17 @@ ParticleExporter::ParticleExporter(DataSet* dataset) : FileExporter(dataset)
 PipelineFlowState ParticleExporter::getParticleData(TimePoint time, AsyncOperation& operation) const
 {
 	PipelineFlowState state = getPipelineDataToBeExported(time, operation);
+	if(!state.isEmpty())
+		checkParticleData(state);
+	return state;
+}
 
+/******************************************************************************
+* Makes sure that the pipeline output contains consistent particle data and
+* throws an exception if not.
+******************************************************************************/
+void ParticleExporter::checkParticleData(const PipelineFlowState& state) const
+{
 	const ParticlesObject* particles = state.getObject<ParticlesObject>();
 	if(!particles || !particles->getProperty(ParticlesObject::PositionProperty))
 		throwException(tr("The selected data collection does not contain any particles that can be exported."));
@@ -63,8 +78,6 @@ PipelineFlowState ParticleExporter::getParticleData(TimePoint time, AsyncOperati
 				throwException(tr("Data produced by pipeline is invalid. The array size of some bond properties is not consistent with the number of bonds."));
 		}
 	}
-
-	return state;
 }
 
 /******************************************************************************
@@ -97,6 +110,16 @@ void ParticleExporter::closeOutputFile(bool exportCompleted)
 		_outputFile.remove();
 }
 
+/******************************************************************************
+ * Returns the text stream used to write into the current output file.
+ *****************************************************************************/
+CompressedTextWriter& ParticleExporter::textStream()
+{
+	if(frameTextStream)
+		return *frameTextStream;
+	return *_outputStream;
+}
+
 /******************************************************************************
  * Exports a single animation frame to the current output file.
  *****************************************************************************/
@@ -112,6 +135,41 @@ bool ParticleExporter::exportFrame(int frameNumber, TimePoint time, const QStrin
 	return exportData(state, frameNumber, time, filePath, std::move(operation));
 }
 
+/******************************************************************************
+ * Prepares the export of a single animation frame in a worker thread.
+ *****************************************************************************/
+FileExporter::FrameWriterFunction ParticleExporter::prepareFrameWriter(const PipelineFlowState& state, int frameNumber, TimePoint time, const QString& filePath)
+{
+	if(!supportsConcurrentFrameExport())
+		return {};
+
+	checkParticleData(state);
+
+	return [this, state, frameNumber, time, filePath](CompressedTextWriter& stream, AsyncOperation&& operation) {
+		// Redirect the output of exportData() to the stream of this frame.
+		CompressedTextWriter* outerStream = frameTextStream;
+		frameTextStream = &stream;
+		try {
+			bool result = exportData(state, frameNumber, time, filePath, std::move(operation));
+			frameTextStream = outerStream;
+			return result;
+		}
+		catch(...) {
+			frameTextStream = outerStream;
+			throw;
+		}
+	};
+}
+
+/******************************************************************************
+ * Appends the text of a frame produced by a FrameWriterFunction to the
+ * current output file.
+ *****************************************************************************/
+void ParticleExporter::writeFormattedFrame(const QByteArray& text)
+{
+	*_outputStream << text;
+}
+
 OVITO_END_INLINE_NAMESPACE
 }	// End of namespace
 }	// End of namespace
@@ -64,11 +64,23 @@ protected:
 	QFile& outputFile() { return _outputFile; }
 
 	/// Returns the text stream used to write into the current output file.
-	CompressedTextWriter& textStream() { return *_outputStream; }
+	/// While a frame is being formatted by a worker thread, this is the stream of that frame.
+	CompressedTextWriter& textStream();
 
 	/// \brief Exports a single animation frame to the current output file.
 	virtual bool exportFrame(int frameNumber, TimePoint time, const QString& filePath, AsyncOperation&& operation) override;
 
+	/// \brief Prepares the export of a single animation frame in a worker thread.
+	virtual FrameWriterFunction prepareFrameWriter(const PipelineFlowState& state, int frameNumber, TimePoint time, const QString& filePath) override;
+
+	/// \brief Appends the text of a frame produced by a FrameWriterFunction to the current output file.
+	virtual void writeFormattedFrame(const QByteArray& text) override;
+
+	/// \brief Indicates whether exportData() may be called for several frames at the same time from worker threads.
+	/// Subclasses should return true if exportData() only reads the pipeline output and the exporter's parameters and
+	/// writes to textStream().
+	virtual bool supportsConcurrentFrameExport() const { return false; }
+
 	/// \brief Writes the particle data of one animation frame to the current output file.
 	/// \param state The data to be exported.
 	/// \param frameNumber The animation frame to be written to the output file.
@@ -80,6 +92,9 @@ protected:
 
 private:
 
+	/// Makes sure that the pipeline output contains consistent particle data and throws an exception if not.
+	void checkParticleData(const PipelineFlowState& state) const;
+
 	/// The output file stream.
 	QFile _outputFile;
 
@@ -61,6 +61,9 @@ protected:
 
 	/// \brief Writes the particles of one animation frame to the current output file.
 	virtual bool exportData(const PipelineFlowState& state, int frameNumber, TimePoint time, const QString& filePath, AsyncOperation&& operation) override;
+
+	/// \brief Indicates whether exportData() may be called for several frames at the same time from worker threads.
+	virtual bool supportsConcurrentFrameExport() const override { return true; }
 };
 
 OVITO_END_INLINE_NAMESPACE
@@ -50,6 +50,10 @@ void CFGImporterEditor::createUI(const RolloutInsertionParameters& rolloutParams
 	// Sort particles
 	BooleanParameterUI* sortParticlesUI = new BooleanParameterUI(this, PROPERTY_FIELD(ParticleImporter::sortParticles));
 	sublayout->addWidget(sortParticlesUI->checkBox());
+
+	// Parsed frame cache
+	BooleanParameterUI* cacheParsedFramesUI = new BooleanParameterUI(this, PROPERTY_FIELD(ParticleImporter::cacheParsedFrames));
+	sublayout->addWidget(cacheParsedFramesUI->checkBox());
 }
 
 OVITO_END_INLINE_NAMESPACE
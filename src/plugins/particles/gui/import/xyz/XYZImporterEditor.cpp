@@ -148,6 +148,10 @@ void XYZImporterEditor::createUI(const RolloutInsertionParameters& rolloutParams
 	BooleanParameterUI* sortParticlesUI = new BooleanParameterUI(this, PROPERTY_FIELD(ParticleImporter::sortParticles));
 	sublayout->addWidget(sortParticlesUI->checkBox());
 
+	// Parsed frame cache
+	BooleanParameterUI* cacheParsedFramesUI = new BooleanParameterUI(this, PROPERTY_FIELD(ParticleImporter::cacheParsedFrames));
+	sublayout->addWidget(cacheParsedFramesUI->checkBox());
+
 	QGroupBox* columnMappingBox = new QGroupBox(tr("File columns"), rollout);
 	sublayout = new QVBoxLayout(columnMappingBox);
 	sublayout->setContentsMargins(4,4,4,4);
@@ -72,6 +72,10 @@ void ClusterAnalysisModifierEditor::createUI(const RolloutInsertionParameters& r
 	BooleanParameterUI* onlySelectedParticlesUI = new BooleanParameterUI(this, PROPERTY_FIELD(ClusterAnalysisModifier::onlySelectedParticles));
 	gridlayout->addWidget(onlySelectedParticlesUI->checkBox(), 5, 0, 1, 3);
 
+	// Compute centers of mass.
+	BooleanParameterUI* computeCentersOfMassUI = new BooleanParameterUI(this, PROPERTY_FIELD(ClusterAnalysisModifier::computeCentersOfMass));
+	gridlayout->addWidget(computeCentersOfMassUI->checkBox(), 6, 0, 1, 3);
+
 	layout->addLayout(gridlayout);
 
 	// Status label.
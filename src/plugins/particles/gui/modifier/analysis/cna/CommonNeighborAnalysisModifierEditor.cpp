@@ -66,12 +66,19 @@ void CommonNeighborAnalysisModifierEditor::createUI(const RolloutInsertionParame
 
 	CutoffRadiusPresetsUI* cutoffPresetsPUI = new CutoffRadiusPresetsUI(this, PROPERTY_FIELD(CommonNeighborAnalysisModifier::cutoff));
 	gridlayout->addWidget(cutoffPresetsPUI->comboBox(), 1, 1, 1, 2);
+
+	// Verlet skin parameter.
+	FloatParameterUI* verletSkinPUI = new FloatParameterUI(this, PROPERTY_FIELD(CommonNeighborAnalysisModifier::verletSkin));
+	gridlayout->addWidget(verletSkinPUI->label(), 2, 1);
+	gridlayout->addLayout(verletSkinPUI->createFieldLayout(), 2, 2);
 	layout1->addLayout(gridlayout);
 
 	connect(fixedCutoffModeBtn, &QRadioButton::toggled, cutoffRadiusPUI, &FloatParameterUI::setEnabled);
 	connect(fixedCutoffModeBtn, &QRadioButton::toggled, cutoffPresetsPUI, &CutoffRadiusPresetsUI::setEnabled);
+	connect(fixedCutoffModeBtn, &QRadioButton::toggled, verletSkinPUI, &FloatParameterUI::setEnabled);
 	cutoffRadiusPUI->setEnabled(false);
 	cutoffPresetsPUI->setEnabled(false);
+	verletSkinPUI->setEnabled(false);
 
 	// Use only selected particles.
 	BooleanParameterUI* onlySelectedParticlesUI = new BooleanParameterUI(this, PROPERTY_FIELD(StructureIdentificationModifier::onlySelectedParticles));
@@ -57,6 +57,11 @@ void CoordinationAnalysisModifierEditor::createUI(const RolloutInsertionParamete
 	IntegerParameterUI* numBinsPUI = new IntegerParameterUI(this, PROPERTY_FIELD(CoordinationAnalysisModifier::numberOfBins));
 	gridlayout->addWidget(numBinsPUI->label(), 1, 0);
 	gridlayout->addLayout(numBinsPUI->createFieldLayout(), 1, 1);
+
+	// Verlet skin parameter.
+	FloatParameterUI* verletSkinPUI = new FloatParameterUI(this, PROPERTY_FIELD(CoordinationAnalysisModifier::verletSkin));
+	gridlayout->addWidget(verletSkinPUI->label(), 2, 0);
+	gridlayout->addLayout(verletSkinPUI->createFieldLayout(), 2, 1);
 	layout->addLayout(gridlayout);
 
 	// Partial RDFs option.
@@ -22,6 +22,7 @@
 #include <plugins/particles/Particles.h>
 #include <plugins/particles/objects/ParticlesObject.h>
 #include <core/utilities/io/NumberParsing.h>
+#include <core/utilities/concurrent/ParallelFor.h>
 #include "InputColumnMapping.h"
 #include "ParticleFrameData.h"
 
@@ -215,6 +216,14 @@ InputColumnReader::InputColumnReader(const InputColumnMapping& mapping, Particle
  * in the data channels of the destination AtomsObject.
  *****************************************************************************/
 const char* InputColumnReader::readParticle(size_t particleIndex, const char* s, const char* s_end)
+{
+	return readParticleLine(particleIndex, s, s_end, nullptr);
+}
+
+/******************************************************************************
+ * Parses one line from a memory buffer.
+ *****************************************************************************/
+const char* InputColumnReader::readParticleLine(size_t particleIndex, const char* s, const char* s_end, LocalTypeLists* localTypes)
 {
 	OVITO_ASSERT(_properties.size() == _mapping.size());
 	OVITO_ASSERT(s <= s_end);
@@ -230,7 +239,7 @@ const char* InputColumnReader::readParticle(size_t particleIndex, const char* s,
 		while(s != s_end && (*s > ' ' || *s < 0))
 			++s;
 		if(s != token) {
-			parseField(particleIndex, columnIndex, token, s);
+			parseField(particleIndex, columnIndex, token, s, localTypes);
 			columnIndex++;
 		}
 		if(s == s_end) break;
@@ -274,7 +283,7 @@ void InputColumnReader::readParticle(size_t particleIndex, const char* s)
 /******************************************************************************
  * Parse a single field from a text line.
  *****************************************************************************/
-void InputColumnReader::parseField(size_t particleIndex, int columnIndex, const char* token, const char* token_end)
+void InputColumnReader::parseField(size_t particleIndex, int columnIndex, const char* token, const char* token_end, LocalTypeLists* localTypes)
 {
 	TargetPropertyRecord& prec = _properties[columnIndex];
 	if(!prec.property || !prec.data) return;
@@ -298,12 +307,16 @@ void InputColumnReader::parseField(size_t particleIndex, int columnIndex, const
 		}
 		else {
 			// Automatically register a new particle type if a new type identifier is encountered.
+			ParticleFrameData::TypeList* typeList = localTypes ? &localTypes->lists[columnIndex] : prec.typeList;
 			if(ok) {
-				prec.typeList->addTypeId(d);
+				typeList->addTypeId(d);
 			}
 			else {
-				d = prec.typeList->addTypeName(token, token_end);
-				prec.numericParticleTypes = false;
+				d = typeList->addTypeName(token, token_end);
+				if(localTypes)
+					localTypes->numericTypes[columnIndex] = false;
+				else
+					prec.numericParticleTypes = false;
 			}
 		}
 	}
@@ -352,6 +365,153 @@ void InputColumnReader::readParticle(size_t particleIndex, const double* values,
 	}
 }
 
+/******************************************************************************
+ * Parses a block of consecutive data lines from a memory buffer, using all
+ * processor cores.
+ *****************************************************************************/
+const char* InputColumnReader::readParticles(size_t particleIndex, size_t count, const char* s, const char* s_end, PromiseState& promise, qint64& lineNumber)
+{
+	// Approximate number of bytes parsed by one thread at a time.
+	const size_t chunkSize = 1 << 20;
+	const size_t chunksPerWindow = 4 * ThreadPool::instance().queueCount();
+
+	// Returns the beginning of the line following the one containing the given position.
+	auto nextLine = [s_end](const char* p) -> const char* {
+		const char* newline = static_cast<const char*>(std::memchr(p, '\n', s_end - p));
+		return newline ? newline + 1 : s_end;
+	};
+
+	struct Chunk {
+		const char* begin;
+		const char* end;
+		size_t lineCount;
+		size_t firstLine;
+		LocalTypeLists types;
+		std::exception_ptr exception;
+		size_t exceptionLine;
+	};
+	std::vector<Chunk> chunks;
+
+	const size_t endIndex = particleIndex + count;
+	while(particleIndex < endIndex) {
+		// If the buffer has ended prematurely, let the serial parser generate the error message.
+		if(s == s_end) {
+			for(; particleIndex < endIndex; particleIndex++, lineNumber++)
+				s = readParticleLine(particleIndex, s, s_end, nullptr);
+			break;
+		}
+
+		// Split the next window of the buffer into chunks at line boundaries.
+		chunks.clear();
+		const char* p = s;
+		while(p != s_end && chunks.size() < chunksPerWindow) {
+			const char* chunkEnd = ((size_t)(s_end - p) > chunkSize) ? nextLine(p + chunkSize - 1) : s_end;
+			chunks.push_back(Chunk{p, chunkEnd, 0, 0, {}, {}, 0});
+			p = chunkEnd;
+		}
+
+		// Count the lines in each chunk.
+		parallelFor(chunks.size(), [&chunks, s_end](size_t i) {
+			Chunk& chunk = chunks[i];
+			chunk.lineCount = std::count(chunk.begin, chunk.end, '\n');
+			if(chunk.end == s_end && chunk.end != chunk.begin && chunk.end[-1] != '\n')
+				chunk.lineCount++;
+		});
+
+		// Assign the particle indices and drop the lines following the block.
+		size_t index = particleIndex;
+		for(size_t i = 0; i < chunks.size(); i++) {
+			Chunk& chunk = chunks[i];
+			chunk.firstLine = index;
+			if(chunk.lineCount >= endIndex - index) {
+				chunk.lineCount = endIndex - index;
+				const char* lineEnd = chunk.begin;
+				for(size_t j = 0; j < chunk.lineCount; j++)
+					lineEnd = nextLine(lineEnd);
+				chunk.end = lineEnd;
+				chunks.resize(i + 1);
+			}
+			index += chunk.lineCount;
+		}
+
+		// Parse the chunks.
+		parallelFor(chunks.size(), [this, &chunks, &promise](size_t i) {
+			Chunk& chunk = chunks[i];
+			chunk.types.lists.resize(_properties.size());
+			chunk.types.numericTypes.resize(_properties.size(), true);
+			const char* line = chunk.begin;
+			size_t j = 0;
+			try {
+				for(; j < chunk.lineCount; j++) {
+					if((j % 4096) == 0 && promise.isCanceled())
+						return;
+					line = readParticleLine(chunk.firstLine + j, line, chunk.end, &chunk.types);
+				}
+			}
+			catch(...) {
+				chunk.exception = std::current_exception();
+				chunk.exceptionLine = j;
+			}
+			promise.incrementProgressValue(chunk.lineCount);
+		});
+		if(promise.isCanceled())
+			return nullptr;
+
+		// Report the first error in the file.
+		for(const Chunk& chunk : chunks) {
+			if(chunk.exception) {
+				lineNumber += (qint64)(chunk.firstLine - particleIndex + chunk.exceptionLine);
+				std::rethrow_exception(chunk.exception);
+			}
+		}
+
+		// Register the particle types in the order of their first occurrence, and map the type IDs that were
+		// assigned to named types within each chunk to the global IDs.
+		for(int column = 0; column < _properties.size(); column++) {
+			TargetPropertyRecord& prec = _properties[column];
+			if(!prec.property || !prec.data || !prec.typeList) continue;
+			std::vector<std::vector<std::pair<int,int>>> idMaps(chunks.size());
+			bool needsRemapping = false;
+			for(size_t i = 0; i < chunks.size(); i++) {
+				for(const ParticleFrameData::TypeDefinition& type : chunks[i].types.lists[column].types()) {
+					if(type.name8bit.empty()) {
+						prec.typeList->addTypeId(type.id);
+					}
+					else {
+						int globalId = prec.typeList->addTypeName(type.name8bit.data(), type.name8bit.data() + type.name8bit.size());
+						if(globalId != type.id) {
+							idMaps[i].emplace_back(type.id, globalId);
+							needsRemapping = true;
+						}
+					}
+				}
+				if(!chunks[i].types.numericTypes[column])
+					prec.numericParticleTypes = false;
+			}
+			if(needsRemapping) {
+				parallelFor(chunks.size(), [&chunks, &idMaps, &prec](size_t i) {
+					if(idMaps[i].empty()) return;
+					for(size_t j = chunks[i].firstLine; j < chunks[i].firstLine + chunks[i].lineCount; j++) {
+						int& d = *reinterpret_cast<int*>(prec.data + j * prec.stride);
+						for(const auto& entry : idMaps[i]) {
+							if(d == entry.first) {
+								d = entry.second;
+								break;
+							}
+						}
+					}
+				});
+			}
+		}
+
+		lineNumber += (qint64)(index - particleIndex);
+		particleIndex = index;
+		s = chunks.back().end;
+	}
+
+	return s;
+}
+
 /******************************************************************************
  * Sorts the created particle types either by numeric ID or by name,
  * depending on how they were stored in the input file.
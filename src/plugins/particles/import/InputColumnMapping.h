@@ -174,13 +174,39 @@ public:
 	/// \brief Processes the values from one line of the input file and stores them in the particle properties.
 	void readParticle(size_t particleIndex, const double* values, int nvalues);
 
+	/// \brief Parses a block of consecutive data lines from a memory buffer, using all processor cores.
+	/// \param particleIndex The index of the particle whose data is stored in the first line.
+	/// \param count The number of lines to parse.
+	/// \param s Points to the beginning of the first line.
+	/// \param s_end The end of the memory buffer, which may extend beyond the last line to be parsed.
+	/// \param promise Used to report progress (one unit per line) and to check for cancellation.
+	/// \param lineNumber On input, the line number of the first line in the file. On output, the line number
+	///                   following the block, or the number of the offending line if an exception is thrown.
+	/// \return The beginning of the line following the block, or nullptr if the operation has been canceled.
+	///
+	/// The buffer is split into chunks at line boundaries, which are parsed simultaneously into the respective ranges of the
+	/// destination properties. Particle types are first collected per chunk and then registered in the order of their first
+	/// occurrence in the file, which yields the same type IDs as a serial parse.
+	const char* readParticles(size_t particleIndex, size_t count, const char* s, const char* s_end, PromiseState& promise, qint64& lineNumber);
+
 	/// \brief Sorts the created particle types either by numeric ID or by name, depending on how they were stored in the input file.
 	void sortParticleTypes();
 
 private:
 
+	/// The particle types encountered while parsing a chunk of lines in parallel.
+	struct LocalTypeLists {
+		/// One type list per file column (only used for columns with a type list).
+		std::vector<ParticleFrameData::TypeList> lists;
+		/// Indicates for each file column whether types have been specified as numeric IDs only.
+		std::vector<char> numericTypes;
+	};
+
+	/// Parses one line from a memory buffer. Particle types are registered in the given local lists if provided.
+	const char* readParticleLine(size_t particleIndex, const char* s, const char* s_end, LocalTypeLists* localTypes);
+
 	/// Parse a single field from a text line.
-	void parseField(size_t particleIndex, int columnIndex, const char* token, const char* token_end);
+	void parseField(size_t particleIndex, int columnIndex, const char* token, const char* token_end, LocalTypeLists* localTypes = nullptr);
 
 	/// Determines which input data columns are stored in what properties.
 	InputColumnMapping _mapping;
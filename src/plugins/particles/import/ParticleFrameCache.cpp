@@ -0,0 +1,300 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (2018) Alexander Stukowski
+//
+//  This file is part of OVITO (Open Visualization Tool).
+//
+//  OVITO is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  OVITO is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <plugins/particles/Particles.h>
+#include <core/utilities/io/DiskCache.h>
+#include "ParticleFrameCache.h"
+
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QSaveFile>
+
+#ifndef Q_OS_WIN
+	#include <sys/mman.h>
+	#include <unistd.h>
+#endif
+
+namespace Ovito { namespace Particles { OVITO_BEGIN_INLINE_NAMESPACE(Import)
+
+namespace {
+	/// Identifies parsed frame cache files.
+	constexpr quint32 FrameCacheMagic = 0x4F565046;
+	/// Version of the cache file format.
+	constexpr quint32 FrameCacheVersion = 1;
+	/// Alignment of the property arrays in the cache file.
+	constexpr qint64 DataAlignment = 4096;
+
+	/// Returns the cache directory holding the parsed frames. Its size is limited by the application setting
+	/// particles/parsed_frame_cache/size_limit (4 GB by default).
+	DiskCache parsedFrameCache() {
+		static const qint64 sizeLimit = QSettings().value("particles/parsed_frame_cache/size_limit", QVariant::fromValue((qlonglong)4 << 30)).toLongLong();
+		return DiskCache(QStringLiteral("parsed_frames"), sizeLimit);
+	}
+
+	/// Rounds a file offset up to the next multiple of the data alignment.
+	qint64 alignOffset(qint64 offset) {
+		return (offset + DataAlignment - 1) / DataAlignment * DataAlignment;
+	}
+
+	/// Maps a section of the opened cache file into memory. The mapping stays valid until the last copy of the returned pointer is released.
+	std::shared_ptr<const uchar> mapFile(const std::shared_ptr<QFile>& file, qint64 offset, qint64 size) {
+#ifdef Q_OS_WIN
+		// A mapping created by QFile ends when the file is closed, so it has to keep the file open.
+		const uchar* data = file->map(offset, size);
+		if(!data)
+			return {};
+		return std::shared_ptr<const uchar>(file, data);
+#else
+		// A POSIX mapping survives closing the file descriptor. Not keeping the descriptors open lets
+		// the pipeline hold any number of cached frames without exhausting the per-process limit.
+		static const qint64 pageSize = sysconf(_SC_PAGESIZE);
+		qint64 mapOffset = offset / pageSize * pageSize;
+		size_t mapLength = (size_t)(size + offset - mapOffset);
+		void* mapping = ::mmap(nullptr, mapLength, PROT_READ, MAP_SHARED, file->handle(), mapOffset);
+		if(mapping == MAP_FAILED)
+			return {};
+		return std::shared_ptr<const uchar>(static_cast<const uchar*>(mapping) + (offset - mapOffset), [mapping, mapLength](const uchar*) {
+			::munmap(mapping, mapLength);
+		});
+#endif
+	}
+
+	/// Layout of a property array in the cache file.
+	struct PropertyRecord {
+		int type;
+		QString name;
+		int dataType;
+		quint64 componentCount;
+		quint64 stride;
+		QStringList componentNames;
+		quint64 size;
+		quint64 dataOffset;
+	};
+
+	QDataStream& operator<<(QDataStream& stream, const PropertyRecord& r) {
+		return stream << r.type << r.name << r.dataType << r.componentCount << r.stride << r.componentNames << r.size << r.dataOffset;
+	}
+
+	QDataStream& operator>>(QDataStream& stream, PropertyRecord& r) {
+		return stream >> r.type >> r.name >> r.dataType >> r.componentCount >> r.stride >> r.componentNames >> r.size >> r.dataOffset;
+	}
+}
+
+/******************************************************************************
+* Constructor.
+******************************************************************************/
+ParticleFrameCache::ParticleFrameCache(const QString& filename, qint64 byteOffset, const QByteArray& parserKey) :
+	_filename(QFileInfo(filename).absoluteFilePath()), _byteOffset(byteOffset), _parserKey(parserKey)
+{
+	QFileInfo fileInfo(_filename);
+	DiskCache cache = parsedFrameCache();
+	if(!fileInfo.exists() || !cache.isValid())
+		return;
+	_fileSize = fileInfo.size();
+	_lastModified = fileInfo.lastModified().toMSecsSinceEpoch();
+
+	// The size and modification time are not part of the file name, so that the entry of a modified file gets overwritten.
+	QCryptographicHash hash(QCryptographicHash::Sha1);
+	hash.addData(_filename.toUtf8());
+	hash.addData(QByteArray::number(_byteOffset));
+	hash.addData(_parserKey);
+	_cacheFilePath = cache.filePath(QString::fromLatin1(hash.result().toHex()) + QStringLiteral(".frame"));
+}
+
+/******************************************************************************
+* Deletes all cached frames.
+******************************************************************************/
+void ParticleFrameCache::clear()
+{
+	parsedFrameCache().clear();
+}
+
+/******************************************************************************
+* Loads the frame data from the cache.
+******************************************************************************/
+std::shared_ptr<ParticleFrameData> ParticleFrameCache::load() const
+{
+	if(!isValid())
+		return {};
+	auto file = std::make_shared<QFile>(_cacheFilePath);
+	if(!file->open(QIODevice::ReadOnly))
+		return {};
+	QDataStream stream(file.get());
+	stream.setVersion(QDataStream::Qt_5_4);
+
+	quint32 magic, version;
+	stream >> magic >> version;
+	if(stream.status() != QDataStream::Ok || magic != FrameCacheMagic || version != FrameCacheVersion)
+		return {};
+
+	QString filename;
+	qint64 fileSize, lastModified, byteOffset;
+	QByteArray parserKey;
+	stream >> filename >> fileSize >> lastModified >> byteOffset >> parserKey;
+	if(stream.status() != QDataStream::Ok || filename != _filename || fileSize != _fileSize || lastModified != _lastModified || byteOffset != _byteOffset || parserKey != _parserKey)
+		return {};
+
+	auto frameData = std::make_shared<ParticleFrameData>();
+	QString statusText;
+	AffineTransformation cellMatrix;
+	bool pbcX, pbcY, pbcZ, is2D;
+	quint64 shape[3];
+	stream >> statusText >> frameData->_attributes >> cellMatrix >> pbcX >> pbcY >> pbcZ >> is2D;
+	stream >> shape[0] >> shape[1] >> shape[2] >> frameData->_detectedAdditionalFrames;
+	frameData->setStatus(statusText);
+	frameData->_simulationCell.setMatrix(cellMatrix);
+	frameData->_simulationCell.setPbcFlags(pbcX, pbcY, pbcZ);
+	frameData->_simulationCell.set2D(is2D);
+	frameData->_voxelGridShape = {{ (size_t)shape[0], (size_t)shape[1], (size_t)shape[2] }};
+
+	// Read the property layouts.
+	struct ArrayRecord {
+		std::vector<PropertyPtr>* list;
+		PropertyRecord record;
+		std::unique_ptr<ParticleFrameData::TypeList> typeList;
+	};
+	std::vector<ArrayRecord> arrays;
+	for(std::vector<PropertyPtr>* properties : { &frameData->_particleProperties, &frameData->_bondProperties, &frameData->_voxelProperties }) {
+		qint32 count;
+		stream >> count;
+		if(stream.status() != QDataStream::Ok || count < 0)
+			return {};
+		for(qint32 i = 0; i < count; i++) {
+			ArrayRecord array{ properties };
+			qint32 typeCount;
+			stream >> array.record >> typeCount;
+			if(stream.status() != QDataStream::Ok || array.record.componentCount == 0 || array.record.stride == 0 || array.record.dataOffset % DataAlignment != 0)
+				return {};
+			if(typeCount >= 0) {
+				array.typeList = std::make_unique<ParticleFrameData::TypeList>();
+				for(qint32 t = 0; t < typeCount; t++) {
+					int id;
+					QString name;
+					Color color;
+					FloatType radius;
+					stream >> id >> name >> color.r() >> color.g() >> color.b() >> radius;
+					array.typeList->addTypeId(id, name, color, radius);
+				}
+			}
+			arrays.push_back(std::move(array));
+		}
+	}
+	if(stream.status() != QDataStream::Ok)
+		return {};
+
+	// Map the data section into memory. The property storages reference the mapped arrays directly
+	// and share ownership of the mapping, which keeps it alive.
+	qint64 dataStart = alignOffset(file->pos());
+	qint64 dataSize = std::max<qint64>(file->size() - dataStart, 0);
+	std::shared_ptr<const uchar> data;
+	if(dataSize != 0) {
+		data = mapFile(file, dataStart, dataSize);
+		if(!data)
+			return {};
+	}
+	for(ArrayRecord& array : arrays) {
+		const PropertyRecord& record = array.record;
+		quint64 bytes = record.size * record.stride;
+		if(bytes != 0 && (record.dataOffset > (quint64)dataSize || bytes > (quint64)dataSize - record.dataOffset))
+			return {};
+		std::shared_ptr<const uint8_t> arrayData;
+		if(bytes != 0)
+			arrayData = std::shared_ptr<const uint8_t>(data, data.get() + record.dataOffset);
+		PropertyPtr property = std::make_shared<PropertyStorage>(record.size, record.dataType, record.componentCount, record.stride,
+			record.name, std::move(arrayData), record.type, record.componentNames);
+		if(property->stride() != record.stride)
+			return {};
+		if(array.typeList)
+			frameData->setPropertyTypesList(property, std::move(array.typeList));
+		array.list->push_back(std::move(property));
+	}
+
+	// Protect the entry from eviction, because it is likely to be needed again.
+	DiskCache::markUsed(_cacheFilePath);
+
+	return frameData;
+}
+
+/******************************************************************************
+* Writes the frame data to the cache.
+******************************************************************************/
+void ParticleFrameCache::store(const ParticleFrameData& frameData) const
+{
+	if(!isValid() || !QDir().mkpath(QFileInfo(_cacheFilePath).path()))
+		return;
+	QSaveFile file(_cacheFilePath);
+	if(!file.open(QIODevice::WriteOnly))
+		return;
+	QDataStream stream(&file);
+	stream.setVersion(QDataStream::Qt_5_4);
+
+	stream << FrameCacheMagic << FrameCacheVersion;
+	stream << _filename << _fileSize << _lastModified << _byteOffset << _parserKey;
+
+	const SimulationCell& cell = frameData._simulationCell;
+	const VoxelGrid::GridDimensions& shape = frameData._voxelGridShape;
+	stream << frameData.status().text() << frameData._attributes << cell.matrix();
+	stream << cell.pbcFlags()[0] << cell.pbcFlags()[1] << cell.pbcFlags()[2] << cell.is2D();
+	stream << (quint64)shape[0] << (quint64)shape[1] << (quint64)shape[2] << frameData._detectedAdditionalFrames;
+
+	// Assign aligned offsets in the data section to the property arrays.
+	std::vector<std::pair<const PropertyStorage*, quint64>> arrays;
+	quint64 dataOffset = 0;
+	for(const std::vector<PropertyPtr>* properties : { &frameData._particleProperties, &frameData._bondProperties, &frameData._voxelProperties }) {
+		stream << (qint32)properties->size();
+		for(const PropertyPtr& property : *properties) {
+			PropertyRecord record{ property->type(), property->name(), property->dataType(), property->componentCount(), property->stride(),
+				property->componentNames(), property->size(), dataOffset };
+			stream << record;
+			auto typeList = frameData._typeLists.find(property.get());
+			if(typeList != frameData._typeLists.end()) {
+				stream << (qint32)typeList->second->types().size();
+				for(const auto& type : typeList->second->types())
+					stream << type.id << type.name << type.color.r() << type.color.g() << type.color.b() << type.radius;
+			}
+			else {
+				stream << (qint32)-1;
+			}
+			arrays.emplace_back(property.get(), dataOffset);
+			dataOffset = alignOffset(dataOffset + property->size() * property->stride());
+		}
+	}
+	if(stream.status() != QDataStream::Ok)
+		return;
+
+	// Write the property arrays.
+	qint64 dataStart = alignOffset(file.pos());
+	for(const auto& entry : arrays) {
+		const PropertyStorage* property = entry.first;
+		qint64 bytes = property->size() * property->stride();
+		if(bytes == 0)
+			continue;
+		if(!file.seek(dataStart + entry.second) || file.write(static_cast<const char*>(property->constData()), bytes) != bytes)
+			return;
+	}
+
+	if(file.commit())
+		parsedFrameCache().trim();
+}
+
+OVITO_END_INLINE_NAMESPACE
+}	// End of namespace
+}	// End of namespace
@@ -0,0 +1,92 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (2018) Alexander Stukowski
+//
+//  This file is part of OVITO (Open Visualization Tool).
+//
+//  OVITO is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  OVITO is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+
+#include <plugins/particles/Particles.h>
+#include "ParticleFrameData.h"
+
+namespace Ovito { namespace Particles { OVITO_BEGIN_INLINE_NAMESPACE(Import)
+
+/**
+ * \brief On-disk cache of parsed animation frames.
+ *
+ * Stores the contents of a ParticleFrameData in a binary file in the user's cache directory,
+ * from where it can be loaded much faster than by parsing the original text file again.
+ * The metadata of the frame (cell, attributes, type lists, property layouts) is written
+ * to a header, followed by the raw memory of each property array. The arrays start at page-aligned
+ * offsets. When loading an entry, the file is mapped into memory and the property storages of the
+ * frame reference the mapped arrays without copying them.
+ *
+ * An entry is identified by the path of the source file, the byte offset of the frame in the file,
+ * and a key describing the parser and its settings. The size and modification time of the source
+ * file are checked before an entry is used.
+ *
+ * The total size of the cache directory is limited by an application setting. When a new entry
+ * pushes it over the limit, the least recently used entries are deleted.
+ */
+class OVITO_PARTICLES_EXPORT ParticleFrameCache
+{
+public:
+
+	/// Constructor. The parser key identifies the file parser and all of its settings that affect the loaded data.
+	ParticleFrameCache(const QString& filename, qint64 byteOffset, const QByteArray& parserKey);
+
+	/// Returns whether frames of the source file can be cached.
+	bool isValid() const { return !_cacheFilePath.isEmpty(); }
+
+	/// Returns the path of the cache file.
+	const QString& cacheFilePath() const { return _cacheFilePath; }
+
+	/// Loads the frame data from the cache. Returns null if there is no valid cache entry for the frame.
+	std::shared_ptr<ParticleFrameData> load() const;
+
+	/// Writes the frame data to the cache. Failures are silently ignored, because the cache only serves to speed up later loads.
+	void store(const ParticleFrameData& frameData) const;
+
+	/// Deletes all entries from the cache.
+	static void clear();
+
+private:
+
+	/// The source file.
+	QString _filename;
+
+	/// The size of the source file in bytes.
+	qint64 _fileSize = 0;
+
+	/// The modification time of the source file in milliseconds since the epoch.
+	qint64 _lastModified = 0;
+
+	/// The byte offset of the frame in the source file.
+	qint64 _byteOffset;
+
+	/// Identifies the parser and its settings.
+	QByteArray _parserKey;
+
+	/// The location of the cache file.
+	QString _cacheFilePath;
+};
+
+OVITO_END_INLINE_NAMESPACE
+}	// End of namespace
+}	// End of namespace
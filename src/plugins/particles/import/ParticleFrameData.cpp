@@ -114,6 +114,19 @@ void ParticleFrameData::generateBondPeriodicImageProperty()
 	}
 }
 
+/******************************************************************************
+* Returns the number of bytes occupied by the loaded properties.
+******************************************************************************/
+size_t ParticleFrameData::memoryUsage() const
+{
+	size_t bytes = 0;
+	for(const auto* properties : { &_particleProperties, &_bondProperties, &_voxelProperties }) {
+		for(const PropertyPtr& property : *properties)
+			bytes += property->ownedMemorySize();
+	}
+	return bytes;
+}
+
 /******************************************************************************
 * Inserts the loaded data into the provided pipeline state structure.
 * This function is called by the system from the main thread after the
@@ -146,6 +146,9 @@ public:
 	/// called by the system from the main thread after the asynchronous loading task has finished.
 	virtual OORef<DataCollection> handOver(const DataCollection* existing, bool isNewFile, FileSource* fileSource) override;
 
+	/// Returns the number of bytes of heap memory occupied by the particle, bond and voxel properties.
+	virtual size_t memoryUsage() const override;
+
 	/// Returns the current simulation cell matrix.
 	const SimulationCell& simulationCell() const { return _simulationCell; }
 
@@ -294,6 +297,8 @@ private:
 
 	/// Flag that is set by the parser to indicate that the input file contains more than one frame.
 	bool _detectedAdditionalFrames = false;
+
+	friend class ParticleFrameCache;
 };
 
 OVITO_END_INLINE_NAMESPACE
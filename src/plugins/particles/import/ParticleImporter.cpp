@@ -22,13 +22,17 @@
 #include <plugins/particles/Particles.h>
 #include "ParticleImporter.h"
 
+#include <typeinfo>
+
 namespace Ovito { namespace Particles { OVITO_BEGIN_INLINE_NAMESPACE(Import)
 
 IMPLEMENT_OVITO_CLASS(ParticleImporter);	
 DEFINE_PROPERTY_FIELD(ParticleImporter, isMultiTimestepFile);
 DEFINE_PROPERTY_FIELD(ParticleImporter, sortParticles);
+DEFINE_PROPERTY_FIELD(ParticleImporter, cacheParsedFrames);
 SET_PROPERTY_FIELD_LABEL(ParticleImporter, isMultiTimestepFile, "File contains multiple timesteps");
 SET_PROPERTY_FIELD_LABEL(ParticleImporter, sortParticles, "Sort particles by ID");
+SET_PROPERTY_FIELD_LABEL(ParticleImporter, cacheParsedFrames, "Cache parsed frames on disk");
 
 /******************************************************************************
 * Is called when the value of a property of this object has changed.
@@ -46,6 +50,38 @@ void ParticleImporter::propertyChanged(const PropertyFieldDescriptor& field)
 	FileSourceImporter::propertyChanged(field);
 }
 
+/******************************************************************************
+* Returns the cache entry for the frame.
+******************************************************************************/
+ParticleFrameCache ParticleImporter::CachingFrameLoader::frameCache() const
+{
+	QByteArray key = QByteArray(typeid(*this).name()) + '\0' + _frameCacheKey;
+	return ParticleFrameCache(localFilename(), frame().byteOffset, key);
+}
+
+/******************************************************************************
+* Returns the frame data from the parsed frame cache.
+******************************************************************************/
+FileSourceImporter::FrameDataPtr ParticleImporter::CachingFrameLoader::loadFromCache()
+{
+	// Only local files are cached, not the temporary copies of remote files.
+	if(!_useFrameCache || !frame().sourceFile.isLocalFile())
+		return {};
+	setProgressText(tr("Loading cached frame of %1").arg(frame().sourceFile.toString(QUrl::RemovePassword | QUrl::PreferLocalFile | QUrl::PrettyDecoded)));
+	return frameCache().load();
+}
+
+/******************************************************************************
+* Writes the parsed frame data to the cache.
+******************************************************************************/
+void ParticleImporter::CachingFrameLoader::storeInCache(const FrameDataPtr& frameData)
+{
+	if(!_useFrameCache || !frame().sourceFile.isLocalFile())
+		return;
+	if(const ParticleFrameData* particleData = dynamic_cast<const ParticleFrameData*>(frameData.get()))
+		frameCache().store(*particleData);
+}
+
 OVITO_END_INLINE_NAMESPACE
 }	// End of namespace
 }	// End of namespace
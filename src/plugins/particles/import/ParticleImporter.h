@@ -24,6 +24,7 @@
 
 #include <plugins/particles/Particles.h>
 #include <core/dataset/io/FileSourceImporter.h>
+#include "ParticleFrameCache.h"
 
 namespace Ovito { namespace Particles { OVITO_BEGIN_INLINE_NAMESPACE(Import)
 
@@ -37,9 +38,12 @@ class OVITO_PARTICLES_EXPORT ParticleImporter : public FileSourceImporter
 	
 public:
 
+	/// The largest particle count that the file parsers accept. Larger values in a file header are considered corrupt data.
+	static constexpr qlonglong MaxParticleCount = 100'000'000'000ll;
+
 	/// \brief Constructs a new instance of this class.
 	ParticleImporter(DataSet* dataset) : FileSourceImporter(dataset), 
-		_isMultiTimestepFile(false), _sortParticles(false) {}
+		_isMultiTimestepFile(false), _sortParticles(false), _cacheParsedFrames(false) {}
 
 	/// This method indicates whether a wildcard pattern should be automatically generated
 	/// when the user picks a new input filename.
@@ -47,6 +51,40 @@ public:
 
 protected:
 
+	/**
+	 * Base class for frame loaders of text-based formats, which can keep the parsed data in a ParticleFrameCache.
+	 */
+	class OVITO_PARTICLES_EXPORT CachingFrameLoader : public FileSourceImporter::FrameLoader
+	{
+	public:
+
+		/// Inherit constructor from base class.
+		using FileSourceImporter::FrameLoader::FrameLoader;
+
+		/// Lets the loader look up the frame in the parsed frame cache before parsing the file, and store it there afterwards.
+		/// The given key must capture all parser settings that affect the loaded data.
+		void enableFrameCache(const QByteArray& parserSettings) { _frameCacheKey = parserSettings; _useFrameCache = true; }
+
+	protected:
+
+		/// Returns the frame data from the parsed frame cache.
+		virtual FrameDataPtr loadFromCache() override;
+
+		/// Writes the parsed frame data to the cache.
+		virtual void storeInCache(const FrameDataPtr& frameData) override;
+
+	private:
+
+		/// Returns the cache entry for the frame.
+		ParticleFrameCache frameCache() const;
+
+		/// Indicates that the parsed frame cache is used.
+		bool _useFrameCache = false;
+
+		/// Identifies the parser settings.
+		QByteArray _frameCacheKey;
+	};
+
 	/// \brief Is called when the value of a property of this object has changed.
 	virtual void propertyChanged(const PropertyFieldDescriptor& field) override;
 
@@ -62,6 +100,9 @@ private:
 
 	/// Request sorting of the input particle with respect to IDs.
 	DECLARE_MODIFIABLE_PROPERTY_FIELD(bool, sortParticles, setSortParticles);
+
+	/// Keeps parsed frames in a binary cache on disk, from where they are loaded on subsequent reads of the same file.
+	DECLARE_MODIFIABLE_PROPERTY_FIELD(bool, cacheParsedFrames, setCacheParsedFrames);
 };
 
 OVITO_END_INLINE_NAMESPACE
@@ -113,7 +113,7 @@ void CFGHeader::parse(CompressedTextReader& stream)
 		string value = line.substr(valuestart);
 
 		if(key == "Number of particles") {
-			if(sscanf(value.c_str(), "%lld", &numParticles) != 1 || numParticles < 0 || numParticles > 100'000'000'000ll)
+			if(sscanf(value.c_str(), "%lld", &numParticles) != 1 || numParticles < 0 || numParticles > ParticleImporter::MaxParticleCount)
 				throw Exception(CFGImporter::tr("CFG file parsing error. Invalid number of atoms (line %1): %2").arg(stream.lineNumber()).arg(QString::fromStdString(value)));
 		}
 		else if(key == "A") unitMultiplier = atof(value.c_str());
@@ -228,7 +228,38 @@ FileSourceImporter::FrameDataPtr CFGImporter::FrameLoader::loadFile(QFile& file)
 
 	// Read per-particle data.
 	bool isFirstLine = true;
-	for(size_t particleIndex = 0; particleIndex < header.numParticles; ) {
+	size_t particleIndex = 0;
+	if(!header.isExtendedFormat && header.numParticles != 0) {
+		// The standard format contains one particle per line. The first data line has already been read by the header parser.
+		try {
+			columnParser.readParticle(0, stream.line());
+		}
+		catch(Exception& ex) {
+			throw ex.prependGeneralMessage(tr("Parsing error in line %1 of CFG file.").arg(stream.lineNumber()));
+		}
+		particleIndex = 1;
+		isFirstLine = false;
+
+		// If possible, use memory-mapped file access and parse the remaining lines using all processor cores.
+		const char* s_start;
+		const char* s_end;
+		std::tie(s_start, s_end) = stream.mmap();
+		if(s_start) {
+			qint64 lineNumber = stream.lineNumber() + 1;
+			const char* s;
+			try {
+				s = columnParser.readParticles(1, header.numParticles - 1, s_start, s_end, *this, lineNumber);
+			}
+			catch(Exception& ex) {
+				throw ex.prependGeneralMessage(tr("Parsing error in line %1 of CFG file.").arg(lineNumber));
+			}
+			if(!s) return {};
+			stream.munmap();
+			stream.seek(stream.byteOffset() + (s - s_start));
+			particleIndex = header.numParticles;
+		}
+	}
+	while(particleIndex < header.numParticles) {
 
 		// Update progress indicator.
 		if(!setProgressValueIntermittent(particleIndex)) 
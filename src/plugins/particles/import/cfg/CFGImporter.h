@@ -65,19 +65,22 @@ public:
 	/// Creates an asynchronous loader object that loads the data for the given frame from the external file.
 	virtual std::shared_ptr<FileSourceImporter::FrameLoader> createFrameLoader(const Frame& frame, const QString& localFilename) override {
 		activateCLocale();
-		return std::make_shared<FrameLoader>(frame, localFilename, sortParticles());
+		auto loader = std::make_shared<FrameLoader>(frame, localFilename, sortParticles());
+		if(cacheParsedFrames())
+			loader->enableFrameCache(QByteArray::number(sortParticles()));
+		return loader;
 	}
 
 private:
 
 	/// The format-specific task object that is responsible for reading an input file in the background.
-	class FrameLoader : public FileSourceImporter::FrameLoader
+	class FrameLoader : public ParticleImporter::CachingFrameLoader
 	{
 	public:
 
 		/// Constructor.
 		FrameLoader(const FileSourceImporter::Frame& frame, const QString& filename, bool sortParticles)
-		  : FileSourceImporter::FrameLoader(frame, filename), _sortParticles(sortParticles) {}
+		  : ParticleImporter::CachingFrameLoader(frame, filename), _sortParticles(sortParticles) {}
 
 	protected:
 
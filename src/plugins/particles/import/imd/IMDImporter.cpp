@@ -146,7 +146,7 @@ FileSourceImporter::FrameDataPtr IMDImporter::FrameLoader::loadFile(QFile& file)
 
 	// Save file position.
 	qint64 headerOffset = stream.byteOffset();
-	int headerLineNumber = stream.lineNumber();
+	qint64 headerLineNumber = stream.lineNumber();
 
 	// Count the number of atoms (=lines) in the input file.
 	size_t numAtoms = 0;
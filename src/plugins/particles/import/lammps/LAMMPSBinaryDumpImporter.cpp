@@ -96,10 +96,8 @@ struct LAMMPSBinaryDumpHeader
 			return qFromBigEndian(val);
 	}
 
-	// Parses a "big" LAMMPS integer (may be 32 or 64 bit, depending on currently selected data type);
-	// We downcast the result value to 32-bit int, because OVITO currently supports only 2^31 atoms anyway.
-	// A return value of -1 indicates a number overflow.
-	int readBigInt(QIODevice& input) {
+	// Parses a "big" LAMMPS integer (may be 32 or 64 bit, depending on currently selected data type).
+	qint64 readBigInt(QIODevice& input) {
 		if(dataType == LAMMPS_SMALLSMALL) {
 			return parseInt(input);
 		}
@@ -110,10 +108,7 @@ struct LAMMPSBinaryDumpHeader
 				val = qFromLittleEndian(val);
 			else
 				val = qFromBigEndian(val);
-			if(val > (qint64)std::numeric_limits<int>::max())
-				return -1;
-			else
-				return val;
+			return val;
 		}
 	}
 
@@ -249,11 +244,12 @@ bool LAMMPSBinaryDumpHeader::parse(QIODevice& input)
 			dataType = (LAMMPSDataType)dataTypeIndex;
 			input.seek(headerPos);
 
-			ntimestep = readBigInt(input);
-			if(ntimestep < 0 || input.atEnd()) continue;
+			qint64 timestep = readBigInt(input);
+			if(timestep < 0 || timestep > std::numeric_limits<int>::max() || input.atEnd()) continue;
+			ntimestep = (int)timestep;
 
 			natoms = readBigInt(input);
-			if(natoms < 0 || input.atEnd()) continue;
+			if(natoms < 0 || natoms > ParticleImporter::MaxParticleCount || input.atEnd()) continue;
 
 			qint64 startPos = input.pos();
 
@@ -376,7 +372,7 @@ FileSourceImporter::FrameDataPtr LAMMPSBinaryDumpImporter::FrameLoader::loadFile
 	InputColumnReader columnParser(_columnMapping, *frameData, header.natoms);
 	try {
 		QVector<double> chunkData;
-		int i = 0;
+		size_t i = 0;
 		for(int chunki = 0; chunki < header.nchunk; chunki++) {
 
 			// Read chunk size.
@@ -97,9 +97,13 @@ void LAMMPSTextDumpImporter::FrameFinder::discoverFramesInFile(QFile& file, cons
 	QString filename = fileInfo.fileName();
 	QDateTime lastModified = fileInfo.lastModified();
 
+	// Skip the frames that have already been found by an earlier scan.
+	if(scanStartOffset() != 0)
+		stream.seek(scanStartOffset(), scanStartLineNumber());
+
 	while(!stream.eof() && !isCanceled()) {
 		qint64 byteOffset = stream.byteOffset();
-		int lineNumber = stream.lineNumber();
+		qint64 lineNumber = stream.lineNumber();
 
 		// Parse next line.
 		stream.readLine();
@@ -120,7 +124,7 @@ void LAMMPSTextDumpImporter::FrameFinder::discoverFramesInFile(QFile& file, cons
 			else if(stream.lineStartsWith("ITEM: NUMBER OF ATOMS")) {
 				// Parse number of atoms.
 				unsigned long long u;
-				if(sscanf(stream.readLine(), "%llu", &u) != 1 || u > 100'000'000'000ll)
+				if(sscanf(stream.readLine(), "%llu", &u) != 1 || u > (unsigned long long)ParticleImporter::MaxParticleCount)
 					throw Exception(tr("LAMMPS dump file parsing error. Invalid number of atoms in line %1:\n%2").arg(stream.lineNumber()).arg(stream.lineString()));
 				numParticles = (size_t)u;
 				break;
@@ -185,10 +189,8 @@ FileSourceImporter::FrameDataPtr LAMMPSTextDumpImporter::FrameLoader::loadFile(Q
 		else if(stream.lineStartsWith("ITEM: NUMBER OF ATOMS")) {
 			// Parse number of atoms.
 			unsigned long long u;
-			if(sscanf(stream.readLine(), "%llu", &u) != 1)
+			if(sscanf(stream.readLine(), "%llu", &u) != 1 || u > (unsigned long long)ParticleImporter::MaxParticleCount)
 				throw Exception(tr("LAMMPS dump file parsing error. Invalid number of atoms in line %1:\n%2").arg(stream.lineNumber()).arg(stream.lineString()));
-			if(u >= 2147483648ull)
-				throw Exception(tr("LAMMPS dump file parsing error. Number of atoms in line %1 exceeds internal limit of 2^31 atoms:\n%2").arg(stream.lineNumber()).arg(stream.lineString()));
 
 			numParticles = (size_t)u;
 			setProgressMaximum(u);
@@ -276,14 +278,18 @@ FileSourceImporter::FrameDataPtr LAMMPSTextDumpImporter::FrameLoader::loadFile(Q
 			const char* s_end;
 			std::tie(s_start, s_end) = stream.mmap();
 			auto s = s_start;
-			int lineNumber = stream.lineNumber() + 1;
+			qint64 lineNumber = stream.lineNumber() + 1;
 			try {
-				for(size_t i = 0; i < numParticles; i++, lineNumber++) {
-					if(!setProgressValueIntermittent(i)) return {};
-					if(!s)
+				if(s) {
+					// Parse the memory-mapped ATOMS section using all processor cores.
+					s = columnParser.readParticles(0, numParticles, s, s_end, *this, lineNumber);
+					if(!s) return {};
+				}
+				else {
+					for(size_t i = 0; i < numParticles; i++, lineNumber++) {
+						if(!setProgressValueIntermittent(i)) return {};
 						columnParser.readParticle(i, stream.readLine());
-					else
-						s = columnParser.readParticle(i, s, s_end);
+					}
 				}
 			}
 			catch(Exception& ex) {
@@ -74,7 +74,10 @@ public:
 	/// Creates an asynchronous loader object that loads the data for the given frame from the external file.
 	virtual std::shared_ptr<FileSourceImporter::FrameLoader> createFrameLoader(const Frame& frame, const QString& localFilename) override {
 		activateCLocale();
-		return std::make_shared<FrameLoader>(frame, localFilename, sortParticles(), useCustomColumnMapping(), customColumnMapping());
+		auto loader = std::make_shared<FrameLoader>(frame, localFilename, sortParticles(), useCustomColumnMapping(), customColumnMapping());
+		if(cacheParsedFrames())
+			loader->enableFrameCache(customColumnMapping().toByteArray() + QByteArray::number(sortParticles()) + QByteArray::number(useCustomColumnMapping()));
+		return loader;
 	}
 
 	/// Creates an asynchronous loader object that loads the data for the given frame from the external file.
@@ -115,7 +118,7 @@ private:
 	};
 
 	/// The format-specific task object that is responsible for reading an input file in the background.
-	class OVITO_PARTICLES_EXPORT FrameLoader : public FileSourceImporter::FrameLoader
+	class OVITO_PARTICLES_EXPORT FrameLoader : public ParticleImporter::CachingFrameLoader
 	{
 	public:
 
@@ -123,7 +126,7 @@ private:
 		FrameLoader(const FileSourceImporter::Frame& frame, const QString& filename,
 				bool sortParticles,
 				bool useCustomColumnMapping, const InputColumnMapping& customColumnMapping)
-			: FileSourceImporter::FrameLoader(frame, filename), 
+			: ParticleImporter::CachingFrameLoader(frame, filename), 
 				_parseFileHeaderOnly(false),
 				_sortParticles(sortParticles), 
 				_useCustomColumnMapping(useCustomColumnMapping), 
@@ -131,7 +134,7 @@ private:
 
 		/// Constructor used when reading only the file header information.
 		FrameLoader(const FileSourceImporter::Frame& frame, const QString& filename)
-			: FileSourceImporter::FrameLoader(frame, filename), 
+			: ParticleImporter::CachingFrameLoader(frame, filename), 
 				_parseFileHeaderOnly(true), 
 				_useCustomColumnMapping(false) {}
 
@@ -163,6 +166,9 @@ private:
 
 		/// Scans the given file for source frames.
 		virtual void discoverFramesInFile(QFile& file, const QUrl& sourceUrl, QVector<FileSourceImporter::Frame>& frames) override;	
+
+		/// Indicates that the scan can be continued at the beginning of a frame.
+		virtual bool canResumeScan() const override { return true; }
 	};
 
 protected:
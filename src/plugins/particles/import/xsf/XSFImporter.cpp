@@ -241,7 +241,7 @@ FileSourceImporter::FrameDataPtr XSFImporter::FrameLoader::loadFile(QFile& file)
 			size_t natoms = (size_t)u;
 
 			qint64 atomsListOffset = stream.byteOffset();
-			int atomsLineNumber = stream.lineNumber();
+			qint64 atomsLineNumber = stream.lineNumber();
 
 			// Detect number of columns.
 			Point3 pos;
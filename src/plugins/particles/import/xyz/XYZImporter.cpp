@@ -124,7 +124,7 @@ void XYZImporter::FrameFinder::discoverFramesInFile(QFile& file, const QUrl& sou
 
 	while(!stream.eof() && !isCanceled()) {
 		qint64 byteOffset = stream.byteOffset();
-		int lineNumber = stream.lineNumber();
+		qint64 lineNumber = stream.lineNumber();
 
 		// Parse number of atoms.
 		stream.readLine();
@@ -263,8 +263,8 @@ FileSourceImporter::FrameDataPtr XYZImporter::FrameLoader::loadFile(QFile& file)
 		if(!isspace(*p))
 			throw Exception(tr("Parsing error in line %1 of XYZ file. According to the XYZ format specification, the first line should contain the number of particles. This is not a valid integer number of particles:\n\n\"%2\"").arg(stream.lineNumber()).arg(stream.lineString().trimmed()));
 	}
-	if(numParticlesLong > (unsigned long long)std::numeric_limits<int>::max())
-		throw Exception(tr("Too many particles in XYZ file. This program version can read XYZ file with up to %1 particles only.").arg(std::numeric_limits<int>::max()));
+	if(numParticlesLong > (unsigned long long)ParticleImporter::MaxParticleCount)
+		throw Exception(tr("Invalid number of particles in line %1 of XYZ file: %2").arg(stream.lineNumber()).arg(stream.lineString().trimmed()));
 		
 	setProgressMaximum(numParticlesLong);
 	QString fileExcerpt = stream.lineString();
@@ -496,15 +496,35 @@ FileSourceImporter::FrameDataPtr XYZImporter::FrameLoader::loadFile(QFile& file)
 
 	// Parse data columns.
 	InputColumnReader columnParser(_columnMapping, *frameData, numParticlesLong);
-	try {
-		for(size_t i = 0; i < numParticlesLong; i++) {
-			if(!setProgressValueIntermittent(i)) return {};
-			stream.readLine();
-			columnParser.readParticle(i, stream.line());
+
+	// If possible, use memory-mapped file access and parse the data lines using all processor cores.
+	const char* s_start;
+	const char* s_end;
+	std::tie(s_start, s_end) = stream.mmap();
+	if(s_start) {
+		qint64 lineNumber = stream.lineNumber() + 1;
+		const char* s;
+		try {
+			s = columnParser.readParticles(0, numParticlesLong, s_start, s_end, *this, lineNumber);
+		}
+		catch(Exception& ex) {
+			throw ex.prependGeneralMessage(tr("Parsing error in line %1 of XYZ file.").arg(lineNumber));
 		}
+		if(!s) return {};
+		stream.munmap();
+		stream.seek(stream.byteOffset() + (s - s_start));
 	}
-	catch(Exception& ex) {
-		throw ex.prependGeneralMessage(tr("Parsing error in line %1 of XYZ file.").arg(stream.lineNumber()));
+	else {
+		try {
+			for(size_t i = 0; i < numParticlesLong; i++) {
+				if(!setProgressValueIntermittent(i)) return {};
+				stream.readLine();
+				columnParser.readParticle(i, stream.line());
+			}
+		}
+		catch(Exception& ex) {
+			throw ex.prependGeneralMessage(tr("Parsing error in line %1 of XYZ file.").arg(stream.lineNumber()));
+		}
 	}
 
 	// Since we created particle types on the go while reading the particles, the assigned particle type IDs
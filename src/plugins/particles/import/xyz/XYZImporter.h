@@ -77,7 +77,10 @@ public:
 	/// Creates an asynchronous loader object that loads the data for the given frame from the external file.
 	virtual std::shared_ptr<FileSourceImporter::FrameLoader> createFrameLoader(const Frame& frame, const QString& localFilename) override {
 		activateCLocale();
-		return std::make_shared<FrameLoader>(frame, localFilename, sortParticles(), columnMapping(), autoRescaleCoordinates());
+		auto loader = std::make_shared<FrameLoader>(frame, localFilename, sortParticles(), columnMapping(), autoRescaleCoordinates());
+		if(cacheParsedFrames())
+			loader->enableFrameCache(columnMapping().toByteArray() + QByteArray::number(sortParticles()) + QByteArray::number(autoRescaleCoordinates()));
+		return loader;
 	}
 
 	/// Creates an asynchronous frame discovery object that scans the input file for contained animation frames.
@@ -110,13 +113,13 @@ private:
 	};
 
 	/// The format-specific task object that is responsible for reading an input file in the background.
-	class FrameLoader : public FileSourceImporter::FrameLoader
+	class FrameLoader : public ParticleImporter::CachingFrameLoader
 	{
 	public:
 
 		/// Normal constructor.
 		FrameLoader(const FileSourceImporter::Frame& frame, const QString& filename, bool sortParticles, const InputColumnMapping& columnMapping, bool autoRescaleCoordinates)
-		  : FileSourceImporter::FrameLoader(frame, filename), 
+		  : ParticleImporter::CachingFrameLoader(frame, filename), 
 		  	_parseFileHeaderOnly(false), 
 			_sortParticles(sortParticles), 
 			_columnMapping(columnMapping), 
@@ -124,7 +127,7 @@ private:
 
 		/// Constructor used when reading only the file header information.
 		FrameLoader(const FileSourceImporter::Frame& frame, const QString& filename)
-		  : FileSourceImporter::FrameLoader(frame, filename), _parseFileHeaderOnly(true) {}
+		  : ParticleImporter::CachingFrameLoader(frame, filename), _parseFileHeaderOnly(true) {}
 
 	protected:
 
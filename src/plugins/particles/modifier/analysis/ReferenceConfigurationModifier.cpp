@@ -25,6 +25,7 @@
 #include <core/dataset/io/FileSource.h>
 #include <core/dataset/pipeline/ModifierApplication.h>
 #include <core/dataset/animation/AnimationSettings.h>
+#include <core/utilities/concurrent/ParallelFor.h>
 #include "ReferenceConfigurationModifier.h"
 
 namespace Ovito { namespace Particles { OVITO_BEGIN_INLINE_NAMESPACE(Modifiers) OVITO_BEGIN_INLINE_NAMESPACE(Analysis)
@@ -156,7 +157,17 @@ Future<AsynchronousModifier::ComputeEnginePtr> ReferenceConfigurationModifier::c
 		}
 
 		// Let subclass create the compute engine. 
-		return createEngineWithReference(time, modApp, std::move(input), referenceInput, validityInterval);
+		Future<ComputeEnginePtr> engineFuture = createEngineWithReference(time, modApp, std::move(input), referenceInput, validityInterval);
+
+		// Give the engine access to the identifier map of the reference configuration cached in the ModifierApplication.
+		ReferenceConfigurationModifierApplication* myModApp = dynamic_object_cast<ReferenceConfigurationModifierApplication>(modApp);
+		if(!myModApp)
+			return engineFuture;
+		return engineFuture.then([cache = myModApp->referenceIdentifierMapCache()](ComputeEnginePtr engine) {
+			if(RefConfigEngineBase* refConfigEngine = dynamic_cast<RefConfigEngineBase*>(engine.get()))
+				refConfigEngine->setReferenceIdentifierMapCache(cache);
+			return engine;
+		});
 	});
 }
 
@@ -221,57 +232,60 @@ bool ReferenceConfigurationModifier::RefConfigEngineBase::buildParticleMapping(b
 		OVITO_ASSERT(identifiers()->size() == positions()->size());
 		OVITO_ASSERT(refIdentifiers()->size() == refPositions()->size());
 
-		// Build map of particle identifiers in reference configuration.
-		std::map<qlonglong, size_t> refMap;
-		size_t index = 0;
-		for(auto id : refIdentifiers()->constInt64Range()) {
-			if(refMap.insert(std::make_pair(id, index)).second == false)
-				throw Exception(tr("Particles with duplicate identifiers detected in reference configuration."));
-			index++;
+		// Look up the map of particle identifiers in the reference configuration in the cache.
+		// It was built by the engine of an earlier frame if it belongs to the same identifier array.
+		std::shared_ptr<const ParticleIdentifierMap> refMap;
+		if(_refIdentifierMapCache) {
+			std::lock_guard<std::mutex> lock(_refIdentifierMapCache->mutex);
+			if(_refIdentifierMapCache->map && _refIdentifierMapCache->map->identifiers() == refIdentifiers())
+				refMap = _refIdentifierMapCache->map;
+		}
+		if(!refMap) {
+			auto newMap = std::make_shared<ParticleIdentifierMap>();
+			if(!newMap->build(refIdentifiers(), *task()))
+				return false;
+			refMap = std::move(newMap);
+			if(_refIdentifierMapCache) {
+				std::lock_guard<std::mutex> lock(_refIdentifierMapCache->mutex);
+				_refIdentifierMapCache->map = refMap;
+			}
 		}
+		if(refMap->hasDuplicates())
+			throw Exception(tr("Particles with duplicate identifiers detected in reference configuration."));
 
-		if(task()->isCanceled())
+		// Build map of particle identifiers in current configuration.
+		ParticleIdentifierMap currentMap;
+		if(!currentMap.build(identifiers(), *task()))
 			return false;
+		if(currentMap.hasDuplicates())
+			throw Exception(tr("Particles with duplicate identifiers detected in current configuration."));
 
-		// Check for duplicate identifiers in current configuration
-		std::map<qlonglong, size_t> currentMap;
-		index = 0;
-		for(auto id : identifiers()->constInt64Range()) {
-			if(currentMap.insert(std::make_pair(id, index)).second == false)
-				throw Exception(tr("Particles with duplicate identifiers detected in current configuration."));
-			index++;
-		}
+		// Build index maps. The lowest index of a particle that has no counterpart is recorded
+		// to report the same identifier as a sequential loop would.
+		auto mapIndices = [this](const ParticleIdentifierMap& map, const ConstPropertyPtr& ids, std::vector<size_t>& indexMap, bool requireCompleteMapping) {
+			std::atomic<size_t> firstMissing(std::numeric_limits<size_t>::max());
+			const qlonglong* id = ids->constDataInt64();
+			parallelFor(indexMap.size(), *task(), [&](size_t i) {
+				indexMap[i] = map.find(id[i]);
+				if(indexMap[i] == std::numeric_limits<size_t>::max() && requireCompleteMapping) {
+					size_t current = firstMissing.load(std::memory_order_relaxed);
+					while(i < current && !firstMissing.compare_exchange_weak(current, i, std::memory_order_relaxed)) {}
+				}
+			});
+			return firstMissing.load();
+		};
 
+		size_t missing = mapIndices(*refMap, identifiers(), _currentToRefIndexMap, requireCompleteCurrentToRefMapping);
 		if(task()->isCanceled())
 			return false;
+		if(missing != std::numeric_limits<size_t>::max())
+			throw Exception(tr("Particle ID %1 does exist in the current configuration but not in the reference configuration.").arg(identifiers()->getInt64(missing)));
 
-		// Build index maps.
-		auto id = identifiers()->constDataInt64();
-		for(auto& mappedIndex : _currentToRefIndexMap) {
-			auto iter = refMap.find(*id);
-			if(iter != refMap.end())
-				mappedIndex = iter->second;
-			else if(requireCompleteCurrentToRefMapping)
-				throw Exception(tr("Particle ID %1 does exist in the current configuration but not in the reference configuration.").arg(*id));
-			else
-				mappedIndex = std::numeric_limits<size_t>::max();
-			++id;
-		}
-
+		missing = mapIndices(currentMap, refIdentifiers(), _refToCurrentIndexMap, requireCompleteRefToCurrentMapping);
 		if(task()->isCanceled())
 			return false;
-
-		id = refIdentifiers()->constDataInt64();
-		for(auto& mappedIndex : _refToCurrentIndexMap) {
-			auto iter = currentMap.find(*id);
-			if(iter != currentMap.end())
-				mappedIndex = iter->second;
-			else if(requireCompleteRefToCurrentMapping)
-				throw Exception(tr("Particle ID %1 does exist in the reference configuration but not in the current configuration.").arg(*id));
-			else
-				mappedIndex = std::numeric_limits<size_t>::max();
-			++id;
-		}
+		if(missing != std::numeric_limits<size_t>::max())
+			throw Exception(tr("Particle ID %1 does exist in the reference configuration but not in the current configuration.").arg(refIdentifiers()->getInt64(missing)));
 	}
 	else {
 		// Deformed and reference configuration must contain the same number of particles.
@@ -296,6 +310,8 @@ bool ReferenceConfigurationModifierApplication::referenceEvent(RefTarget* source
 		// Invalidate cached state.
 		_referenceCache.reset();
 		_cacheValidity.setEmpty();
+		std::lock_guard<std::mutex> lock(_identifierMapCache->mutex);
+		_identifierMapCache->map.reset();
 	}
 	return AsynchronousModifierApplication::referenceEvent(source, event);
 }
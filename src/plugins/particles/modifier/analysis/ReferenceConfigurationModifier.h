@@ -24,6 +24,7 @@
 
 #include <plugins/particles/Particles.h>
 #include <plugins/stdobj/simcell/SimulationCell.h>
+#include <plugins/particles/util/ParticleIdentifierMap.h>
 #include <core/dataset/pipeline/AsynchronousModifier.h>
 #include <core/dataset/pipeline/PipelineObject.h>
 #include <core/dataset/pipeline/AsynchronousModifierApplication.h>
@@ -60,6 +61,13 @@ public:
 	};
 	Q_ENUMS(AffineMappingType);
 
+	/// Holds the lookup map for the particle identifiers of the reference configuration, which is
+	/// shared by the compute engines of all frames that use the same reference configuration.
+	struct ReferenceIdentifierMapCache {
+		std::mutex mutex;
+		std::shared_ptr<const ParticleIdentifierMap> map;
+	};
+
 public:
 
 	/// Constructor.
@@ -90,6 +98,7 @@ protected:
 			_refPositions.reset();
 			_identifiers.reset();
 			_refIdentifiers.reset();
+			_refIdentifierMapCache.reset();
 			decltype(_currentToRefIndexMap){}.swap(_currentToRefIndexMap);
 			decltype(_refToCurrentIndexMap){}.swap(_refToCurrentIndexMap);
 			ComputeEngine::cleanup();
@@ -98,6 +107,10 @@ protected:
 		/// Determines the mapping between particles in the reference configuration and
 		/// the current configuration and vice versa.
 		bool buildParticleMapping(bool requireCompleteCurrentToRefMapping, bool requireCompleteRefToCurrentMapping);
+
+		/// Sets the cache from which the identifier map of the reference configuration is taken, if it was built
+		/// for the same identifiers, and where a newly built map is stored.
+		void setReferenceIdentifierMapCache(std::shared_ptr<ReferenceIdentifierMapCache> cache) { _refIdentifierMapCache = std::move(cache); }
 		
 		/// Returns the property storage that contains the input particle positions.
 		const ConstPropertyPtr& positions() const { return _positions; }
@@ -147,6 +160,7 @@ protected:
 		const bool _useMinimumImageConvention;
 		std::vector<size_t> _currentToRefIndexMap;
 		std::vector<size_t> _refToCurrentIndexMap;
+		std::shared_ptr<ReferenceIdentifierMapCache> _refIdentifierMapCache;
 	};
 
 protected:
@@ -198,6 +212,11 @@ public:
 		_referenceCache = std::move(state);
 		_cacheValidity = cacheValidity;
 	}
+
+	/// Returns the cached lookup map for the particle identifiers of the reference configuration.
+	const std::shared_ptr<ReferenceConfigurationModifier::ReferenceIdentifierMapCache>& referenceIdentifierMapCache() const {
+		return _identifierMapCache;
+	}
 	
 protected:
 
@@ -211,6 +230,9 @@ private:
 
 	/// The validity of the cache.
 	TimeInterval _cacheValidity = TimeInterval::empty();
+
+	/// The cached lookup map for the reference particle identifiers, which is filled by the compute engines.
+	std::shared_ptr<ReferenceConfigurationModifier::ReferenceIdentifierMapCache> _identifierMapCache = std::make_shared<ReferenceConfigurationModifier::ReferenceIdentifierMapCache>();
  
 };
 
@@ -94,6 +94,9 @@ public:
 		/// Returns the list of structure types to search for.
 		const QVector<bool>& typesToIdentify() const { return _typesToIdentify; }
 
+		/// Returns the particle ordering fingerprint of the input particles.
+		const ParticleOrderingFingerprint& inputFingerprint() const { return _inputFingerprint; }
+
 		/// Returns the number of identified particles of the given structure type.
 		qlonglong getTypeCount(int typeIndex) const {
 			if(_typeCounts && _typeCounts->size() > typeIndex) return _typeCounts->getInt64(typeIndex);
@@ -21,6 +21,7 @@
 
 #include <plugins/particles/Particles.h>
 #include <plugins/particles/util/NearestNeighborFinder.h>
+#include <plugins/particles/util/NeighborFinderCache.h>
 #include <plugins/particles/objects/ParticlesObject.h>
 #include <core/utilities/concurrent/ParallelFor.h>
 #include <core/utilities/units/UnitsManager.h>
@@ -79,8 +80,8 @@ void CentroSymmetryModifier::CentroSymmetryEngine::perform()
 	task()->setProgressText(tr("Computing centrosymmetry parameters"));
 
 	// Prepare the neighbor list.
-	NearestNeighborFinder neighFinder(_nneighbors);
-	if(!neighFinder.prepare(*positions(), cell(), nullptr, task().get())) {
+	std::shared_ptr<const NearestNeighborFinder> neighFinder = NeighborFinderCache::nearestNeighborFinder(_nneighbors, positions(), cell(), nullptr, task().get());
+	if(!neighFinder) {
 		return;
 	}
 
@@ -88,18 +89,18 @@ void CentroSymmetryModifier::CentroSymmetryEngine::perform()
 	PropertyStorage& output = *csp();
 
 	// Perform analysis on each particle.
-	parallelFor(positions()->size(), *task(), [&neighFinder, &output](size_t index) {
-		output.setFloat(index, computeCSP(neighFinder, index));
+	parallelFor(positions()->size(), *task(), [this, &neighFinder, &output](size_t index) {
+		output.setFloat(index, computeCSP(*neighFinder, _nneighbors, index));
 	});
 }
 
 /******************************************************************************
 * Computes the centrosymmetry parameter of a single particle.
 ******************************************************************************/
-FloatType CentroSymmetryModifier::computeCSP(NearestNeighborFinder& neighFinder, size_t particleIndex)
+FloatType CentroSymmetryModifier::computeCSP(const NearestNeighborFinder& neighFinder, int numNeighbors, size_t particleIndex)
 {
 	// Find k nearest neighbor of current atom.
-	NearestNeighborFinder::Query<MAX_CSP_NEIGHBORS> neighQuery(neighFinder);
+	NearestNeighborFinder::Query<MAX_CSP_NEIGHBORS> neighQuery(neighFinder, numNeighbors);
 	neighQuery.findNeighbors(particleIndex);
 
 	int numNN = neighQuery.results().size();
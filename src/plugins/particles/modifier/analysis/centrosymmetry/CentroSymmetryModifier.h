@@ -69,7 +69,7 @@ protected:
 	virtual Future<ComputeEnginePtr> createEngine(TimePoint time, ModifierApplication* modApp, const PipelineFlowState& input) override;
 		
 	/// Computes the centrosymmetry parameter of a single particle.
-	static FloatType computeCSP(NearestNeighborFinder& neighList, size_t particleIndex);
+	static FloatType computeCSP(const NearestNeighborFinder& neighList, int numNeighbors, size_t particleIndex);
 
 private:
 	
@@ -22,23 +22,50 @@
 #include <plugins/particles/Particles.h>
 #include <plugins/particles/objects/BondsObject.h>
 #include <plugins/particles/objects/ParticlesObject.h>
-#include <plugins/particles/objects/ParticleBondMap.h>
+#include <plugins/particles/util/NeighborFinderCache.h>
 #include <plugins/stdobj/simcell/SimulationCellObject.h>
+#include <plugins/stdobj/series/DataSeriesObject.h>
 #include <core/dataset/pipeline/ModifierApplication.h>
 #include <core/utilities/units/UnitsManager.h>
+#include <core/utilities/concurrent/ParallelFor.h>
 #include "ClusterAnalysisModifier.h"
 
+#include <unordered_map>
+
 namespace Ovito { namespace Particles { OVITO_BEGIN_INLINE_NAMESPACE(Modifiers) OVITO_BEGIN_INLINE_NAMESPACE(Analysis)
 
+namespace {
+	/// Number of particles that form one piece of work when numbering the clusters. The pieces do not
+	/// depend on the number of threads, which keeps the computed centers of mass reproducible.
+	constexpr size_t LabelingChunkSize = 1 << 16;
+
+	/// The sums over the particles of a cluster from which its center of mass is computed.
+	/// The plain sum of the positions is used for clusters without mass.
+	struct CenterOfMassSums {
+		Vector3 weightedPositions = Vector3::Zero();
+		Vector3 positions = Vector3::Zero();
+		FloatType mass = 0;
+
+		CenterOfMassSums& operator+=(const CenterOfMassSums& other) {
+			weightedPositions += other.weightedPositions;
+			positions += other.positions;
+			mass += other.mass;
+			return *this;
+		}
+	};
+}
+
 IMPLEMENT_OVITO_CLASS(ClusterAnalysisModifier);
 DEFINE_PROPERTY_FIELD(ClusterAnalysisModifier, neighborMode);
 DEFINE_PROPERTY_FIELD(ClusterAnalysisModifier, cutoff);
 DEFINE_PROPERTY_FIELD(ClusterAnalysisModifier, onlySelectedParticles);
 DEFINE_PROPERTY_FIELD(ClusterAnalysisModifier, sortBySize);
+DEFINE_PROPERTY_FIELD(ClusterAnalysisModifier, computeCentersOfMass);
 SET_PROPERTY_FIELD_LABEL(ClusterAnalysisModifier, neighborMode, "Neighbor mode");
 SET_PROPERTY_FIELD_LABEL(ClusterAnalysisModifier, cutoff, "Cutoff distance");
 SET_PROPERTY_FIELD_LABEL(ClusterAnalysisModifier, onlySelectedParticles, "Use only selected particles");
 SET_PROPERTY_FIELD_LABEL(ClusterAnalysisModifier, sortBySize, "Sort clusters by size");
+SET_PROPERTY_FIELD_LABEL(ClusterAnalysisModifier, computeCentersOfMass, "Compute centers of mass");
 SET_PROPERTY_FIELD_UNITS_AND_MINIMUM(ClusterAnalysisModifier, cutoff, WorldParameterUnit, 0);
 
 /******************************************************************************
@@ -48,6 +75,7 @@ ClusterAnalysisModifier::ClusterAnalysisModifier(DataSet* dataset) : Asynchronou
 	_cutoff(3.2), 
 	_onlySelectedParticles(false), 
 	_sortBySize(false), 
+	_computeCentersOfMass(false),
 	_neighborMode(CutoffRange)
 {
 }
@@ -77,12 +105,22 @@ Future<AsynchronousModifier::ComputeEnginePtr> ClusterAnalysisModifier::createEn
 	if(onlySelectedParticles())
 		selectionProperty = particles->expectProperty(ParticlesObject::SelectionProperty)->storage();
 
+	// Get particle masses, which weight the particles when computing the centers of mass.
+	ConstPropertyPtr massProperty;
+	if(computeCentersOfMass()) {
+		if(const PropertyObject* massObj = particles->getProperty(ParticlesObject::MassProperty))
+			massProperty = massObj->storage();
+	}
+
 	// Create engine object. Pass all relevant modifier parameters to the engine as well as the input data.
 	if(neighborMode() == CutoffRange) {
-		return std::make_shared<CutoffClusterAnalysisEngine>(particles, posProperty->storage(), inputCell->data(), sortBySize(), std::move(selectionProperty), cutoff());
+		return std::make_shared<CutoffClusterAnalysisEngine>(particles, posProperty->storage(), inputCell->data(), sortBySize(), computeCentersOfMass(), std::move(selectionProperty), std::move(massProperty), cutoff());
 	}
 	else if(neighborMode() == Bonding) {
-		return std::make_shared<BondClusterAnalysisEngine>(particles, posProperty->storage(), inputCell->data(), sortBySize(), std::move(selectionProperty), particles->expectBondsTopology()->storage());
+		const PropertyObject* topologyProperty = particles->expectBondsTopology();
+		const PropertyObject* periodicImagesProperty = particles->bonds()->getProperty(BondsObject::PeriodicImageProperty);
+		return std::make_shared<BondClusterAnalysisEngine>(particles, posProperty->storage(), inputCell->data(), sortBySize(), computeCentersOfMass(), std::move(selectionProperty), std::move(massProperty),
+			topologyProperty->storage(), periodicImagesProperty ? periodicImagesProperty->storage() : nullptr);
 	}
 	else {
 		throwException(tr("Invalid cluster neighbor mode"));
@@ -96,164 +134,313 @@ void ClusterAnalysisModifier::ClusterAnalysisEngine::perform()
 {
 	task()->setProgressText(tr("Performing cluster analysis"));
 
-	// Initialize.
-	std::fill(particleClusters()->dataInt64(), particleClusters()->dataInt64() + particleClusters()->size(), -1);
-	
+	// Initially, every particle forms a cluster of its own.
+	size_t particleCount = positions()->size();
+	_parents.reset(new std::atomic<size_t>[particleCount]);
+	parallelFor(particleCount, [this](size_t index) {
+		_parents[index].store(index, std::memory_order_relaxed);
+	});
+
+	// Remember the edges that join the clusters, from which the clusters get unwrapped for the centers of mass.
+	if(_computeCentersOfMass)
+		_treeEdges.reset(new TreeEdge[particleCount]);
+
 	// Perform the actual clustering.
+	task()->beginProgressSubSteps(_computeCentersOfMass ? 3 : 2);
 	doClustering();
 	if(task()->isCanceled())
 		return;
 
+	// Unwrap the clusters at the periodic boundaries.
+	if(_computeCentersOfMass) {
+		task()->nextProgressSubStep();
+		unwrapClusters();
+		_treeEdges.reset();
+		if(task()->isCanceled())
+			return;
+	}
+
+	// Number the clusters and compute their sizes.
+	task()->nextProgressSubStep();
+	labelClusters();
+	_parents.reset();
+	_images.reset();
+	if(task()->isCanceled())
+		return;
+	task()->endProgressSubSteps();
+
 	// Sort clusters by size.
 	if(_sortBySize && numClusters() != 0) {
 
-		// Determine cluster sizes.
-		std::vector<size_t> clusterSizes(numClusters() + 1, 0);
-		for(auto id : particleClusters()->constInt64Range()) {
-			clusterSizes[id]++;
-		}
-
 		// Sort clusters by size.
-		std::vector<size_t> mapping(numClusters() + 1);
+		const qlonglong* clusterSizes = _clusterSizes->constDataInt64();
+		std::vector<size_t> mapping(numClusters());
 		std::iota(mapping.begin(), mapping.end(), size_t(0));
-		std::sort(mapping.begin() + 1, mapping.end(), [&clusterSizes](size_t a, size_t b) {
+		std::stable_sort(mapping.begin(), mapping.end(), [clusterSizes](size_t a, size_t b) {
 			return clusterSizes[a] > clusterSizes[b];
 		});
-		setLargestClusterSize(clusterSizes[mapping[1]]);
-		clusterSizes.clear();
-		clusterSizes.shrink_to_fit();
+		setLargestClusterSize(clusterSizes[mapping[0]]);
 
 		// Remap cluster IDs.
-		std::vector<size_t> inverseMapping(numClusters() + 1);
-		for(size_t i = 0; i <= numClusters(); i++)
-			inverseMapping[mapping[i]] = i;
-		for(auto& id : particleClusters()->int64Range())
-			id = inverseMapping[id];
+		std::vector<qlonglong> inverseMapping(numClusters() + 1, 0);
+		for(size_t i = 0; i < numClusters(); i++)
+			inverseMapping[mapping[i] + 1] = i + 1;
+		qlonglong* clusters = particleClusters()->dataInt64();
+		parallelFor(particleCount, [clusters, &inverseMapping](size_t index) {
+			clusters[index] = inverseMapping[clusters[index]];
+		});
+
+		// Reorder the per-cluster lists accordingly.
+		auto reorder = [&mapping](const PropertyPtr& list) {
+			PropertyPtr sortedList = std::make_shared<PropertyStorage>(list->size(), list->dataType(), list->componentCount(), list->stride(),
+				list->name(), false, list->type(), list->componentNames());
+			for(size_t i = 0; i < mapping.size(); i++)
+				std::memcpy(static_cast<char*>(sortedList->data()) + i * list->stride(), static_cast<const char*>(list->constData()) + mapping[i] * list->stride(), list->stride());
+			return sortedList;
+		};
+		_clusterSizes = reorder(_clusterSizes);
+		if(_centersOfMass)
+			_centersOfMass = reorder(_centersOfMass);
 	}
 }
 
 /******************************************************************************
-* Performs the actual clustering algorithm.
+* Determines the periodic image of each particle in which its cluster is
+* contiguous, by walking the spanning trees built by the clustering algorithm.
 ******************************************************************************/
-void ClusterAnalysisModifier::CutoffClusterAnalysisEngine::doClustering()
+void ClusterAnalysisModifier::ClusterAnalysisEngine::unwrapClusters()
 {
-	// Prepare the neighbor finder.
-	CutoffNeighborFinder neighborFinder;
-	if(!neighborFinder.prepare(cutoff(), *positions(), cell(), selection().get(), task().get()))
-		return;
-
 	size_t particleCount = positions()->size();
-	task()->setProgressValue(0);
-	task()->setProgressMaximum(particleCount);
-
-	PropertyStorage& particleClusters = *this->particleClusters();
-			
-	std::deque<size_t> toProcess;
-	for(size_t seedParticleIndex = 0; seedParticleIndex < particleCount; seedParticleIndex++) {
 
-		// Skip unselected particles that are not included in the analysis.
-		if(selection() && !selection()->getInt(seedParticleIndex)) {
-			particleClusters.setInt64(seedParticleIndex, 0);
-			continue;
+	// Every particle that is not a root was attached by exactly one edge. Build the lists of edges incident to each particle.
+	std::vector<size_t> edgeOffsets(particleCount + 1, 0);
+	for(size_t index = 0; index < particleCount; index++) {
+		if(_parents[index].load(std::memory_order_relaxed) != index) {
+			edgeOffsets[_treeEdges[index].particle1 + 1]++;
+			edgeOffsets[_treeEdges[index].particle2 + 1]++;
 		}
-
-		// Skip particles that have already been assigned to a cluster.
-		if(particleClusters.getInt64(seedParticleIndex) != -1)
-			continue;
-
-		// Start a new cluster.
-		setNumClusters(numClusters() + 1);
-		qlonglong cluster = numClusters();
-		particleClusters.setInt64(seedParticleIndex, cluster);
-
-		// Now recursively iterate over all neighbors of the seed particle and add them to the cluster too.
-		OVITO_ASSERT(toProcess.empty());
-		toProcess.push_back(seedParticleIndex);
-
-		do {
-			task()->incrementProgressValue();
-			if(task()->isCanceled())
+	}
+	std::partial_sum(edgeOffsets.begin(), edgeOffsets.end(), edgeOffsets.begin());
+	std::vector<size_t> incidentEdges(edgeOffsets.back());
+	std::vector<size_t> insertPositions(edgeOffsets.begin(), edgeOffsets.end() - 1);
+	for(size_t index = 0; index < particleCount; index++) {
+		if(_parents[index].load(std::memory_order_relaxed) != index) {
+			incidentEdges[insertPositions[_treeEdges[index].particle1]++] = index;
+			incidentEdges[insertPositions[_treeEdges[index].particle2]++] = index;
+		}
+	}
+	insertPositions.clear();
+	insertPositions.shrink_to_fit();
+
+	// Walk each tree from its root, which stays in its original periodic image. The images are integer vectors,
+	// which makes them independent of the path through the tree.
+	_images.reset(new Vector3I[particleCount]);
+	parallelForChunks(particleCount, *task(), [&](size_t startIndex, size_t count, PromiseState& promise) {
+		std::vector<std::pair<size_t, size_t>> toProcess;
+		for(size_t root = startIndex, end = startIndex + count; root < end; root++) {
+			if(_parents[root].load(std::memory_order_relaxed) != root)
+				continue;
+			if(promise.isCanceled())
 				return;
-
-			size_t currentParticle = toProcess.front();
-			toProcess.pop_front();
-			for(CutoffNeighborFinder::Query neighQuery(neighborFinder, currentParticle); !neighQuery.atEnd(); neighQuery.next()) {
-				size_t neighborIndex = neighQuery.current();
-				if(particleClusters.getInt64(neighborIndex) == -1) {
-					particleClusters.setInt64(neighborIndex, cluster);
-					toProcess.push_back(neighborIndex);
+			_images[root] = Vector3I::Zero();
+			// Each entry is a particle together with the edge through which it was reached.
+			toProcess.emplace_back(root, particleCount);
+			while(!toProcess.empty()) {
+				size_t current = toProcess.back().first;
+				size_t arrivalEdge = toProcess.back().second;
+				toProcess.pop_back();
+				for(size_t i = edgeOffsets[current]; i < edgeOffsets[current + 1]; i++) {
+					size_t edgeIndex = incidentEdges[i];
+					if(edgeIndex == arrivalEdge)
+						continue;
+					const TreeEdge& edge = _treeEdges[edgeIndex];
+					if(edge.particle1 == current) {
+						_images[edge.particle2] = _images[current] + edge.pbcShift;
+						toProcess.emplace_back(edge.particle2, edgeIndex);
+					}
+					else {
+						_images[edge.particle1] = _images[current] - edge.pbcShift;
+						toProcess.emplace_back(edge.particle1, edgeIndex);
+					}
 				}
 			}
 		}
-		while(toProcess.empty() == false);
-	}
+	});
 }
 
 /******************************************************************************
-* Performs the actual clustering algorithm.
+* Numbers the clusters in the order of their seed particles and computes the
+* per-cluster quantities.
 ******************************************************************************/
-void ClusterAnalysisModifier::BondClusterAnalysisEngine::doClustering()
+void ClusterAnalysisModifier::ClusterAnalysisEngine::labelClusters()
 {
 	size_t particleCount = positions()->size();
-	task()->setProgressValue(0);
-	task()->setProgressMaximum(particleCount);
+	size_t chunkCount = (particleCount + LabelingChunkSize - 1) / LabelingChunkSize;
+	qlonglong* clusters = particleClusters()->dataInt64();
+	const int* selectionData = selection() ? selection()->constDataInt() : nullptr;
+
+	// Let each particle point to the root of its cluster and count the roots in each chunk.
+	std::vector<size_t> rootCounts(chunkCount + 1, 0);
+	if(!parallelFor(chunkCount, *task(), [&](size_t chunk) {
+		size_t count = 0;
+		for(size_t index = chunk * LabelingChunkSize, end = std::min(index + LabelingChunkSize, particleCount); index < end; index++) {
+			if(selectionData && !selectionData[index]) {
+				clusters[index] = -1;
+				continue;
+			}
+			size_t root = findRoot(index);
+			clusters[index] = root;
+			if(root == index)
+				count++;
+		}
+		rootCounts[chunk + 1] = count;
+	}, (size_t)1))
+		return;
 
-	// Prepare particle bond map.
-	ParticleBondMap bondMap(bondTopology());
+	// The clusters are numbered in the order of their roots, which are the seed particles from which the clusters grow.
+	// The parent links of the roots are no longer needed and store the cluster IDs from now on.
+	std::partial_sum(rootCounts.begin(), rootCounts.end(), rootCounts.begin());
+	setNumClusters(rootCounts.back());
+	parallelFor(chunkCount, [&](size_t chunk) {
+		size_t id = rootCounts[chunk];
+		for(size_t index = chunk * LabelingChunkSize, end = std::min(index + LabelingChunkSize, particleCount); index < end; index++) {
+			if(clusters[index] == (qlonglong)index)
+				_parents[index].store(++id, std::memory_order_relaxed);
+		}
+	});
+
+	// Replace the roots with the cluster IDs and sum up the sizes and centers of mass of the clusters.
+	// Each chunk sums up the particles of a cluster in a row before adding them to the totals.
+	// The centers of mass are computed from the unwrapped positions, weighted by the particle masses if available.
+	std::unique_ptr<std::atomic<qlonglong>[]> clusterSizes(new std::atomic<qlonglong>[numClusters() + 1]());
+	std::vector<std::vector<std::pair<size_t, CenterOfMassSums>>> chunkSums(_computeCentersOfMass ? chunkCount : 0);
+	const Point3* positionData = positions()->constDataPoint3();
+	const FloatType* massData = masses() ? masses()->constDataFloat() : nullptr;
+	parallelFor(chunkCount, [&](size_t chunk) {
+		std::unordered_map<size_t, CenterOfMassSums> sums;
+		size_t currentId = 0;
+		qlonglong currentSize = 0;
+		CenterOfMassSums currentSums;
+		auto addCurrentCluster = [&]() {
+			if(currentSize == 0)
+				return;
+			clusterSizes[currentId].fetch_add(currentSize, std::memory_order_relaxed);
+			if(_computeCentersOfMass) {
+				sums[currentId] += currentSums;
+				currentSums = CenterOfMassSums();
+			}
+			currentSize = 0;
+		};
+		for(size_t index = chunk * LabelingChunkSize, end = std::min(index + LabelingChunkSize, particleCount); index < end; index++) {
+			if(clusters[index] < 0) {
+				clusters[index] = 0;
+				continue;
+			}
+			size_t id = _parents[clusters[index]].load(std::memory_order_relaxed);
+			clusters[index] = id;
+			if(id != currentId) {
+				addCurrentCluster();
+				currentId = id;
+			}
+			currentSize++;
+			if(_computeCentersOfMass) {
+				const Vector3I& image = _images[index];
+				Point3 unwrappedPos = positionData[index] + cell().reducedToAbsolute(Vector3(image.x(), image.y(), image.z()));
+				FloatType mass = massData ? massData[index] : FloatType(1);
+				currentSums.weightedPositions += mass * (unwrappedPos - Point3::Origin());
+				currentSums.positions += unwrappedPos - Point3::Origin();
+				currentSums.mass += mass;
+			}
+		}
+		addCurrentCluster();
+		if(_computeCentersOfMass)
+			chunkSums[chunk].assign(sums.begin(), sums.end());
+	});
+
+	_clusterSizes = std::make_shared<PropertyStorage>(numClusters(), PropertyStorage::Int64, 1, 0, tr("Cluster Size"), false, DataSeriesObject::YProperty);
+	for(size_t i = 0; i < numClusters(); i++)
+		_clusterSizes->setInt64(i, clusterSizes[i + 1].load(std::memory_order_relaxed));
+
+	if(_computeCentersOfMass) {
+		// Add up the sums of the chunks in a fixed order, which makes the results independent of the number of threads.
+		std::vector<CenterOfMassSums> totals(numClusters() + 1);
+		for(const auto& sums : chunkSums) {
+			for(const auto& entry : sums)
+				totals[entry.first] += entry.second;
+		}
+		// The centers are wrapped back into the simulation cell along periodic directions.
+		const std::array<bool,3>& pbcFlags = cell().pbcFlags();
+		_centersOfMass = std::make_shared<PropertyStorage>(numClusters(), PropertyStorage::Float, 3, 0, tr("Center of Mass"), false,
+			DataSeriesObject::UserProperty, QStringList() << "X" << "Y" << "Z");
+		for(size_t i = 0; i < numClusters(); i++) {
+			const CenterOfMassSums& sums = totals[i + 1];
+			Point3 center = Point3::Origin() + ((sums.mass != 0) ? (sums.weightedPositions / sums.mass) : (sums.positions / (FloatType)_clusterSizes->getInt64(i)));
+			Point3 reducedCenter = cell().absoluteToReduced(center);
+			for(size_t dim = 0; dim < 3; dim++) {
+				if(pbcFlags[dim])
+					reducedCenter[dim] -= std::floor(reducedCenter[dim]);
+			}
+			_centersOfMass->setPoint3(i, cell().reducedToAbsolute(reducedCenter));
+		}
+	}
+}
 
-	PropertyStorage& particleClusters = *this->particleClusters();
-	
-	std::deque<size_t> toProcess;
-	for(size_t seedParticleIndex = 0; seedParticleIndex < particleCount; seedParticleIndex++) {
+/******************************************************************************
+* Performs the actual clustering algorithm.
+******************************************************************************/
+void ClusterAnalysisModifier::CutoffClusterAnalysisEngine::doClustering()
+{
+	// Prepare the neighbor finder.
+	std::shared_ptr<const CutoffNeighborFinder> neighborFinder = NeighborFinderCache::cutoffNeighborFinder(cutoff(), positions(), cell(), selection(), task().get());
+	if(!neighborFinder)
+		return;
 
+	// Join the clusters of all particle pairs within the cutoff range. Each pair is handled by the particle with the lower index.
+	parallelFor(positions()->size(), *task(), [this, &neighborFinder](size_t index) {
 		// Skip unselected particles that are not included in the analysis.
-		if(selection() && !selection()->getInt(seedParticleIndex)) {
-			particleClusters.setInt64(seedParticleIndex, 0);
-			continue;
+		if(selection() && !selection()->getInt(index))
+			return;
+		for(CutoffNeighborFinder::Query neighQuery(*neighborFinder, index); !neighQuery.atEnd(); neighQuery.next()) {
+			if(neighQuery.current() > index)
+				unite(index, neighQuery.current(), neighQuery.unwrappedPbcShift());
 		}
+	});
+}
 
-		// Skip particles that have already been assigned to a cluster.
-		if(particleClusters.getInt64(seedParticleIndex) != -1)
-			continue;
-
-		// Start a new cluster.
-		setNumClusters(numClusters() + 1);
-		qlonglong cluster = numClusters();
-		particleClusters.setInt64(seedParticleIndex, cluster);
-
-		// Now recursively iterate over all neighbors of the seed particle and add them to the cluster too.
-		OVITO_ASSERT(toProcess.empty());
-		toProcess.push_back(seedParticleIndex);
-
-		do {
-			task()->incrementProgressValue();
-			if(task()->isCanceled())
-				return;
+/******************************************************************************
+* Performs the actual clustering algorithm.
+******************************************************************************/
+void ClusterAnalysisModifier::BondClusterAnalysisEngine::doClustering()
+{
+	size_t particleCount = positions()->size();
 
-			size_t currentParticle = toProcess.front();
-			toProcess.pop_front();
-
-			// Iterate over all bonds of the current particle.
-			for(size_t neighborBondIndex : bondMap.bondIndicesOfParticle(currentParticle)) {
-				OVITO_ASSERT(bondTopology()->getInt64Component(neighborBondIndex, 0) == currentParticle || bondTopology()->getInt64Component(neighborBondIndex, 1) == currentParticle);
-				size_t neighborIndex = bondTopology()->getInt64Component(neighborBondIndex, 0); 
-				if(neighborIndex == currentParticle) neighborIndex = bondTopology()->getInt64Component(neighborBondIndex, 1);
-				if(neighborIndex >= particleCount)
-					continue;
-				if(particleClusters.getInt64(neighborIndex) != -1) 
-					continue;
-				if(selection() && !selection()->getInt(neighborIndex))
-					continue;
-
-				particleClusters.setInt64(neighborIndex, cluster);
-				toProcess.push_back(neighborIndex);
+	// Join the clusters of all pairs of bonded particles.
+	parallelFor(bondTopology()->size(), *task(), [this, particleCount](size_t bondIndex) {
+		size_t index1 = bondTopology()->getInt64Component(bondIndex, 0);
+		size_t index2 = bondTopology()->getInt64Component(bondIndex, 1);
+		if(index1 >= particleCount || index2 >= particleCount)
+			return;
+		// Skip bonds to unselected particles that are not included in the analysis.
+		if(selection() && (!selection()->getInt(index1) || !selection()->getInt(index2)))
+			return;
+		Vector3I pbcShift = Vector3I::Zero();
+		if(_computeCentersOfMass) {
+			if(bondPeriodicImages()) {
+				pbcShift = bondPeriodicImages()->getVector3I(bondIndex);
+			}
+			else {
+				// Without the PBC shift vectors of the bonds, use the minimum image convention.
+				Vector3 reducedDelta = cell().absoluteToReduced(positions()->getPoint3(index2) - positions()->getPoint3(index1));
+				for(size_t dim = 0; dim < 3; dim++) {
+					if(cell().pbcFlags()[dim])
+						pbcShift[dim] = -(int)std::floor(reducedDelta[dim] + FloatType(0.5));
+				}
 			}
 		}
-		while(toProcess.empty() == false);
-	}
+		unite(index1, index2, pbcShift);
+	});
 }
 
-
 /******************************************************************************
 * Injects the computed results of the engine into the data pipeline.
 ******************************************************************************/
@@ -271,6 +458,13 @@ void ClusterAnalysisModifier::ClusterAnalysisEngine::emitResults(TimePoint time,
 	if(modifier->sortBySize())
 		state.addAttribute(QStringLiteral("ClusterAnalysis.largest_size"), QVariant::fromValue(largestClusterSize()), modApp);
 
+	// Output the list of clusters with their sizes and centers of mass.
+	if(centersOfMass()) {
+		DataSeriesObject* seriesObj = state.createObject<DataSeriesObject>(QStringLiteral("clusters"), modApp, DataSeriesObject::None, tr("Cluster list"), clusterSizes());
+		seriesObj->createProperty(centersOfMass());
+		seriesObj->setAxisLabelX(tr("Cluster"));
+	}
+
 	state.setStatus(PipelineStatus(PipelineStatus::Success, tr("Found %n cluster(s).", "", numClusters())));
 }
 
@@ -79,11 +79,13 @@ private:
 	public:
 
 		/// Constructor.
-		ClusterAnalysisEngine(ParticleOrderingFingerprint fingerprint, ConstPropertyPtr positions, const SimulationCell& simCell, bool sortBySize, ConstPropertyPtr selection) :
+		ClusterAnalysisEngine(ParticleOrderingFingerprint fingerprint, ConstPropertyPtr positions, const SimulationCell& simCell, bool sortBySize, bool computeCentersOfMass, ConstPropertyPtr selection, ConstPropertyPtr masses) :
 			_positions(positions), 
 			_simCell(simCell), 
 			_sortBySize(sortBySize),
+			_computeCentersOfMass(computeCentersOfMass),
 			_selection(std::move(selection)),
+			_masses(std::move(masses)),
 			_particleClusters(ParticlesObject::OOClass().createStandardStorage(fingerprint.particleCount(), ParticlesObject::ClusterProperty, false)),
 			_inputFingerprint(std::move(fingerprint)) {}
 
@@ -91,6 +93,7 @@ private:
 		virtual void cleanup() override {
 			_positions.reset();
 			_selection.reset();
+			_masses.reset();
 			ComputeEngine::cleanup();
 		}
 
@@ -114,10 +117,58 @@ private:
 
 		/// Sets the size of the largest cluster.
 		void setLargestClusterSize(size_t size) { _largestClusterSize = size; }
-				
-		/// Performs the actual clustering algorithm.
+
+		/// Returns the number of particles in each cluster.
+		const PropertyPtr& clusterSizes() const { return _clusterSizes; }
+
+		/// Returns the center of mass of each cluster (optional).
+		const PropertyPtr& centersOfMass() const { return _centersOfMass; }
+
+		/// Performs the actual clustering algorithm, which joins the clusters of neighboring particles by calling unite().
+		/// This method is executed by several threads in parallel.
 		virtual void doClustering() = 0;
 
+		/// Merges the clusters containing the two given particles. This method may be called by several threads concurrently.
+		/// The PBC shift vector tells how often the vector from the first to the second particle crosses the periodic boundaries.
+		void unite(size_t particle1, size_t particle2, Vector3I pbcShift = Vector3I::Zero()) {
+			size_t a = particle1;
+			size_t b = particle2;
+			for(;;) {
+				a = findRoot(a);
+				b = findRoot(b);
+				if(a == b)
+					return;
+				// The root with the larger index gets attached to the other one. Thus, the root of every cluster is
+				// its particle with the lowest index, which is the seed particle of the cluster.
+				if(a < b) {
+					std::swap(a, b);
+					std::swap(particle1, particle2);
+					pbcShift = -pbcShift;
+				}
+				size_t expected = a;
+				if(_parents[a].compare_exchange_weak(expected, b, std::memory_order_relaxed)) {
+					// Every root gets attached only once, so the joining edges form a spanning tree of each cluster.
+					if(_treeEdges)
+						_treeEdges[a] = TreeEdge{particle1, particle2, pbcShift};
+					return;
+				}
+			}
+		}
+
+		/// Returns the root particle of the cluster containing the given particle. This method may be called by several threads concurrently.
+		size_t findRoot(size_t a) {
+			for(;;) {
+				size_t parent = _parents[a].load(std::memory_order_relaxed);
+				if(parent == a)
+					return a;
+				// Path halving: let the particle point to its grandparent.
+				size_t grandparent = _parents[parent].load(std::memory_order_relaxed);
+				if(grandparent != parent)
+					_parents[a].compare_exchange_weak(parent, grandparent, std::memory_order_relaxed);
+				a = grandparent;
+			}
+		}
+
 		/// Returns the property storage that contains the input particle positions.
 		const ConstPropertyPtr& positions() const { return _positions; }
 
@@ -127,16 +178,45 @@ private:
 		/// Returns the property storage that contains the particle selection (optional).
 		const ConstPropertyPtr& selection() const { return _selection; }
 
+		/// Returns the property storage that contains the particle masses (optional).
+		const ConstPropertyPtr& masses() const { return _masses; }
+
 	protected:
 
+		/// An edge of the neighbor graph that joined two clusters.
+		struct TreeEdge {
+			size_t particle1;
+			size_t particle2;
+			Vector3I pbcShift;
+		};
+
+		/// Determines the periodic image of each particle in which its cluster is contiguous.
+		void unwrapClusters();
+
+		/// Numbers the clusters in the order of their seed particles and computes the per-cluster quantities.
+		void labelClusters();
+
 		const SimulationCell _simCell;
 		const bool _sortBySize;
+		const bool _computeCentersOfMass;
 		ConstPropertyPtr _positions;
 		ConstPropertyPtr _selection;
+		ConstPropertyPtr _masses;
 		size_t _numClusters = 0;
 		size_t _largestClusterSize = 0;
 		const PropertyPtr _particleClusters;
+		PropertyPtr _clusterSizes;
+		PropertyPtr _centersOfMass;
 		ParticleOrderingFingerprint _inputFingerprint;
+
+		/// The disjoint-set forest of the particles, which links every particle to another particle of the same cluster.
+		std::unique_ptr<std::atomic<size_t>[]> _parents;
+
+		/// The edge by which each particle was attached to another cluster while it was a root (only when computing centers of mass).
+		std::unique_ptr<TreeEdge[]> _treeEdges;
+
+		/// The periodic image of each particle relative to the seed particle of its cluster (only when computing centers of mass).
+		std::unique_ptr<Vector3I[]> _images;
 	};
 
 	/// Computes the modifier's results.
@@ -145,8 +225,8 @@ private:
 	public:
 
 		/// Constructor.
-		CutoffClusterAnalysisEngine(ParticleOrderingFingerprint fingerprint, ConstPropertyPtr positions, const SimulationCell& simCell, bool sortBySize, ConstPropertyPtr selection, FloatType cutoff) :
-			ClusterAnalysisEngine(std::move(fingerprint), std::move(positions), simCell, sortBySize, std::move(selection)),
+		CutoffClusterAnalysisEngine(ParticleOrderingFingerprint fingerprint, ConstPropertyPtr positions, const SimulationCell& simCell, bool sortBySize, bool computeCentersOfMass, ConstPropertyPtr selection, ConstPropertyPtr masses, FloatType cutoff) :
+			ClusterAnalysisEngine(std::move(fingerprint), std::move(positions), simCell, sortBySize, computeCentersOfMass, std::move(selection), std::move(masses)),
 			_cutoff(cutoff) {}
 
 		/// Performs the actual clustering algorithm.
@@ -166,13 +246,15 @@ private:
 	public:
 
 		/// Constructor.
-		BondClusterAnalysisEngine(ParticleOrderingFingerprint fingerprint, ConstPropertyPtr positions, const SimulationCell& simCell, bool sortBySize, ConstPropertyPtr selection, ConstPropertyPtr bondTopology) :
-			ClusterAnalysisEngine(std::move(fingerprint), std::move(positions), simCell, sortBySize, std::move(selection)),
-			_bondTopology(std::move(bondTopology)) {}
+		BondClusterAnalysisEngine(ParticleOrderingFingerprint fingerprint, ConstPropertyPtr positions, const SimulationCell& simCell, bool sortBySize, bool computeCentersOfMass, ConstPropertyPtr selection, ConstPropertyPtr masses, ConstPropertyPtr bondTopology, ConstPropertyPtr bondPeriodicImages) :
+			ClusterAnalysisEngine(std::move(fingerprint), std::move(positions), simCell, sortBySize, computeCentersOfMass, std::move(selection), std::move(masses)),
+			_bondTopology(std::move(bondTopology)),
+			_bondPeriodicImages(std::move(bondPeriodicImages)) {}
 
 		/// This method is called by the system after the computation was successfully completed.
 		virtual void cleanup() override {
 			_bondTopology.reset();
+			_bondPeriodicImages.reset();
 			ClusterAnalysisEngine::cleanup();
 		}
 
@@ -182,9 +264,13 @@ private:
 		/// Returns the list of input bonds.
 		const ConstPropertyPtr& bondTopology() const { return _bondTopology; }
 
+		/// Returns the PBC shift vectors of the input bonds (optional).
+		const ConstPropertyPtr& bondPeriodicImages() const { return _bondPeriodicImages; }
+
 	private:
 
 		ConstPropertyPtr _bondTopology;
+		ConstPropertyPtr _bondPeriodicImages;
 	};
 
 	/// The neighbor mode.
@@ -198,6 +284,9 @@ private:
 
 	/// Controls the sorting of cluster IDs by cluster size.
 	DECLARE_MODIFIABLE_PROPERTY_FIELD(bool, sortBySize, setSortBySize);
+
+	/// Controls the output of the list of clusters with their sizes and centers of mass.
+	DECLARE_MODIFIABLE_PROPERTY_FIELD(bool, computeCentersOfMass, setComputeCentersOfMass);
 };
 
 OVITO_END_INLINE_NAMESPACE
@@ -22,6 +22,7 @@
 #include <plugins/particles/Particles.h>
 #include <plugins/particles/util/NearestNeighborFinder.h>
 #include <plugins/particles/util/CutoffNeighborFinder.h>
+#include <plugins/particles/util/NeighborFinderCache.h>
 #include <plugins/particles/objects/BondsObject.h>
 #include <plugins/particles/objects/ParticlesObject.h>
 #include <plugins/particles/objects/ParticleBondMap.h>
@@ -36,16 +37,19 @@ namespace Ovito { namespace Particles { OVITO_BEGIN_INLINE_NAMESPACE(Modifiers)
 
 IMPLEMENT_OVITO_CLASS(CommonNeighborAnalysisModifier);
 DEFINE_PROPERTY_FIELD(CommonNeighborAnalysisModifier, cutoff);
+DEFINE_PROPERTY_FIELD(CommonNeighborAnalysisModifier, verletSkin);
 DEFINE_PROPERTY_FIELD(CommonNeighborAnalysisModifier, mode);
 SET_PROPERTY_FIELD_LABEL(CommonNeighborAnalysisModifier, cutoff, "Cutoff radius");
+SET_PROPERTY_FIELD_LABEL(CommonNeighborAnalysisModifier, verletSkin, "Verlet skin");
 SET_PROPERTY_FIELD_LABEL(CommonNeighborAnalysisModifier, mode, "Mode");
 SET_PROPERTY_FIELD_UNITS_AND_MINIMUM(CommonNeighborAnalysisModifier, cutoff, WorldParameterUnit, 0);
+SET_PROPERTY_FIELD_UNITS_AND_MINIMUM(CommonNeighborAnalysisModifier, verletSkin, WorldParameterUnit, 0);
 
 /******************************************************************************
 * Constructs the modifier object.
 ******************************************************************************/
 CommonNeighborAnalysisModifier::CommonNeighborAnalysisModifier(DataSet* dataset) : StructureIdentificationModifier(dataset),
-	_cutoff(3.2), _mode(AdaptiveCutoffMode)
+	_cutoff(3.2), _verletSkin(0), _mode(AdaptiveCutoffMode)
 {
 	// Create the structure types.
 	createStructureType(OTHER, ParticleType::PredefinedStructureType::OTHER);
@@ -87,7 +91,7 @@ Future<AsynchronousModifier::ComputeEnginePtr> CommonNeighborAnalysisModifier::c
 			topologyProperty->storage(), periodicImagesProperty ? periodicImagesProperty->storage() : nullptr);
 	}
 	else {
-		return std::make_shared<FixedCNAEngine>(particles, posProperty->storage(), simCell->data(), getTypesToIdentify(NUM_STRUCTURE_TYPES), std::move(selectionProperty), cutoff());
+		return std::make_shared<FixedCNAEngine>(particles, posProperty->storage(), simCell->data(), getTypesToIdentify(NUM_STRUCTURE_TYPES), std::move(selectionProperty), cutoff(), std::max(verletSkin(), FloatType(0)));
 	}
 }
 
@@ -99,8 +103,8 @@ void CommonNeighborAnalysisModifier::AdaptiveCNAEngine::perform()
 	task()->setProgressText(tr("Performing adaptive common neighbor analysis"));
 
 	// Prepare the neighbor list.
-	NearestNeighborFinder neighFinder(MAX_NEIGHBORS);
-	if(!neighFinder.prepare(*positions(), cell(), selection().get(), task().get()))
+	std::shared_ptr<const NearestNeighborFinder> neighFinder = NeighborFinderCache::nearestNeighborFinder(MAX_NEIGHBORS, positions(), cell(), selection(), task().get());
+	if(!neighFinder)
 		return;
 
 	// Create output storage.
@@ -110,7 +114,7 @@ void CommonNeighborAnalysisModifier::AdaptiveCNAEngine::perform()
 	parallelFor(positions()->size(), *task(), [this, &neighFinder, &output](size_t index) {
 		// Skip particles that are not included in the analysis.
 		if(!selection() || selection()->getInt(index))
-			output.setInt(index, determineStructureAdaptive(neighFinder, index, typesToIdentify()));
+			output.setInt(index, determineStructureAdaptive(*neighFinder, index, typesToIdentify()));
 		else
 			output.setInt(index, OTHER);
 	});
@@ -124,8 +128,9 @@ void CommonNeighborAnalysisModifier::FixedCNAEngine::perform()
 	task()->setProgressText(tr("Performing common neighbor analysis"));
 
 	// Prepare the neighbor list.
-	CutoffNeighborFinder neighborListBuilder;
-	if(!neighborListBuilder.prepare(_cutoff, *positions(), cell(), selection().get(), task().get()))
+	std::shared_ptr<const CutoffNeighborFinder> neighborListBuilder = NeighborFinderCache::cutoffNeighborFinder(_cutoff, positions(), cell(), selection(), task().get(),
+			_verletSkin, inputFingerprint().particleIdentifiers());
+	if(!neighborListBuilder)
 		return;
 
 	// Create output storage.
@@ -135,7 +140,7 @@ void CommonNeighborAnalysisModifier::FixedCNAEngine::perform()
 	parallelFor(positions()->size(), *task(), [this, &neighborListBuilder, &output](size_t index) {
 		// Skip particles that are not included in the analysis.
 		if(!selection() || selection()->getInt(index))
-			output.setInt(index, determineStructureFixed(neighborListBuilder, index, typesToIdentify()));
+			output.setInt(index, determineStructureFixed(*neighborListBuilder, index, typesToIdentify()));
 		else
 			output.setInt(index, OTHER);
 	});
@@ -355,10 +360,10 @@ int CommonNeighborAnalysisModifier::calcMaxChainLength(CNAPairBond* neighborBond
 * Determines the coordination structure of a single particle using the
 * adaptive common neighbor analysis method.
 ******************************************************************************/
-CommonNeighborAnalysisModifier::StructureType CommonNeighborAnalysisModifier::determineStructureAdaptive(NearestNeighborFinder& neighFinder, size_t particleIndex, const QVector<bool>& typesToIdentify)
+CommonNeighborAnalysisModifier::StructureType CommonNeighborAnalysisModifier::determineStructureAdaptive(const NearestNeighborFinder& neighFinder, size_t particleIndex, const QVector<bool>& typesToIdentify)
 {
 	// Construct local neighbor list builder.
-	NearestNeighborFinder::Query<MAX_NEIGHBORS> neighQuery(neighFinder);
+	NearestNeighborFinder::Query<MAX_NEIGHBORS> neighQuery(neighFinder, MAX_NEIGHBORS);
 
 	// Find N nearest neighbors of current atom.
 	neighQuery.findNeighbors(particleIndex);
@@ -480,7 +485,7 @@ CommonNeighborAnalysisModifier::StructureType CommonNeighborAnalysisModifier::de
 * Determines the coordination structure of a single particle using the
 * conventional common neighbor analysis method.
 ******************************************************************************/
-CommonNeighborAnalysisModifier::StructureType CommonNeighborAnalysisModifier::determineStructureFixed(CutoffNeighborFinder& neighList, size_t particleIndex, const QVector<bool>& typesToIdentify)
+CommonNeighborAnalysisModifier::StructureType CommonNeighborAnalysisModifier::determineStructureFixed(const CutoffNeighborFinder& neighList, size_t particleIndex, const QVector<bool>& typesToIdentify)
 {
 	// Store neighbor vectors in a local array.
 	int numNeighbors = 0;
@@ -148,9 +148,9 @@ private:
 	public:
 
 		/// Constructor.
-		FixedCNAEngine(ParticleOrderingFingerprint fingerprint, ConstPropertyPtr positions, const SimulationCell& simCell, QVector<bool> typesToIdentify, ConstPropertyPtr selection, FloatType cutoff) :
+		FixedCNAEngine(ParticleOrderingFingerprint fingerprint, ConstPropertyPtr positions, const SimulationCell& simCell, QVector<bool> typesToIdentify, ConstPropertyPtr selection, FloatType cutoff, FloatType verletSkin) :
 			CNAEngine(std::move(fingerprint), std::move(positions), simCell, std::move(typesToIdentify), std::move(selection)), 
-			_cutoff(cutoff) {}
+			_cutoff(cutoff), _verletSkin(verletSkin) {}
 
 		/// Computes the modifier's results.
 		virtual void perform() override;
@@ -159,6 +159,9 @@ private:
 
 		/// The CNA cutoff radius.
 		const FloatType _cutoff;
+
+		/// The skin distance of the Verlet neighbor list.
+		const FloatType _verletSkin;
 	};
 
 	/// Analysis engine that performs the adaptive common neighbor analysis.
@@ -215,14 +218,17 @@ private:
 	};
 
 	/// Determines the coordination structure of a single particle using the common neighbor analysis method.
-	static StructureType determineStructureAdaptive(NearestNeighborFinder& neighList, size_t particleIndex, const QVector<bool>& typesToIdentify);
+	static StructureType determineStructureAdaptive(const NearestNeighborFinder& neighList, size_t particleIndex, const QVector<bool>& typesToIdentify);
 
 	/// Determines the coordination structure of a single particle using the common neighbor analysis method.
-	static StructureType determineStructureFixed(CutoffNeighborFinder& neighList, size_t particleIndex, const QVector<bool>& typesToIdentify);
+	static StructureType determineStructureFixed(const CutoffNeighborFinder& neighList, size_t particleIndex, const QVector<bool>& typesToIdentify);
 
 	/// The cutoff radius used for the conventional CNA.
 	DECLARE_MODIFIABLE_PROPERTY_FIELD_FLAGS(FloatType, cutoff, setCutoff, PROPERTY_FIELD_MEMORIZE);
 
+	/// The skin distance of the Verlet neighbor list used for the conventional CNA (zero to disable).
+	DECLARE_MODIFIABLE_PROPERTY_FIELD(FloatType, verletSkin, setVerletSkin);
+
 	/// Controls how the CNA is performed.
 	DECLARE_MODIFIABLE_PROPERTY_FIELD_FLAGS(CNAMode, mode, setMode, PROPERTY_FIELD_MEMORIZE);
 };
@@ -20,6 +20,7 @@
 ///////////////////////////////////////////////////////////////////////////////
 
 #include <plugins/particles/Particles.h>
+#include <plugins/particles/util/NeighborFinderCache.h>
 #include <core/app/Application.h>
 #include <core/dataset/DataSet.h>
 #include <plugins/stdobj/simcell/SimulationCellObject.h>
@@ -33,12 +34,15 @@ namespace Ovito { namespace Particles { OVITO_BEGIN_INLINE_NAMESPACE(Modifiers)
 
 IMPLEMENT_OVITO_CLASS(CoordinationAnalysisModifier);
 DEFINE_PROPERTY_FIELD(CoordinationAnalysisModifier, cutoff);
+DEFINE_PROPERTY_FIELD(CoordinationAnalysisModifier, verletSkin);
 DEFINE_PROPERTY_FIELD(CoordinationAnalysisModifier, numberOfBins);
 DEFINE_PROPERTY_FIELD(CoordinationAnalysisModifier, computePartialRDF);
 SET_PROPERTY_FIELD_LABEL(CoordinationAnalysisModifier, cutoff, "Cutoff radius");
+SET_PROPERTY_FIELD_LABEL(CoordinationAnalysisModifier, verletSkin, "Verlet skin");
 SET_PROPERTY_FIELD_LABEL(CoordinationAnalysisModifier, numberOfBins, "Number of histogram bins");
 SET_PROPERTY_FIELD_LABEL(CoordinationAnalysisModifier, computePartialRDF, "Compute partial RDFs");
 SET_PROPERTY_FIELD_UNITS_AND_MINIMUM(CoordinationAnalysisModifier, cutoff, WorldParameterUnit, 0);
+SET_PROPERTY_FIELD_UNITS_AND_MINIMUM(CoordinationAnalysisModifier, verletSkin, WorldParameterUnit, 0);
 SET_PROPERTY_FIELD_UNITS_AND_RANGE(CoordinationAnalysisModifier, numberOfBins, IntegerParameterUnit, 4, 100000);
 
 /******************************************************************************
@@ -46,6 +50,7 @@ SET_PROPERTY_FIELD_UNITS_AND_RANGE(CoordinationAnalysisModifier, numberOfBins, I
 ******************************************************************************/
 CoordinationAnalysisModifier::CoordinationAnalysisModifier(DataSet* dataset) : AsynchronousModifier(dataset),
 	_cutoff(3.2), 
+	_verletSkin(0),
 	_numberOfBins(200),
 	_computePartialRDF(false)
 {
@@ -97,7 +102,7 @@ Future<AsynchronousModifier::ComputeEnginePtr> CoordinationAnalysisModifier::cre
 
 	// Create engine object. Pass all relevant modifier parameters to the engine as well as the input data.
 	return std::make_shared<CoordinationAnalysisEngine>(particles, posProperty->storage(), inputCell->data(), 
-		cutoff(), rdfSampleCount, typeProperty ? typeProperty->storage() : nullptr, std::move(uniqueTypeIds));
+		cutoff(), std::max(verletSkin(), FloatType(0)), rdfSampleCount, typeProperty ? typeProperty->storage() : nullptr, std::move(uniqueTypeIds));
 }
 
 /******************************************************************************
@@ -108,8 +113,9 @@ void CoordinationAnalysisModifier::CoordinationAnalysisEngine::perform()
 	task()->setProgressText(tr("Coordination analysis"));
 
 	// Prepare the neighbor list service.
-	CutoffNeighborFinder neighborListBuilder;
-	if(!neighborListBuilder.prepare(cutoff(), *positions(), cell(), nullptr, task().get()))
+	std::shared_ptr<const CutoffNeighborFinder> neighborListBuilder = NeighborFinderCache::cutoffNeighborFinder(cutoff(), positions(), cell(), nullptr, task().get(),
+			verletSkin(), _inputFingerprint.particleIdentifiers());
+	if(!neighborListBuilder)
 		return;
 
 	size_t particleCount = positions()->size();
@@ -130,7 +136,7 @@ void CoordinationAnalysisModifier::CoordinationAnalysisEngine::perform()
 
 			size_t typeIndex1 = _computePartialRdfs ? uniqueTypeIds().index_of(uniqueTypeIds().find(particleTypes()->getInt(i))) : 0;
 			if(typeIndex1 < typeCount) {
-				for(CutoffNeighborFinder::Query neighQuery(neighborListBuilder, i); !neighQuery.atEnd(); neighQuery.next()) {
+				for(CutoffNeighborFinder::Query neighQuery(*neighborListBuilder, i); !neighQuery.atEnd(); neighQuery.next()) {
 					coordination++;
 					if(_computePartialRdfs) {
 						size_t typeIndex2 = uniqueTypeIds().index_of(uniqueTypeIds().find(particleTypes()->getInt(neighQuery.current())));
@@ -78,10 +78,11 @@ private:
 
 		/// Constructor.
 		CoordinationAnalysisEngine(ParticleOrderingFingerprint fingerprint, ConstPropertyPtr positions, const SimulationCell& simCell, 
-				FloatType cutoff, int rdfSampleCount, ConstPropertyPtr particleTypes, boost::container::flat_map<int,QString> uniqueTypeIds) :
+				FloatType cutoff, FloatType verletSkin, int rdfSampleCount, ConstPropertyPtr particleTypes, boost::container::flat_map<int,QString> uniqueTypeIds) :
 			_positions(std::move(positions)), 
 			_simCell(simCell),
 			_cutoff(cutoff),
+			_verletSkin(verletSkin),
 			_computePartialRdfs(particleTypes),
 			_particleTypes(std::move(particleTypes)),
 			_uniqueTypeIds(std::move(uniqueTypeIds)),
@@ -132,12 +133,16 @@ private:
 		/// Returns the cutoff radius.
 		FloatType cutoff() const { return _cutoff; }
 
+		/// Returns the skin distance of the Verlet neighbor list.
+		FloatType verletSkin() const { return _verletSkin; }
+
 		/// Returns the set of particle type identifiers in the system.
 		const boost::container::flat_map<int,QString>& uniqueTypeIds() const { return _uniqueTypeIds; }
 
 	private:
 
 		const FloatType _cutoff;
+		const FloatType _verletSkin;
 		const SimulationCell _simCell;
 		bool _computePartialRdfs;
 		boost::container::flat_map<int,QString> _uniqueTypeIds;
@@ -153,6 +158,9 @@ private:
 	/// Controls the cutoff radius for the neighbor lists.
 	DECLARE_MODIFIABLE_PROPERTY_FIELD_FLAGS(FloatType, cutoff, setCutoff, PROPERTY_FIELD_MEMORIZE);
 
+	/// Controls the skin distance of the Verlet neighbor list, which is reused across trajectory frames (zero to disable).
+	DECLARE_MODIFIABLE_PROPERTY_FIELD(FloatType, verletSkin, setVerletSkin);
+
 	/// Controls the number of RDF histogram bins.
 	DECLARE_MODIFIABLE_PROPERTY_FIELD_FLAGS(int, numberOfBins, setNumberOfBins, PROPERTY_FIELD_MEMORIZE);
 
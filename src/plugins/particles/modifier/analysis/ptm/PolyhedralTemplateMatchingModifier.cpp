@@ -21,6 +21,7 @@
 
 #include <plugins/particles/Particles.h>
 #include <plugins/particles/util/NearestNeighborFinder.h>
+#include <plugins/particles/util/NeighborFinderCache.h>
 #include <plugins/stdobj/properties/PropertyStorage.h>
 #include <plugins/stdobj/series/DataSeriesObject.h>
 #include <plugins/stdobj/simcell/SimulationCellObject.h>
@@ -143,8 +144,8 @@ void PolyhedralTemplateMatchingModifier::PTMEngine::perform()
 	task()->setProgressText(tr("Performing polyhedral template matching"));
 
 	// Prepare the neighbor list.
-	NearestNeighborFinder neighFinder(MAX_NEIGHBORS);
-	if(!neighFinder.prepare(*positions(), cell(), selection().get(), task().get()))
+	std::shared_ptr<const NearestNeighborFinder> neighFinder = NeighborFinderCache::nearestNeighborFinder(MAX_NEIGHBORS, positions(), cell(), selection(), task().get());
+	if(!neighFinder)
 		return;
 
 	task()->setProgressValue(0);
@@ -175,7 +176,7 @@ void PolyhedralTemplateMatchingModifier::PTMEngine::perform()
 			}
 
 			// Find nearest neighbors.
-			NearestNeighborFinder::Query<MAX_NEIGHBORS> neighQuery(neighFinder);
+			NearestNeighborFinder::Query<MAX_NEIGHBORS> neighQuery(*neighFinder, MAX_NEIGHBORS);
 			neighQuery.findNeighbors(index);
 			int numNeighbors = neighQuery.results().size();
 			OVITO_ASSERT(numNeighbors <= MAX_NEIGHBORS);
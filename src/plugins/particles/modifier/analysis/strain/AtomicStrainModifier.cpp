@@ -21,6 +21,7 @@
 
 #include <plugins/particles/Particles.h>
 #include <plugins/particles/util/CutoffNeighborFinder.h>
+#include <plugins/particles/util/NeighborFinderCache.h>
 #include <core/dataset/pipeline/ModifierApplication.h>
 #include <plugins/stdobj/simcell/SimulationCellObject.h>
 #include <core/dataset/DataSetContainer.h>
@@ -143,20 +144,20 @@ void AtomicStrainModifier::AtomicStrainEngine::perform()
 	task()->setProgressText(tr("Computing atomic strain tensors"));
 	
 	// Prepare the neighbor list for the reference configuration.
-	CutoffNeighborFinder neighborFinder;
-	if(!neighborFinder.prepare(_cutoff, *refPositions(), refCell(), nullptr, task().get()))
+	std::shared_ptr<const CutoffNeighborFinder> neighborFinder = NeighborFinderCache::cutoffNeighborFinder(_cutoff, refPositions(), refCell(), nullptr, task().get());
+	if(!neighborFinder)
 		return;
 
 	// Perform individual strain calculation for each particle.
 	parallelFor(positions()->size(), *task(), [this, &neighborFinder](size_t index) {
-		computeStrain(index, neighborFinder);
+		computeStrain(index, *neighborFinder);
 	});
 }
 
 /******************************************************************************
 * Computes the strain tensor of a single particle.
 ******************************************************************************/
-void AtomicStrainModifier::AtomicStrainEngine::computeStrain(size_t particleIndex, CutoffNeighborFinder& neighborFinder)
+void AtomicStrainModifier::AtomicStrainEngine::computeStrain(size_t particleIndex, const CutoffNeighborFinder& neighborFinder)
 {
 	// Note: We do the following calculations using double precision numbers to
 	// minimize numerical errors. Final results will be converted back to
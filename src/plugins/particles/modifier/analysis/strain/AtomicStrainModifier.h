@@ -130,7 +130,7 @@ private:
 	private:
 
 		/// Computes the strain tensor of a single particle.
-		void computeStrain(size_t particleIndex, CutoffNeighborFinder& neighborListBuilder);
+		void computeStrain(size_t particleIndex, const CutoffNeighborFinder& neighborListBuilder);
 
 		const FloatType _cutoff;
 		PropertyPtr _displacements;
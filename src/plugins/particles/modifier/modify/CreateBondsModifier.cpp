@@ -31,6 +31,11 @@
 
 namespace Ovito { namespace Particles { OVITO_BEGIN_INLINE_NAMESPACE(Modifiers) OVITO_BEGIN_INLINE_NAMESPACE(Modify)
 
+namespace {
+	/// Number of particles whose bonds are generated as one piece of work.
+	constexpr size_t BondsChunkSize = 4096;
+}
+
 IMPLEMENT_OVITO_CLASS(CreateBondsModifier);
 DEFINE_PROPERTY_FIELD(CreateBondsModifier, cutoffMode);
 DEFINE_PROPERTY_FIELD(CreateBondsModifier, uniformCutoff);
@@ -192,52 +197,54 @@ void CreateBondsModifier::BondsEngine::perform()
 
 	FloatType minCutoffSquared = _minCutoff * _minCutoff;
 
-	// Generate bonds.
+	// Decides whether a bond is created between the particle and its current neighbor.
+	auto isBonded = [this, minCutoffSquared](size_t particleIndex, const CutoffNeighborFinder::Query& neighborQuery) {
+		if(neighborQuery.distanceSquared() < minCutoffSquared)
+			return false;
+		if(_moleculeIDs && _moleculeIDs->getInt64(particleIndex) != _moleculeIDs->getInt64(neighborQuery.current()))
+			return false;
+		if(_particleTypes) {
+			int type1 = _particleTypes->getInt(particleIndex);
+			int type2 = _particleTypes->getInt(neighborQuery.current());
+			if(type1 < 0 || type1 >= (int)_pairCutoffsSquared.size() || type2 < 0 || type2 >= (int)_pairCutoffsSquared[type1].size())
+				return false;
+			return neighborQuery.distanceSquared() <= _pairCutoffsSquared[type1][type2];
+		}
+		return true;
+	};
+
+	// Generate bonds. The particles are processed in chunks by several threads in parallel.
+	// Each chunk collects its bonds in a buffer of its own.
 	size_t particleCount = _positions->size();
-	task()->setProgressMaximum(particleCount);
-	if(!_particleTypes) {
-		for(size_t particleIndex = 0; particleIndex < particleCount; particleIndex++) {
+	size_t chunkCount = (particleCount + BondsChunkSize - 1) / BondsChunkSize;
+	std::vector<std::vector<Bond>> chunkBonds(chunkCount);
+	if(!parallelFor(chunkCount, *task(), [&](size_t chunk) {
+		std::vector<Bond>& buffer = chunkBonds[chunk];
+		for(size_t particleIndex = chunk * BondsChunkSize, end = std::min(particleIndex + BondsChunkSize, particleCount); particleIndex < end; particleIndex++) {
 			for(CutoffNeighborFinder::Query neighborQuery(neighborFinder, particleIndex); !neighborQuery.atEnd(); neighborQuery.next()) {
-				if(neighborQuery.distanceSquared() < minCutoffSquared)
-					continue;
-				if(_moleculeIDs && _moleculeIDs->getInt64(particleIndex) != _moleculeIDs->getInt64(neighborQuery.current()))
+				if(!isBonded(particleIndex, neighborQuery))
 					continue;
 
 				Bond bond = { particleIndex, neighborQuery.current(), neighborQuery.unwrappedPbcShift() };
 
 				// Skip every other bond to create only one bond per particle pair.
 				if(!bond.isOdd())
-					bonds().push_back(bond);
+					buffer.push_back(bond);
 			}
-			// Update progress indicator.
-			if(!task()->setProgressValueIntermittent(particleIndex))
-				return;
 		}
-	}
-	else {
-		for(size_t particleIndex = 0; particleIndex < particleCount; particleIndex++) {
-			for(CutoffNeighborFinder::Query neighborQuery(neighborFinder, particleIndex); !neighborQuery.atEnd(); neighborQuery.next()) {
-				if(neighborQuery.distanceSquared() < minCutoffSquared)
-					continue;
-				if(_moleculeIDs && _moleculeIDs->getInt64(particleIndex) != _moleculeIDs->getInt64(neighborQuery.current()))
-					continue;
-				int type1 = _particleTypes->getInt(particleIndex);
-				int type2 = _particleTypes->getInt(neighborQuery.current());
-				if(type1 >= 0 && type1 < (int)_pairCutoffsSquared.size() && type2 >= 0 && type2 < (int)_pairCutoffsSquared[type1].size()) {
-					if(neighborQuery.distanceSquared() <= _pairCutoffsSquared[type1][type2]) {
-						Bond bond = { particleIndex, neighborQuery.current(), neighborQuery.unwrappedPbcShift() };
-						// Skip every other bond to create only one bond per particle pair.
-						if(!bond.isOdd())				
-							bonds().push_back(bond);
-					}
-				}
-			}
-			// Update progress indicator.
-			if(!task()->setProgressValueIntermittent(particleIndex))
-				return;
-		}
-	}
-	task()->setProgressValue(particleCount);
+	}, (size_t)1))
+		return;
+
+	// Concatenate the buffers in the order of the chunks, which yields the same bond order as a sequential loop over the particles.
+	// The sizes of the buffers determine the final size of the bond list and the offset of each buffer in the list.
+	std::vector<size_t> chunkOffsets(chunkCount + 1, 0);
+	for(size_t chunk = 0; chunk < chunkCount; chunk++)
+		chunkOffsets[chunk + 1] = chunkOffsets[chunk] + chunkBonds[chunk].size();
+	bonds().resize(chunkOffsets.back());
+	parallelFor(chunkCount, [&](size_t chunk) {
+		std::copy(chunkBonds[chunk].cbegin(), chunkBonds[chunk].cend(), bonds().begin() + chunkOffsets[chunk]);
+		std::vector<Bond>().swap(chunkBonds[chunk]);
+	});
 }
 
 /******************************************************************************
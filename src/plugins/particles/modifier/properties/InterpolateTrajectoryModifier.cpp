@@ -160,8 +160,8 @@ void InterpolateTrajectoryModifier::evaluatePreliminary(TimePoint time, Modifier
 			!std::equal(idProperty1->constDataInt64(), idProperty1->constDataInt64() + idProperty1->size(), idProperty2->constDataInt64())) {
 
 		// Build ID-to-index map.
-		std::unordered_map<qlonglong,int> idmap;
-		int index = 0;
+		std::unordered_map<qlonglong,size_t> idmap;
+		size_t index = 0;
 		for(auto id : idProperty2->constInt64Range()) {
 			if(!idmap.insert(std::make_pair(id,index)).second)
 				throwException(tr("Detected duplicate particle ID: %1. Cannot interpolate trajectories in this case.").arg(id));
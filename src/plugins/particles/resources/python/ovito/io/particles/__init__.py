@@ -6,7 +6,7 @@ import ovito.io.stdobj
 import ovito.io.stdmod
 
 # Load the native code modules
-from ovito.plugins.Particles import LAMMPSDataImporter
+from ovito.plugins.Particles import ParticleImporter, LAMMPSDataImporter
 from ovito.plugins.Particles import (LAMMPSDumpExporter, LAMMPSDataExporter, IMDExporter, POSCARExporter, XYZExporter, FHIAimsExporter)
 
 # Register export formats.
@@ -17,6 +17,17 @@ ovito.io.export_file._formatTable["vasp"] = POSCARExporter
 ovito.io.export_file._formatTable["xyz"] = XYZExporter
 ovito.io.export_file._formatTable["fhi-aims"] = FHIAimsExporter
 
+def clear_parsed_frame_cache():
+    """ Deletes all frames that have been stored in the user's cache directory by :py:func:`import_file` calls with the
+        ``cache_parsed_frames=True`` option. Later imports parse the input files again.
+
+        The cache does not grow without bounds even if this function is never called: Once its total size exceeds
+        a limit (4 GB by default), the least recently used frames are deleted.
+    """
+    ParticleImporter.clear_parsed_frame_cache()
+ovito.io.clear_parsed_frame_cache = clear_parsed_frame_cache
+ovito.io.__all__ += ['clear_parsed_frame_cache']
+
 # For backward compatibility with OVITO 2.9.0:
 ovito.io.export_file._formatTable["lammps_dump"] = LAMMPSDumpExporter
 ovito.io.export_file._formatTable["lammps_data"] = LAMMPSDataExporter
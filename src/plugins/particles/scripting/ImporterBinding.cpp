@@ -25,6 +25,7 @@
 #include <plugins/stdobj/simcell/SimulationCellObject.h>
 #include <plugins/particles/import/InputColumnMapping.h>
 #include <plugins/particles/import/ParticleImporter.h>
+#include <plugins/particles/import/ParticleFrameCache.h>
 #include <plugins/particles/import/cfg/CFGImporter.h>
 #include <plugins/particles/import/imd/IMDImporter.h>
 #include <plugins/particles/import/parcas/ParcasFileImporter.h>
@@ -53,6 +54,8 @@ void defineImportersSubmodule(py::module m)
 	ovito_abstract_class<ParticleImporter, FileSourceImporter>(m)
 		.def_property("multiple_frames", &ParticleImporter::isMultiTimestepFile, &ParticleImporter::setMultiTimestepFile)
 		.def_property("sort_particles", &ParticleImporter::sortParticles, &ParticleImporter::setSortParticles)
+		.def_property("cache_parsed_frames", &ParticleImporter::cacheParsedFrames, &ParticleImporter::setCacheParsedFrames)
+		.def_static("clear_parsed_frame_cache", &ParticleFrameCache::clear)
 	;
 
 	ovito_class<XYZImporter, ParticleImporter>(m)
@@ -237,6 +237,14 @@ void defineModifiersSubmodule(py::module m)
 				"This parameter is only used if :py:attr:`.mode` == ``CommonNeighborAnalysisModifier.Mode.FixedCutoff``."
 				"\n\n"
 				":Default: 3.2\n")
+		.def_property("verlet_skin", &CommonNeighborAnalysisModifier::verletSkin, &CommonNeighborAnalysisModifier::setVerletSkin,
+				"If positive, the conventional common neighbor analysis builds a Verlet neighbor list with this extra distance beyond the :py:attr:`.cutoff` radius. "
+				"When the modifier processes the frames of a trajectory, the list of the previous frame is reused "
+				"as long as no particle has moved farther than half the skin distance and the simulation cell has not changed. "
+				"The particles must carry the ``Particle Identifier`` property for the list to be reused. "
+				"This parameter is only used if :py:attr:`.mode` == ``CommonNeighborAnalysisModifier.Mode.FixedCutoff``."
+				"\n\n"
+				":Default: 0.0\n")
 		.def_property("mode", &CommonNeighborAnalysisModifier::mode, &CommonNeighborAnalysisModifier::setMode,
 				"Selects the mode of operation. "
 				"Valid values are:"
@@ -432,6 +440,8 @@ void defineModifiersSubmodule(py::module m)
 			"   The total number of clusters produced by the modifier. Cluster IDs range from 1 to this number.\n"
 			" * ``ClusterAnalysis.largest_size`` (:py:attr:`attribute <ovito.data.DataCollection.attributes>`):\n"
 			"   The number of particles belonging to the largest cluster (cluster ID 1). This attribute is only computed by the modifier when :py:attr:`.sort_by_size` is set.\n"
+			" * ``clusters`` (:py:class:`~ovito.data.DataSeries`):\n"
+			"   The list of clusters, with the ``Cluster Size`` and the ``Center of Mass`` of each cluster. This data series is only output by the modifier when :py:attr:`.compute_com` is set.\n"
 			"\n"
 			"**Example:**"
 			"\n\n"
@@ -470,6 +480,13 @@ void defineModifiersSubmodule(py::module m)
 				"Enables the sorting of clusters by size (in descending order). Cluster 1 will be the largest cluster, cluster 2 the second largest, and so on."
 				"\n\n"
 				":Default: ``False``\n")
+		.def_property("compute_com", &ClusterAnalysisModifier::computeCentersOfMass, &ClusterAnalysisModifier::setComputeCentersOfMass,
+				"Enables the computation of the center of mass of each cluster. The modifier outputs the centers of mass together with the cluster sizes "
+				"in the ``clusters`` :py:class:`~ovito.data.DataSeries`. The particles are weighted by their ``Mass`` property if it exists. "
+				"Clusters that cross a periodic boundary are unwrapped first, starting from the particle with the lowest index in the cluster, "
+				"and their centers of mass are wrapped back into the simulation cell. "
+				"\n\n"
+				":Default: ``False``\n")
 	;
 
 	py::enum_<ClusterAnalysisModifier::NeighborMode>(ClusterAnalysisModifier_py, "NeighborMode")
@@ -499,6 +516,14 @@ void defineModifiersSubmodule(py::module m)
 				"Specifies the cutoff distance for the coordination number calculation and also the range up to which the modifier calculates the RDF. "
 				"\n\n"
 				":Default: 3.2\n")
+		.def_property("verlet_skin", &CoordinationAnalysisModifier::verletSkin, &CoordinationAnalysisModifier::setVerletSkin,
+				"If positive, the modifier builds a Verlet neighbor list with this extra distance beyond the :py:attr:`.cutoff` radius. "
+				"When the modifier processes the frames of a trajectory, the list of the previous frame is reused "
+				"as long as no particle has moved farther than half the skin distance and the simulation cell has not changed. "
+				"The particles must carry the ``Particle Identifier`` property for the list to be reused. "
+				"A skin distance of zero turns off the Verlet list. "
+				"\n\n"
+				":Default: 0.0\n")
 		.def_property("number_of_bins", &CoordinationAnalysisModifier::numberOfBins, &CoordinationAnalysisModifier::setNumberOfBins,
 				"The number of histogram bins to use when computing the RDF."
 				"\n\n"
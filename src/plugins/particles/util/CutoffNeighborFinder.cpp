@@ -21,10 +21,59 @@
 
 #include <plugins/particles/Particles.h>
 #include <core/utilities/concurrent/PromiseState.h>
+#include <core/utilities/concurrent/ParallelFor.h>
 #include "CutoffNeighborFinder.h"
 
 namespace Ovito { namespace Particles { OVITO_BEGIN_INLINE_NAMESPACE(Util)
 
+/******************************************************************************
+* Appends the linear indices of all bins within the block of the grid starting at
+* the given corner to the output list, in Morton (Z-curve) order. The block extents
+* are powers of two. Only the longest extents are halved at each level, so that
+* elongated grids do not require a deep recursion over empty octants.
+******************************************************************************/
+static void appendBinsInMortonOrder(const int binDim[3], const Point3I& corner, const Vector3I& blockSize, std::vector<int>& order)
+{
+	if(corner.x() >= binDim[0] || corner.y() >= binDim[1] || corner.z() >= binDim[2])
+		return;
+	int maxSize = std::max({ blockSize.x(), blockSize.y(), blockSize.z() });
+	if(maxSize <= 2) {
+		// Emit the bins of the final 2x2x2 block directly.
+		for(int z = corner.z(); z < std::min(corner.z() + blockSize.z(), binDim[2]); z++)
+			for(int y = corner.y(); y < std::min(corner.y() + blockSize.y(), binDim[1]); y++)
+				for(int x = corner.x(); x < std::min(corner.x() + blockSize.x(), binDim[0]); x++)
+					order.push_back(x + y*binDim[0] + z*binDim[0]*binDim[1]);
+		return;
+	}
+	Vector3I childSize;
+	for(size_t k = 0; k < 3; k++)
+		childSize[k] = (blockSize[k] == maxSize) ? (maxSize / 2) : blockSize[k];
+	for(int child = 0; child < 8; child++) {
+		Point3I childCorner = corner;
+		bool valid = true;
+		for(size_t k = 0; k < 3; k++) {
+			if(child & (1 << k)) {
+				if(childSize[k] == blockSize[k]) { valid = false; break; }
+				childCorner[k] += childSize[k];
+			}
+		}
+		if(valid)
+			appendBinsInMortonOrder(binDim, childCorner, childSize, order);
+	}
+}
+
+/******************************************************************************
+* Constructs a neighbor finder for a smaller cutoff radius, which reuses the
+* bin grid of another neighbor finder.
+******************************************************************************/
+CutoffNeighborFinder::CutoffNeighborFinder(std::shared_ptr<const CutoffNeighborFinder> superset, FloatType cutoffRadius) :
+	_cutoffRadius(cutoffRadius),
+	_cutoffRadiusSquared(cutoffRadius * cutoffRadius),
+	_superset(superset->_superset ? superset->_superset : std::move(superset))
+{
+	OVITO_ASSERT(_cutoffRadius > 0 && _cutoffRadius <= _superset->cutoffRadius());
+}
+
 /******************************************************************************
 * Initialization function.
 ******************************************************************************/
@@ -39,6 +88,8 @@ bool CutoffNeighborFinder::prepare(FloatType cutoffRadius, const PropertyStorage
 		throw Exception("Invalid parameter: Neighbor cutoff radius must be positive.");
 
 	simCell = cellData;
+	_superset.reset();
+	_verletList.reset();
 
 	// Automatically disable PBCs in Z direction for 2D systems.
 	if(simCell.is2D()) {
@@ -155,58 +206,229 @@ bool CutoffNeighborFinder::prepare(FloatType cutoffRadius, const PropertyStorage
 			break;
 	}
 
-	// An 3d array of cubic bins.
-	// Each bin is a linked list of particles.
-	bins.resize(binCount, nullptr);
-
-	// Sort particles into bins.
+	// Determine the bin of each particle and wrap the particle positions at periodic boundaries.
 	particles.resize(positions.size());
+	std::vector<int> particleBins(positions.size());
 	const Point3* p = positions.constDataPoint3();
-	for(size_t pindex = 0; pindex < particles.size(); pindex++, ++p) {
+	parallelForChunks(particles.size(), [&](size_t startIndex, size_t count) {
+		for(size_t pindex = startIndex; pindex < startIndex + count; pindex++) {
 
-		if(promise && promise->isCanceled())
-			return false;
+			if(promise && promise->isCanceled())
+				return;
 
-		NeighborListParticle& a = particles[pindex];
-		a.pos = *p;
-		a.pbcShift.setZero();
+			NeighborListParticle& a = particles[pindex];
+			a.pos = p[pindex];
+			a.pbcShift.setZero();
 
-		if(selectionProperty && selectionProperty->getInt(pindex) == 0)
-			continue;
+			if(selectionProperty && selectionProperty->getInt(pindex) == 0) {
+				particleBins[pindex] = -1;
+				continue;
+			}
 
-		// Determine the bin the atom is located in.
-		Point3 rp = reciprocalBinCell * (*p);
+			// Determine the bin the atom is located in.
+			Point3 rp = reciprocalBinCell * p[pindex];
 
-		Point3I binLocation;
-		for(size_t k = 0; k < 3; k++) {
-			binLocation[k] = (int)floor(rp[k]);
-			if(simCell.pbcFlags()[k]) {
-				if(binLocation[k] < 0 || binLocation[k] >= binDim[k]) {
-					int shift;
-					if(binLocation[k] < 0)
-						shift = -(binLocation[k]+1)/binDim[k]+1;
-					else
-						shift = -binLocation[k]/binDim[k];
-					a.pbcShift[k] = shift;
-					a.pos += (FloatType)shift * simCell.matrix().column(k);
-					binLocation[k] = SimulationCell::modulo(binLocation[k], binDim[k]);
+			Point3I binLocation;
+			for(size_t k = 0; k < 3; k++) {
+				binLocation[k] = (int)floor(rp[k]);
+				if(simCell.pbcFlags()[k]) {
+					if(binLocation[k] < 0 || binLocation[k] >= binDim[k]) {
+						int shift;
+						if(binLocation[k] < 0)
+							shift = -(binLocation[k]+1)/binDim[k]+1;
+						else
+							shift = -binLocation[k]/binDim[k];
+						a.pbcShift[k] = shift;
+						a.pos += (FloatType)shift * simCell.matrix().column(k);
+						binLocation[k] = SimulationCell::modulo(binLocation[k], binDim[k]);
+					}
+				}
+				else if(binLocation[k] < 0) {
+					binLocation[k] = 0;
+				}
+				else if(binLocation[k] >= binDim[k]) {
+					binLocation[k] = binDim[k] - 1;
 				}
+				OVITO_ASSERT(binLocation[k] >= 0 && binLocation[k] < binDim[k]);
 			}
-			else if(binLocation[k] < 0) {
-				binLocation[k] = 0;
+
+			particleBins[pindex] = binLocation[0] + binLocation[1]*binDim[0] + binLocation[2]*binDim[0]*binDim[1];
+		}
+	});
+	if(promise && promise->isCanceled())
+		return false;
+
+	// Count the particles in each bin.
+	std::unique_ptr<std::atomic<size_t>[]> binCursors(new std::atomic<size_t>[binCount]());
+	parallelForChunks(particleBins.size(), [&](size_t startIndex, size_t count) {
+		for(size_t pindex = startIndex; pindex < startIndex + count; pindex++) {
+			if(particleBins[pindex] >= 0)
+				binCursors[particleBins[pindex]].fetch_add(1, std::memory_order_relaxed);
+		}
+	});
+
+	// Lay out the bins along a space-filling curve, so that neighboring bins are also
+	// close to each other in memory, and compute the start offset of each bin.
+	std::vector<int> binOrder;
+	binOrder.reserve(binCount);
+	Vector3I blockSize(1, 1, 1);
+	for(size_t k = 0; k < 3; k++) {
+		while(blockSize[k] < binDim[k])
+			blockSize[k] *= 2;
+	}
+	appendBinsInMortonOrder(binDim, Point3I(0, 0, 0), blockSize, binOrder);
+	OVITO_ASSERT((qint64)binOrder.size() == binCount);
+
+	binnedParticles.resize(positions.size());
+	bins.resize(binCount);
+	size_t offset = 0;
+	for(int binIndex : binOrder) {
+		size_t count = binCursors[binIndex].load(std::memory_order_relaxed);
+		bins[binIndex].begin = binnedParticles.data() + offset;
+		bins[binIndex].end = binnedParticles.data() + offset + count;
+		binCursors[binIndex].store(offset, std::memory_order_relaxed);
+		offset += count;
+	}
+	binnedParticles.resize(offset);
+
+	// Copy the wrapped particle positions into their bins.
+	parallelForChunks(particleBins.size(), [&](size_t startIndex, size_t count) {
+		for(size_t pindex = startIndex; pindex < startIndex + count; pindex++) {
+			if(particleBins[pindex] >= 0) {
+				BinnedParticle& entry = binnedParticles[binCursors[particleBins[pindex]].fetch_add(1, std::memory_order_relaxed)];
+				entry.pos = particles[pindex].pos;
+				entry.index = pindex;
 			}
-			else if(binLocation[k] >= binDim[k]) {
-				binLocation[k] = binDim[k] - 1;
+		}
+	});
+
+	// The order in which the particles of a bin were inserted depends on the thread scheduling.
+	// Sort each bin by descending particle index, which is the order neighbors have always been reported in.
+	parallelForChunks(bins.size(), [this](size_t startIndex, size_t count) {
+		for(auto bin = bins.begin() + startIndex; bin != bins.begin() + startIndex + count; ++bin) {
+			std::sort(bin->begin, bin->end, [](const BinnedParticle& a, const BinnedParticle& b) {
+				return a.index > b.index;
+			});
+		}
+	});
+
+	return !(promise && promise->isCanceled());
+}
+
+/******************************************************************************
+* Prepares the neighbor finder by building a Verlet list.
+******************************************************************************/
+bool CutoffNeighborFinder::prepareVerletList(FloatType cutoffRadius, FloatType skin, const PropertyStorage& positions, const SimulationCell& cellData, const PropertyStorage* selectionProperty, PromiseState* promise)
+{
+	OVITO_ASSERT(skin > 0);
+	if(!prepare(cutoffRadius + skin, positions, cellData, selectionProperty, promise))
+		return false;
+
+	auto list = std::make_shared<VerletList>();
+	list->skin = skin;
+	list->simCell = cellData;
+
+	// Count the neighbors of each particle within the extended cutoff radius, using the bin grid.
+	list->offsets.resize(particles.size() + 1);
+	list->offsets[0] = 0;
+	parallelForChunks(particles.size(), [&](size_t startIndex, size_t count) {
+		for(size_t index = startIndex; index < startIndex + count; index++) {
+			if(promise && promise->isCanceled())
+				return;
+			size_t neighborCount = 0;
+			for(Query neighQuery(*this, index); !neighQuery.atEnd(); neighQuery.next())
+				neighborCount++;
+			list->offsets[index + 1] = neighborCount;
+		}
+	});
+	if(promise && promise->isCanceled())
+		return false;
+	std::partial_sum(list->offsets.begin(), list->offsets.end(), list->offsets.begin());
+
+	// Store the neighbors. Each particle's list keeps the order in which the bin grid reports them.
+	list->neighbors.resize(list->offsets.back());
+	parallelForChunks(particles.size(), [&](size_t startIndex, size_t count) {
+		for(size_t index = startIndex; index < startIndex + count; index++) {
+			if(promise && promise->isCanceled())
+				return;
+			VerletNeighbor* entry = list->neighbors.data() + list->offsets[index];
+			for(Query neighQuery(*this, index); !neighQuery.atEnd(); neighQuery.next(), ++entry) {
+				entry->index = neighQuery.current();
+				for(size_t k = 0; k < 3; k++) {
+					OVITO_ASSERT(std::abs(neighQuery.pbcShift()[k]) <= std::numeric_limits<int8_t>::max());
+					entry->pbcShift[k] = (int8_t)neighQuery.pbcShift()[k];
+				}
 			}
-			OVITO_ASSERT(binLocation[k] >= 0 && binLocation[k] < binDim[k]);
 		}
+	});
+	if(promise && promise->isCanceled())
+		return false;
 
-		// Put particle into its bin.
-		size_t binIndex = binLocation[0] + binLocation[1]*binDim[0] + binLocation[2]*binDim[0]*binDim[1];
-		a.nextInBin = bins[binIndex];
-		bins[binIndex] = &a;
-	}
+	list->buildPositions.resize(particles.size());
+	for(size_t index = 0; index < particles.size(); index++)
+		list->buildPositions[index] = particles[index].pos;
+
+	// From now on, queries are answered from the list. The bin grid is no longer needed.
+	_cutoffRadius = cutoffRadius;
+	_cutoffRadiusSquared = cutoffRadius * cutoffRadius;
+	_verletList = std::move(list);
+	decltype(binnedParticles){}.swap(binnedParticles);
+	decltype(bins){}.swap(bins);
+	decltype(stencil){}.swap(stencil);
+
+	return true;
+}
+
+/******************************************************************************
+* Prepares the neighbor finder for new particle positions by reusing the
+* Verlet list of another finder.
+******************************************************************************/
+bool CutoffNeighborFinder::reuseVerletList(const CutoffNeighborFinder& previous, const PropertyStorage& positions, const SimulationCell& cellData, PromiseState* promise)
+{
+	OVITO_ASSERT(!previous._superset);
+	const std::shared_ptr<const VerletList>& list = previous._verletList;
+	if(!list || positions.size() != list->buildPositions.size() || !(cellData == list->simCell))
+		return false;
+
+	_cutoffRadius = previous._cutoffRadius;
+	_cutoffRadiusSquared = previous._cutoffRadiusSquared;
+	simCell = previous.simCell;
+	_superset.reset();
+
+	// Measure the displacement of each particle since the list was built. A particle that has crossed a periodic
+	// boundary is mapped back to the periodic image closest to its position in the list, which keeps the stored
+	// neighbor images valid. The list remains complete as long as no particle has moved by half the skin distance.
+	FloatType maxDisplacementSquared = list->skin * list->skin / 4;
+	const AffineTransformation& cellMatrix = simCell.matrix();
+	const AffineTransformation& inverseCellMatrix = simCell.inverseMatrix();
+	const Point3* p = positions.constDataPoint3();
+	particles.resize(positions.size());
+	std::atomic<bool> exceeded(false);
+	parallelForChunks(particles.size(), [&](size_t startIndex, size_t count) {
+		for(size_t index = startIndex; index < startIndex + count; index++) {
+			if(exceeded.load(std::memory_order_relaxed) || (promise && promise->isCanceled()))
+				return;
+			Vector3 displacement = p[index] - list->buildPositions[index];
+			Vector3 reducedDisplacement = inverseCellMatrix * displacement;
+			NeighborListParticle& a = particles[index];
+			a.pbcShift.setZero();
+			for(size_t k = 0; k < 3; k++) {
+				if(simCell.pbcFlags()[k]) {
+					a.pbcShift[k] = -(int)std::floor(reducedDisplacement[k] + FloatType(0.5));
+					displacement += (FloatType)a.pbcShift[k] * cellMatrix.column(k);
+				}
+			}
+			if(displacement.squaredLength() >= maxDisplacementSquared) {
+				exceeded.store(true, std::memory_order_relaxed);
+				return;
+			}
+			a.pos = list->buildPositions[index] + displacement;
+		}
+	});
+	if(exceeded.load() || (promise && promise->isCanceled()))
+		return false;
 
+	_verletList = list;
 	return true;
 }
 
@@ -214,16 +436,25 @@ bool CutoffNeighborFinder::prepare(FloatType cutoffRadius, const PropertyStorage
 * Iterator constructor
 ******************************************************************************/
 CutoffNeighborFinder::Query::Query(const CutoffNeighborFinder& finder, size_t particleIndex)
-	: _builder(finder), _centerIndex(particleIndex)
+	: _builder(finder.grid()), _cutoffRadiusSquared(finder.cutoffRadiusSquared()), _centerIndex(particleIndex)
 {
 	OVITO_ASSERT(particleIndex < _builder.particles.size());
 
 	_stencilIter = _builder.stencil.begin();
 	_neighbor = nullptr;
+	_neighborEnd = nullptr;
 	_atEnd = false;
 	_center = _builder.particles[particleIndex].pos;
 	_neighborIndex = std::numeric_limits<size_t>::max();
 
+	// Iterate over the stored neighbors in Verlet list mode.
+	if(_builder._verletList) {
+		_verletNeighbor = _builder._verletList->neighbors.data() + _builder._verletList->offsets[particleIndex];
+		_verletNeighborEnd = _builder._verletList->neighbors.data() + _builder._verletList->offsets[particleIndex + 1];
+		next();
+		return;
+	}
+
 	// Determine the bin the central particle is located in.
 	for(size_t k = 0; k < 3; k++) {
 		_centerBin[k] = (int)floor(_builder.reciprocalBinCell.prodrow(_center, k));
@@ -241,13 +472,28 @@ void CutoffNeighborFinder::Query::next()
 {
 	OVITO_ASSERT(!_atEnd);
 
+	if(_builder._verletList) {
+		while(_verletNeighbor != _verletNeighborEnd) {
+			_neighborIndex = _verletNeighbor->index;
+			_pbcShift = Vector3I(_verletNeighbor->pbcShift[0], _verletNeighbor->pbcShift[1], _verletNeighbor->pbcShift[2]);
+			++_verletNeighbor;
+			_delta = _builder.particles[_neighborIndex].pos - _center + _builder.simCell.matrix() * Vector3(_pbcShift);
+			_distsq = _delta.squaredLength();
+			if(_distsq <= _cutoffRadiusSquared)
+				return;
+		}
+		_atEnd = true;
+		_neighborIndex = std::numeric_limits<size_t>::max();
+		return;
+	}
+
 	for(;;) {
-		while(_neighbor) {
+		while(_neighbor != _neighborEnd) {
 			_delta = _neighbor->pos - _shiftedCenter;
-			_neighborIndex = _neighbor - _builder.particles.data();
-			_neighbor = _neighbor->nextInBin;
+			_neighborIndex = _neighbor->index;
+			++_neighbor;
 			_distsq = _delta.squaredLength();
-			if(_distsq <= _builder._cutoffRadiusSquared && (_neighborIndex != _centerIndex || _pbcShift != Vector3I::Zero()))
+			if(_distsq <= _cutoffRadiusSquared && (_neighborIndex != _centerIndex || _pbcShift != Vector3I::Zero()))
 				return;
 		};
 
@@ -287,7 +533,9 @@ void CutoffNeighborFinder::Query::next()
 			}
 			++_stencilIter;
 			if(!skipBin) {
-				_neighbor = _builder.bins[_currentBin[0] + _currentBin[1] * _builder.binDim[0] + _currentBin[2] * _builder.binDim[0] * _builder.binDim[1]];
+				const Bin& bin = _builder.bins[_currentBin[0] + _currentBin[1] * _builder.binDim[0] + _currentBin[2] * _builder.binDim[0] * _builder.binDim[1]];
+				_neighbor = bin.begin;
+				_neighborEnd = bin.end;
 				break;
 			}
 		}
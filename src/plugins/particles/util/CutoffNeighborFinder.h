@@ -40,7 +40,8 @@ namespace Ovito { namespace Particles { OVITO_BEGIN_INLINE_NAMESPACE(Util)
  *
  * The CutoffNeighborFinder class must be initialized by a call to prepare(). This function generates a grid of bin
  * cells whose size is on the order of the specified cutoff radius. It sorts all input particles into these bin cells
- * for fast neighbor queries.
+ * for fast neighbor queries. The wrapped particle coordinates are stored contiguously for each bin, and the bins
+ * are laid out in memory along a space-filling (Morton) curve, so that a query reads a few compact memory regions.
  *
  * After the CutoffNeighborFinder has been initialized, one can find the neighbors of some central
  * particle by constructing an instance of the CutoffNeighborFinder::Query class. This is a light-weight class which
@@ -60,8 +61,42 @@ private:
 		Point3 pos;
 		/// The offset applied to the particle when wrapping it at periodic boundaries.
 		Vector3I pbcShift;
-		/// Pointer to next particle in linked list.
-		const NeighborListParticle* nextInBin;
+	};
+
+	// An entry of the array of particles sorted by bin.
+	struct BinnedParticle {
+		/// The position of the particle, wrapped at periodic boundaries.
+		Point3 pos;
+		/// The index of the particle.
+		size_t index;
+	};
+
+	// The range of entries in the sorted particle array that belong to one bin.
+	struct Bin {
+		BinnedParticle* begin;
+		BinnedParticle* end;
+	};
+
+	// An entry of a Verlet neighbor list.
+	struct VerletNeighbor {
+		/// The index of the neighbor particle.
+		size_t index;
+		/// The periodic image of the neighbor particle. The stencil limits the shifts to small values.
+		std::array<int8_t,3> pbcShift;
+	};
+
+	// The neighbors of all particles within the cutoff radius plus the skin distance.
+	struct VerletList {
+		/// The extra distance beyond the cutoff radius.
+		FloatType skin;
+		/// The input simulation cell for which the list was built.
+		SimulationCell simCell;
+		/// The wrapped particle positions for which the list was built.
+		std::vector<Point3> buildPositions;
+		/// The start of the neighbors of each particle in the neighbors array.
+		std::vector<size_t> offsets;
+		/// The neighbors of all particles.
+		std::vector<VerletNeighbor> neighbors;
 	};
 
 public:
@@ -70,6 +105,10 @@ public:
 	/// You need to call prepare() first before the neighbor finder can be used.
 	CutoffNeighborFinder() = default;
 
+	/// Constructs a neighbor finder for a smaller cutoff radius, which reuses the bin grid of another, already prepared
+	/// neighbor finder. Queries skip the neighbors that are farther away than the new cutoff radius.
+	CutoffNeighborFinder(std::shared_ptr<const CutoffNeighborFinder> superset, FloatType cutoffRadius);
+
 	/// \brief Prepares the neighbor finder by sorting particles into a grid of bin cells.
 	/// \param cutoffRadius The cutoff radius for neighbor lists.
 	/// \param positions The property containing the particle coordinates.
@@ -81,6 +120,25 @@ public:
 	/// \throw Exception on error.
 	bool prepare(FloatType cutoffRadius, const PropertyStorage& positions, const SimulationCell& simCell, const PropertyStorage* selectionProperty, PromiseState* promise);
 
+	/// \brief Prepares the neighbor finder by building a Verlet list, which stores the neighbors of every particle
+	///        within the cutoff radius plus a skin distance.
+	///
+	/// Queries are answered from the list. The list can be reused for a later trajectory frame with reuseVerletList()
+	/// as long as no particle has moved farther than half the skin distance.
+	/// \return \c false when the operation has been canceled by the user.
+	/// \throw Exception on error.
+	bool prepareVerletList(FloatType cutoffRadius, FloatType skin, const PropertyStorage& positions, const SimulationCell& simCell, const PropertyStorage* selectionProperty, PromiseState* promise);
+
+	/// \brief Prepares the neighbor finder for new particle positions by reusing the Verlet list of another finder.
+	///
+	/// The particles must be stored in the same order as in the configuration for which the list was built,
+	/// and the simulation cell must be the same.
+	/// \return \c false if the list cannot be reused, because a particle has moved too far, or when the operation has been canceled.
+	bool reuseVerletList(const CutoffNeighborFinder& previous, const PropertyStorage& positions, const SimulationCell& simCell, PromiseState* promise);
+
+	/// Returns the skin distance of the Verlet list, or zero if the finder does not use a Verlet list.
+	FloatType verletSkin() const { return grid()._verletList ? grid()._verletList->skin : 0; }
+
 	/// Returns the cutoff radius set via prepare().
 	FloatType cutoffRadius() const { return _cutoffRadius; }
 
@@ -131,13 +189,17 @@ public:
 	private:
 
 		const CutoffNeighborFinder& _builder;
+		FloatType _cutoffRadiusSquared;
 		bool _atEnd;
 		Point3 _center, _shiftedCenter;
 		size_t _centerIndex;
 		std::vector<Vector3I>::const_iterator _stencilIter;
 		Point3I _centerBin;
 		Point3I _currentBin;
-		const NeighborListParticle* _neighbor;
+		const BinnedParticle* _neighbor;
+		const BinnedParticle* _neighborEnd;
+		const VerletNeighbor* _verletNeighbor;
+		const VerletNeighbor* _verletNeighborEnd;
 		size_t _neighborIndex;
 		Vector3I _pbcShift;
 		Vector3 _delta;
@@ -146,6 +208,9 @@ public:
 
 private:
 
+	/// Returns the neighbor finder that holds the bin grid.
+	const CutoffNeighborFinder& grid() const { return _superset ? *_superset : *this; }
+
 	/// The neighbor criterion.
 	FloatType _cutoffRadius = 0;
 
@@ -164,12 +229,21 @@ private:
 	/// The internal list of particles.
 	std::vector<NeighborListParticle> particles;
 
-	/// An 3d array of cubic bins. Each bin is a linked list of particles.
-	std::vector<const NeighborListParticle*> bins;
+	/// The selected particles sorted by bin. The bins are ordered along a space-filling curve.
+	std::vector<BinnedParticle> binnedParticles;
+
+	/// An 3d array of cubic bins. Each bin refers to a contiguous range of binnedParticles.
+	std::vector<Bin> bins;
 
 	/// The list of adjacent cells to visit while finding the neighbors of a
 	/// central particle.
 	std::vector<Vector3I> stencil;
+
+	/// The neighbor finder whose bin grid is used instead of an own one.
+	std::shared_ptr<const CutoffNeighborFinder> _superset;
+
+	/// The Verlet list, which replaces the bin grid if present. It is shared by the finders of several trajectory frames.
+	std::shared_ptr<const VerletList> _verletList;
 };
 
 OVITO_END_INLINE_NAMESPACE
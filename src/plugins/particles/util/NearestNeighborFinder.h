@@ -159,6 +159,10 @@ public:
 		/// Constructor.
 		Query(const NearestNeighborFinder& finder) : t(finder), queue(finder.numNeighbors) {}
 
+		/// Constructor for a query that finds a different number of neighbors than the finder was prepared for.
+		/// This allows sharing a finder between several users.
+		Query(const NearestNeighborFinder& finder, int numNeighbors) : t(finder), queue(numNeighbors) {}
+
 		/// Builds the sorted list of neighbors around the given particle.
 		void findNeighbors(size_t particleIndex) {
 			findNeighbors(t.particlePos(particleIndex), false);
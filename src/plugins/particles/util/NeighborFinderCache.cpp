@@ -0,0 +1,227 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (2018) Alexander Stukowski
+//
+//  This file is part of OVITO (Open Visualization Tool).
+//
+//  OVITO is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  OVITO is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <plugins/particles/Particles.h>
+#include "NeighborFinderCache.h"
+
+#include <cstdint>
+#include <cstring>
+#include <deque>
+
+namespace Ovito { namespace Particles { OVITO_BEGIN_INLINE_NAMESPACE(Util)
+
+namespace {
+	/// The maximum number of neighbor finders kept in the cache.
+	constexpr size_t MaxCachedFinders = 4;
+	/// A cached finder is reused for a smaller cutoff radius only up to this ratio of the radii.
+	/// Beyond that, queries would skip so many particles of the larger bins that preparing a new finder is faster.
+	constexpr FloatType MaxCutoffRatio = 1.25;
+
+	/// Checks whether a weak reference and an optional storage refer to the same array in the same revision.
+	/// Comparing the owners never confuses an array that has been released with a new one allocated at the same address.
+	bool isSameArray(const std::weak_ptr<const PropertyStorage>& ref, unsigned int revision, const ConstPropertyPtr& property) {
+		return !ref.owner_before(property) && !property.owner_before(ref) && (!property || property->revision() == revision);
+	}
+
+	/// A prepared neighbor finder and the inputs it was prepared for.
+	/// The input arrays are only referenced weakly, so that the cache neither keeps them alive nor forces modifications to go to a copy.
+	struct CacheEntry {
+		std::weak_ptr<const PropertyStorage> positions;
+		unsigned int positionsRevision;
+		SimulationCell simCell;
+		std::weak_ptr<const PropertyStorage> selection;
+		unsigned int selectionRevision;
+		size_t particleCount;
+		/// Hash values of the particle identifiers and the selection, which identify the particles of a trajectory frame for reusing a Verlet list.
+		std::uint64_t identifiersHash;
+		std::uint64_t selectionHash;
+		std::shared_ptr<const CutoffNeighborFinder> cutoffFinder;
+		std::shared_ptr<const NearestNeighborFinder> nearestFinder;
+
+		CacheEntry(const ConstPropertyPtr& positions, const SimulationCell& simCell, const ConstPropertyPtr& selection, std::uint64_t identifiersHash, std::uint64_t selectionHash,
+				std::shared_ptr<const CutoffNeighborFinder> cutoffFinder, std::shared_ptr<const NearestNeighborFinder> nearestFinder) :
+			positions(positions), positionsRevision(positions->revision()), simCell(simCell),
+			selection(selection), selectionRevision(selection ? selection->revision() : 0), particleCount(positions->size()),
+			identifiersHash(identifiersHash), selectionHash(selectionHash), cutoffFinder(std::move(cutoffFinder)), nearestFinder(std::move(nearestFinder)) {}
+
+		bool matches(const ConstPropertyPtr& p, const SimulationCell& c, const ConstPropertyPtr& s) const {
+			return isSameArray(positions, positionsRevision, p) && isSameArray(selection, selectionRevision, s) && simCell == c;
+		}
+
+		/// Returns whether the entry can still be used after the particle positions it was prepared for have been released.
+		/// Only a Verlet list can be carried over to another trajectory frame, and only if the particle identifiers are known.
+		bool isReusable() const {
+			return !positions.expired() || (cutoffFinder && cutoffFinder->verletSkin() > 0 && identifiersHash != 0);
+		}
+	};
+
+	/// The cached entries, ordered from most to least recently used.
+	std::mutex cacheMutex;
+	std::deque<CacheEntry> cacheEntries;
+
+	/// Computes a hash value of the contents of an optional property array.
+	std::uint64_t contentHash(const ConstPropertyPtr& property) {
+		std::uint64_t hash = 0xcbf29ce484222325ull;
+		if(!property) return hash;
+		auto mix = [&hash](std::uint64_t value) {
+			hash = (hash ^ value) * 0x100000001b3ull;
+			hash ^= hash >> 32;
+		};
+		mix(property->size());
+		mix(property->dataType());
+		const uint8_t* bytes = static_cast<const uint8_t*>(property->constData());
+		size_t byteCount = property->size() * property->stride();
+		size_t i = 0;
+		for(; i + sizeof(std::uint64_t) <= byteCount; i += sizeof(std::uint64_t)) {
+			std::uint64_t word;
+			std::memcpy(&word, bytes + i, sizeof(word));
+			mix(word);
+		}
+		for(; i < byteCount; i++)
+			mix(bytes[i]);
+		return hash;
+	}
+
+	/// Discards entries that can no longer be used, as well as all but the most recently used entry
+	/// whose particle positions have been released. Must be called with the mutex locked.
+	void purgeEntries() {
+		bool keptReleasedEntry = false;
+		for(auto entry = cacheEntries.begin(); entry != cacheEntries.end(); ) {
+			bool released = entry->positions.expired();
+			if(!entry->isReusable() || (released && keptReleasedEntry)) {
+				entry = cacheEntries.erase(entry);
+			}
+			else {
+				keptReleasedEntry |= released;
+				++entry;
+			}
+		}
+	}
+
+	/// Inserts a new entry into the cache and discards the least recently used one if the cache is full.
+	void insertEntry(CacheEntry entry) {
+		std::lock_guard<std::mutex> lock(cacheMutex);
+		cacheEntries.push_front(std::move(entry));
+		purgeEntries();
+		if(cacheEntries.size() > MaxCachedFinders)
+			cacheEntries.pop_back();
+	}
+}
+
+/******************************************************************************
+* Returns a neighbor finder for the given cutoff radius.
+******************************************************************************/
+std::shared_ptr<const CutoffNeighborFinder> NeighborFinderCache::cutoffNeighborFinder(FloatType cutoffRadius, const ConstPropertyPtr& positions,
+		const SimulationCell& simCell, const ConstPropertyPtr& selection, PromiseState* promise,
+		FloatType verletSkin, const ConstPropertyPtr& identifiers)
+{
+	// Look for the finder with the smallest sufficient cutoff radius.
+	{
+		std::lock_guard<std::mutex> lock(cacheMutex);
+		purgeEntries();
+		auto best = cacheEntries.end();
+		for(auto entry = cacheEntries.begin(); entry != cacheEntries.end(); ++entry) {
+			if(!entry->cutoffFinder || !entry->matches(positions, simCell, selection)) continue;
+			FloatType radius = entry->cutoffFinder->cutoffRadius();
+			if(radius >= cutoffRadius && radius <= cutoffRadius * MaxCutoffRatio && (best == cacheEntries.end() || radius < best->cutoffFinder->cutoffRadius()))
+				best = entry;
+		}
+		if(best != cacheEntries.end()) {
+			std::shared_ptr<const CutoffNeighborFinder> finder = best->cutoffFinder;
+			CacheEntry entry = std::move(*best);
+			cacheEntries.erase(best);
+			cacheEntries.push_front(std::move(entry));
+			if(finder->cutoffRadius() == cutoffRadius)
+				return finder;
+			return std::make_shared<CutoffNeighborFinder>(std::move(finder), cutoffRadius);
+		}
+	}
+
+	// In Verlet list mode, try to reuse the list of an earlier trajectory frame. Without identifiers, there is
+	// no way to tell whether the particles are stored in the same order. The hash values are computed outside
+	// of the lock, because they take a while for large numbers of particles. Should two different sets of
+	// identifiers have the same hash value, the list is still rebuilt when the particles turn out to have moved too far.
+	std::uint64_t identifiersHash = 0, selectionHash = 0;
+	if(verletSkin > 0 && identifiers) {
+		identifiersHash = contentHash(identifiers);
+		selectionHash = contentHash(selection);
+		std::vector<std::shared_ptr<const CutoffNeighborFinder>> candidates;
+		{
+			std::lock_guard<std::mutex> lock(cacheMutex);
+			for(const CacheEntry& entry : cacheEntries) {
+				if(entry.cutoffFinder && entry.cutoffFinder->verletSkin() == verletSkin && entry.cutoffFinder->cutoffRadius() == cutoffRadius
+						&& entry.particleCount == positions->size() && entry.identifiersHash == identifiersHash && entry.selectionHash == selectionHash)
+					candidates.push_back(entry.cutoffFinder);
+			}
+		}
+		for(const auto& candidate : candidates) {
+			auto finder = std::make_shared<CutoffNeighborFinder>();
+			if(finder->reuseVerletList(*candidate, *positions, simCell, promise)) {
+				insertEntry(CacheEntry(positions, simCell, selection, identifiersHash, selectionHash, finder, {}));
+				return finder;
+			}
+			if(promise && promise->isCanceled())
+				return {};
+		}
+	}
+
+	// Prepare a new finder outside of the lock.
+	auto finder = std::make_shared<CutoffNeighborFinder>();
+	if(verletSkin > 0) {
+		if(!finder->prepareVerletList(cutoffRadius, verletSkin, *positions, simCell, selection.get(), promise))
+			return {};
+	}
+	else if(!finder->prepare(cutoffRadius, *positions, simCell, selection.get(), promise))
+		return {};
+	insertEntry(CacheEntry(positions, simCell, selection, identifiersHash, selectionHash, finder, {}));
+	return finder;
+}
+
+/******************************************************************************
+* Returns a nearest neighbor finder.
+******************************************************************************/
+std::shared_ptr<const NearestNeighborFinder> NeighborFinderCache::nearestNeighborFinder(int numNeighbors, const ConstPropertyPtr& positions,
+		const SimulationCell& simCell, const ConstPropertyPtr& selection, PromiseState* promise)
+{
+	{
+		std::lock_guard<std::mutex> lock(cacheMutex);
+		purgeEntries();
+		for(auto entry = cacheEntries.begin(); entry != cacheEntries.end(); ++entry) {
+			if(entry->nearestFinder && entry->matches(positions, simCell, selection)) {
+				std::shared_ptr<const NearestNeighborFinder> finder = entry->nearestFinder;
+				CacheEntry hit = std::move(*entry);
+				cacheEntries.erase(entry);
+				cacheEntries.push_front(std::move(hit));
+				return finder;
+			}
+		}
+	}
+
+	auto finder = std::make_shared<NearestNeighborFinder>(numNeighbors);
+	if(!finder->prepare(*positions, simCell, selection.get(), promise))
+		return {};
+	insertEntry(CacheEntry(positions, simCell, selection, 0, 0, {}, finder));
+	return finder;
+}
+
+OVITO_END_INLINE_NAMESPACE
+}	// End of namespace
+}	// End of namespace
@@ -0,0 +1,82 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (2018) Alexander Stukowski
+//
+//  This file is part of OVITO (Open Visualization Tool).
+//
+//  OVITO is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  OVITO is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+
+#include <plugins/particles/Particles.h>
+#include <plugins/stdobj/properties/PropertyStorage.h>
+#include <plugins/stdobj/simcell/SimulationCell.h>
+#include <core/utilities/concurrent/PromiseState.h>
+#include "CutoffNeighborFinder.h"
+#include "NearestNeighborFinder.h"
+
+namespace Ovito { namespace Particles { OVITO_BEGIN_INLINE_NAMESPACE(Util)
+
+/**
+ * \brief Shares prepared neighbor finders between the compute engines of several modifiers.
+ *
+ * Modifiers in a pipeline often search the neighbors of the same set of particles. This class keeps the
+ * most recently prepared neighbor finders, so that the engines of later modifiers can reuse them instead of
+ * sorting the particles again. A finder is identified by the storage of the particle positions,
+ * the simulation cell, and the storage of the particle selection.
+ *
+ * A cached entry refers to the positions and selection storages only weakly and remembers their revision numbers
+ * (see PropertyStorage::revision()), so a finder never describes particles that have moved since it was prepared.
+ * The cache thus keeps no input arrays alive and does not force modifications of them to go to a copy. An entry is
+ * discarded as soon as its particle positions have been released, because it can never be used again. The only exception
+ * is the most recently used Verlet list, which may be carried over to the next trajectory frame.
+ * Only a small number of entries is kept.
+ *
+ * Cutoff neighbor finders can optionally be requested in Verlet list mode. The neighbor list of a
+ * previous trajectory frame is then reused for new particle positions, provided that the particle identifiers,
+ * the selection and the simulation cell are the same and no particle has moved farther than half the skin distance.
+ */
+class OVITO_PARTICLES_EXPORT NeighborFinderCache
+{
+public:
+
+	/// \brief Returns a neighbor finder for the given cutoff radius, which has been prepared for the given particles.
+	///
+	/// A cached finder with a slightly larger cutoff radius is reused. Its bins are shared by the returned finder,
+	/// which skips the neighbors beyond the requested cutoff radius.
+	/// If \a verletSkin is positive, the finder uses a Verlet list with the given skin distance, which may be
+	/// taken over from an earlier trajectory frame. A hash value of the particle identifiers serves to verify that the
+	/// particles are stored in the same order as in that frame; without them, the list is always rebuilt.
+	/// \return The prepared neighbor finder, or null when the operation has been canceled.
+	/// \throw Exception on error.
+	static std::shared_ptr<const CutoffNeighborFinder> cutoffNeighborFinder(FloatType cutoffRadius, const ConstPropertyPtr& positions,
+			const SimulationCell& simCell, const ConstPropertyPtr& selection, PromiseState* promise,
+			FloatType verletSkin = 0, const ConstPropertyPtr& identifiers = {});
+
+	/// \brief Returns a nearest neighbor finder, which has been prepared for the given particles.
+	///
+	/// The finder may have been prepared for a different number of neighbors. Queries must therefore
+	/// specify the number of neighbors to find explicitly.
+	/// \return The prepared neighbor finder, or null when the operation has been canceled.
+	/// \throw Exception on error.
+	static std::shared_ptr<const NearestNeighborFinder> nearestNeighborFinder(int numNeighbors, const ConstPropertyPtr& positions,
+			const SimulationCell& simCell, const ConstPropertyPtr& selection, PromiseState* promise);
+};
+
+OVITO_END_INLINE_NAMESPACE
+}	// End of namespace
+}	// End of namespace
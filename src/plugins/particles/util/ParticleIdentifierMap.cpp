@@ -0,0 +1,101 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (2018) Alexander Stukowski
+//
+//  This file is part of OVITO (Open Visualization Tool).
+//
+//  OVITO is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  OVITO is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <plugins/particles/Particles.h>
+#include <core/utilities/concurrent/ParallelFor.h>
+#include "ParticleIdentifierMap.h"
+
+namespace Ovito { namespace Particles { OVITO_BEGIN_INLINE_NAMESPACE(Util)
+
+/******************************************************************************
+* Fills the map with the given list of particle identifiers.
+******************************************************************************/
+bool ParticleIdentifierMap::build(ConstPropertyPtr identifiers, PromiseState& promise)
+{
+	_identifiers = std::move(identifiers);
+	_hasDuplicates = false;
+	size_t count = _identifiers->size();
+	const qlonglong* ids = _identifiers->constDataInt64();
+
+	// Determine the range of identifiers.
+	_minId = std::numeric_limits<qlonglong>::max();
+	_maxId = std::numeric_limits<qlonglong>::lowest();
+	std::mutex rangeMutex;
+	if(!parallelForChunks(count, promise, [&](size_t startIndex, size_t chunkSize, PromiseState&) {
+			auto range = std::minmax_element(ids + startIndex, ids + startIndex + chunkSize);
+			std::lock_guard<std::mutex> lock(rangeMutex);
+			_minId = std::min(_minId, *range.first);
+			_maxId = std::max(_maxId, *range.second);
+		}))
+		return false;
+
+	// Index the table directly by the identifier if this takes no more than two slots per particle.
+	// Otherwise use a hash table with a load factor between 1/4 and 1/2.
+	size_t tableSize;
+	if(count == 0) {
+		_isDense = true;
+		tableSize = 0;
+	}
+	else if((unsigned long long)_maxId - (unsigned long long)_minId < 2 * (unsigned long long)count) {
+		_isDense = true;
+		tableSize = (size_t)((unsigned long long)_maxId - (unsigned long long)_minId) + 1;
+	}
+	else {
+		_isDense = false;
+		tableSize = 1;
+		while(tableSize < 2 * count)
+			tableSize *= 2;
+		_mask = tableSize - 1;
+	}
+	_slots.reset(new std::atomic<size_t>[tableSize]);
+	parallelFor(tableSize, [this](size_t i) {
+		_slots[i].store(0, std::memory_order_relaxed);
+	});
+
+	// Insert the particles. A slot is claimed with a compare-and-swap; a particle that finds its
+	// identifier already present in the table is a duplicate.
+	std::atomic<bool> hasDuplicates(false);
+	bool completed = parallelFor(count, promise, [&](size_t index) {
+		qlonglong id = ids[index];
+		if(_isDense) {
+			size_t expected = 0;
+			if(!_slots[(unsigned long long)id - (unsigned long long)_minId].compare_exchange_strong(expected, index + 1, std::memory_order_relaxed))
+				hasDuplicates.store(true, std::memory_order_relaxed);
+			return;
+		}
+		for(size_t slot = hash(id) & _mask; ; slot = (slot + 1) & _mask) {
+			size_t expected = 0;
+			if(_slots[slot].compare_exchange_strong(expected, index + 1, std::memory_order_relaxed))
+				break;
+			if(ids[expected - 1] == id) {
+				hasDuplicates.store(true, std::memory_order_relaxed);
+				break;
+			}
+		}
+	});
+	_hasDuplicates = hasDuplicates.load();
+
+	return completed;
+}
+
+OVITO_END_INLINE_NAMESPACE
+}	// End of namespace
+}	// End of namespace
@@ -0,0 +1,100 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (2018) Alexander Stukowski
+//
+//  This file is part of OVITO (Open Visualization Tool).
+//
+//  OVITO is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  OVITO is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+
+#include <plugins/particles/Particles.h>
+#include <plugins/stdobj/properties/PropertyStorage.h>
+#include <core/utilities/concurrent/PromiseState.h>
+
+namespace Ovito { namespace Particles { OVITO_BEGIN_INLINE_NAMESPACE(Util)
+
+/**
+ * \brief Lookup table that maps unique particle identifiers to particle indices.
+ *
+ * If the identifiers occupy a compact range of values, the table is indexed directly by the identifier.
+ * Otherwise an open-addressing hash table is used. In both cases the table is filled in parallel.
+ * The slots of the table store particle indices only; the identifiers are looked up in the
+ * property storage, which is kept alive by the map.
+ */
+class OVITO_PARTICLES_EXPORT ParticleIdentifierMap
+{
+public:
+
+	/// Fills the map with the given list of particle identifiers.
+	/// Returns false if the operation has been canceled.
+	bool build(ConstPropertyPtr identifiers, PromiseState& promise);
+
+	/// Returns the particle identifiers from which the map was built.
+	const ConstPropertyPtr& identifiers() const { return _identifiers; }
+
+	/// Returns whether the same identifier occurs more than once in the list.
+	bool hasDuplicates() const { return _hasDuplicates; }
+
+	/// Returns the index of the particle with the given identifier,
+	/// or std::numeric_limits<size_t>::max() if there is no such particle.
+	size_t find(qlonglong id) const {
+		if(_isDense) {
+			if(id < _minId || id > _maxId) return std::numeric_limits<size_t>::max();
+			return _slots[(unsigned long long)id - (unsigned long long)_minId].load(std::memory_order_relaxed) - 1;
+		}
+		const qlonglong* ids = _identifiers->constDataInt64();
+		for(size_t slot = hash(id) & _mask; ; slot = (slot + 1) & _mask) {
+			size_t entry = _slots[slot].load(std::memory_order_relaxed);
+			if(entry == 0) return std::numeric_limits<size_t>::max();
+			if(ids[entry - 1] == id) return entry - 1;
+		}
+	}
+
+private:
+
+	/// Scrambles the bits of an identifier to spread consecutive values over the hash table.
+	static size_t hash(qlonglong id) {
+		unsigned long long x = (unsigned long long)id;
+		x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+		x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+		return (size_t)(x ^ (x >> 31));
+	}
+
+	/// The particle identifiers.
+	ConstPropertyPtr _identifiers;
+
+	/// The table slots, which store particle indices plus one. Zero marks an empty slot.
+	std::unique_ptr<std::atomic<size_t>[]> _slots;
+
+	/// Indicates that the table is indexed directly by the identifier.
+	bool _isDense = false;
+
+	/// The bit mask applied to hash values.
+	size_t _mask = 0;
+
+	/// The range of identifiers.
+	qlonglong _minId = 0;
+	qlonglong _maxId = -1;
+
+	/// Indicates that the list of identifiers contains duplicates.
+	bool _hasDuplicates = false;
+};
+
+OVITO_END_INLINE_NAMESPACE
+}	// End of namespace
+}	// End of namespace
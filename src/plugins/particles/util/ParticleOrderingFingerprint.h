@@ -46,6 +46,9 @@ public:
 	/// Returns the number of particles for which this object was constructed.
 	size_t particleCount() const { return _particleCount; }
 
+	/// Returns the particle identifiers for which this object was constructed (may be null).
+	const ConstPropertyPtr& particleIdentifiers() const { return _particleIdentifiers; }
+
 	/// Returns true if the particle number and the storage order have changed 
 	/// with respect to the state from which this object was constructed.
 	bool hasChanged(const ParticlesObject* particles) const {
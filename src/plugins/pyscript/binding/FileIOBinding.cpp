@@ -28,6 +28,7 @@
 #include <core/dataset/io/AttributeFileExporter.h>
 #include <core/dataset/DataSetContainer.h>
 #include <core/utilities/io/FileManager.h>
+#include <core/utilities/io/CompressedTextReader.h>
 #include <core/utilities/concurrent/TaskManager.h>
 #include "PythonBinding.h"
 
@@ -59,6 +60,8 @@ void defineIOSubmodule(py::module m)
 	;
 
 	ovito_abstract_class<FileSourceImporter, FileImporter>{m}
+		// Used by the test suite to record decompression checkpoints of gzipped files at short distances:
+		.def_static("_set_gzip_checkpoint_interval", &CompressedTextReader::setCheckpointInterval)
 	;
 
 	ovito_abstract_class<FileExporter, RefTarget>(m)
@@ -70,6 +73,7 @@ void defineIOSubmodule(py::module m)
 		.def_property("end_frame", &FileExporter::endFrame, &FileExporter::setEndFrame)
 		.def_property("every_nth_frame", &FileExporter::everyNthFrame, &FileExporter::setEveryNthFrame)
 		.def_property("precision", &FileExporter::floatOutputPrecision, &FileExporter::setFloatOutputPrecision)
+		.def_property("frames_in_flight", &FileExporter::framesInFlight, &FileExporter::setFramesInFlight)
 		
 		// These are required by implementation of export_file():
 		.def_property("pipeline", &FileExporter::nodeToExport, &FileExporter::setNodeToExport)
@@ -143,6 +147,8 @@ void defineIOSubmodule(py::module m)
 			auto future = fs.requestFrameList(false, false);
 			return ScriptEngine::getCurrentDataset()->taskManager().waitForTask(future);
 		})
+		// Used by the test suite to observe the source frames being loaded ahead of time:
+		.def_property_readonly("_prefetched_frames", &FileSource::prefetchedFrames)
 		.def_property_readonly("num_frames", &FileSource::numberOfFrames,
 				"This read-only attribute reports the number of frames found in the input file or sequence of input files. "
 				"The data for the individual frames can be obtained using the :py:meth:`.compute` method.")
@@ -509,6 +509,14 @@ void defineSceneSubmodule(py::module m)
 				"This typically is a :py:class:`FileSource` instance if the pipeline was created by a call to :py:func:`~ovito.io.import_file`. "
 				"You can assign a new source to the pipeline if needed. See the :py:mod:`ovito.pipeline` module for a list of available pipeline source types. "
 				"Note that you can even make several pipelines share the same source object. ")
+		.def_property_static("cache_memory_budget", [](py::object) { return PipelineCache::memoryBudget(); },
+				[](py::object, size_t bytes) { PipelineCache::setMemoryBudget(bytes, false); },
+				"The amount of memory (in bytes) that all pipelines together may use for keeping the results of animation frames "
+				"other than the most recently computed one. Frames are dropped from the caches when this limit is exceeded, "
+				"preferring to keep frames that were expensive to compute. A value of zero turns off the caching of additional frames. "
+				"Changing this value affects the current program session only; the default is set in the application settings."
+				"\n\n"
+				":Default: 536870912\n")
 		
 		// Required by implementation of Pipeline.compute():
 		.def("evaluate_pipeline", [](PipelineSceneNode& node, TimePoint time) {
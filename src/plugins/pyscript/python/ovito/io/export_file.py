@@ -89,6 +89,16 @@ def export_file(data, file, format, **params):
             for i in range(pipeline.source.num_frames):
                 export_file(pipeline, "output.%i.dump" % i, "lammps/dump", frame=i)
 
+        When exporting many frames, you can let OVITO process several frames at the same time by passing
+        the ``frames_in_flight`` keyword parameter. The pipeline is then evaluated for the next frames while
+        earlier frames are being written, and the *lammps/dump*, *lammps/data*, *xyz*, *imd*, *vasp* and *fhi-aims*
+        formats are formatted by several threads in parallel::
+
+            export_file(pipeline, "output.*.dump", "lammps/dump", multiple_frames=True, frames_in_flight=8)
+
+        Frames written to a single output file always appear in their original order. Keep in mind that up to twice as many frames
+        as specified are held in memory at the same time.
+
         **Floating-point formatting precision**
 
         For text-based file formats, you can set the desired formatting precision for floating-point numbers using the
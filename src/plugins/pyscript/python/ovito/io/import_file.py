@@ -95,6 +95,14 @@ def import_file(location, **params):
         reordering by passing the ``sort_particles=True`` option to :py:func:`!import_file`. Note that this option
         is without effect if the input file contains no particle identifiers.
 
+        **Parsed frame cache**
+
+        Parsing large text-based files (LAMMPS dump, XYZ and CFG formats) can take a long time. If the same files are loaded
+        repeatedly, e.g. by several analysis scripts, pass the ``cache_parsed_frames=True`` option to :py:func:`!import_file`.
+        OVITO then keeps each parsed frame in a binary file in the user's cache directory and loads it from there the next time,
+        as long as the input file has not been modified. Note that the cache files take up about as much disk space as the loaded data.
+        Once the cache exceeds 4 GB, the least recently used frames are deleted. Call :py:func:`clear_parsed_frame_cache` to empty it completely.
+
         **Topology and trajectory files**
 
         Some simulation codes write a *topology* file and separate *trajectory* file. The former contains only static information like the bonding
@@ -56,7 +56,13 @@ const PropertyPtr& PropertyObject::modifiableStorage()
 	OVITO_ASSERT(storage().use_count() >= 1);
 	if(storage().use_count() > 1)
 		_storage.mutableValue() = std::make_shared<PropertyStorage>(*storage());
+	else
+		storage()->incrementRevision();
 	OVITO_ASSERT(storage().use_count() == 1);
+	// The caller may hand the storage to several threads for writing. Copy an external buffer now rather than
+	// on the first write access.
+	if(storage()->hasExternalData())
+		storage()->detachExternalData();
 	return storage();
 }
 
@@ -550,6 +550,13 @@ public:
 	/// Returns the display title of this property object in the user interface.
 	virtual QString objectTitle() const override;
 
+	/// Reports the property storage, which may be shared with other property objects, to the pipeline cache.
+	/// Memory-mapped file data does not count against the memory budget.
+	virtual void collectMemoryBuffers(std::vector<std::pair<const void*, size_t>>& buffers) const override {
+		if(storage())
+			buffers.emplace_back(storage().get(), storage()->ownedMemorySize());
+	}
+
 protected:
 
 	/// Saves the class' contents to the given stream.
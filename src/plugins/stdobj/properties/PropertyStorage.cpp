@@ -51,6 +51,28 @@ PropertyStorage::PropertyStorage(size_t elementCount, int dataType, size_t compo
 	resize(elementCount, initializeMemory);
 }
 
+/******************************************************************************
+* Constructor that references an external memory buffer.
+******************************************************************************/
+PropertyStorage::PropertyStorage(size_t elementCount, int dataType, size_t componentCount, size_t stride, const QString& name, std::shared_ptr<const uint8_t> externalData, int type, QStringList componentNames) : 
+	PropertyStorage(0, dataType, componentCount, stride, name, false, type, std::move(componentNames))
+{
+	OVITO_ASSERT(externalData || elementCount == 0);
+	_numElements = elementCount;
+	_externalData = std::move(externalData);
+}
+
+/******************************************************************************
+* Copies the contents of the external buffer into memory owned by the storage.
+******************************************************************************/
+void PropertyStorage::detachExternalData()
+{
+	OVITO_ASSERT(_externalData);
+	_data.reset(new uint8_t[_numElements * _stride]);
+	std::memcpy(_data.get(), _externalData.get(), _numElements * _stride);
+	_externalData.reset();
+}
+
 /******************************************************************************
 * Copy constructor.
 ******************************************************************************/
@@ -65,7 +87,9 @@ PropertyStorage::PropertyStorage(const PropertyStorage& other) :
 	_componentNames(other._componentNames),
 	_data(new uint8_t[_numElements * _stride])
 {
-	memcpy(_data.get(), other._data.get(), _numElements * _stride);
+	// A copy is made to be modified, possibly by several threads at once. It therefore never shares
+	// an external buffer, which would have to be copied on the first write access.
+	memcpy(_data.get(), other.constData(), _numElements * _stride);
 }
 
 /******************************************************************************
@@ -86,7 +110,7 @@ void PropertyStorage::saveToStream(SaveStream& stream, bool onlyMetadata) const
 	}
 	else {
 		stream.writeSizeT(_numElements);
-		stream.write(_data.get(), _stride * _numElements);
+		stream.write(constData(), _stride * _numElements);
 	}
 	stream.endChunk();
 }
@@ -109,6 +133,7 @@ void PropertyStorage::loadFromStream(LoadStream& stream)
 	stream.readSizeT(_componentCount);
 	stream >> _componentNames;
 	stream.readSizeT(_numElements);
+	_externalData.reset();
 	_data.reset(new uint8_t[_numElements * _stride]);
 	stream.read(_data.get(), _stride * _numElements);
 	stream.closeChunk();
@@ -151,8 +176,9 @@ void PropertyStorage::resize(size_t newSize, bool preserveData)
 {
 	std::unique_ptr<uint8_t[]> newBuffer(new uint8_t[newSize * _stride]);
 	if(preserveData)
-		std::memcpy(newBuffer.get(), _data.get(), _stride * std::min(_numElements, newSize));
+		std::memcpy(newBuffer.get(), constData(), _stride * std::min(_numElements, newSize));
 	_data.swap(newBuffer);
+	_externalData.reset();
 
 	// Initialize new elements to zero.
 	if(newSize > _numElements && preserveData) {
@@ -170,6 +196,9 @@ void PropertyStorage::filterResize(const boost::dynamic_bitset<>& mask)
 	OVITO_ASSERT(size() == mask.size());
 	size_t s = size();
 
+	// The filtering is done in place.
+	if(_externalData) detachExternalData();
+
 	// Optimize filter operation for the most common property types.
 	if(dataType() == PropertyStorage::Float && stride() == sizeof(FloatType)) {
 		// Single float
@@ -239,8 +268,8 @@ void PropertyStorage::filterResize(const boost::dynamic_bitset<>& mask)
 	}
 	else {
 		// Generic case:
-		const uint8_t* src = _data.get();
-		uint8_t* dst = _data.get();
+		uint8_t* dst = static_cast<uint8_t*>(data());
+		const uint8_t* src = dst;
 		for(size_t i = 0; i < s; i++, src += stride()) {
 			if(!mask.test(i)) {
 				memcpy(dst, src, stride());
@@ -317,8 +346,8 @@ void PropertyStorage::mappedCopy(const PropertyStorage& source, const std::vecto
 	}	
 	else {
 		// General case:
-		const uint8_t* src = source._data.get();
-		uint8_t* dst = _data.get();
+		const uint8_t* src = static_cast<const uint8_t*>(source.constData());
+		uint8_t* dst = static_cast<uint8_t*>(data());
 		for(size_t i = 0; i < source.size(); i++, src += stride()) {
 			OVITO_ASSERT(mapping[i] < this->size());
 			memcpy(dst + stride() * mapping[i], src, stride());
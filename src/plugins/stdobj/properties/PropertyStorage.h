@@ -73,7 +73,13 @@ public:
 	/// \brief Constructor that creates a property storage.
 	PropertyStorage(size_t elementCount, int dataType, size_t componentCount, size_t stride, const QString& name, bool initializeMemory, int type = 0, QStringList componentNames = QStringList());
 
-	/// \brief Copy constructor.
+	/// \brief Constructor that creates a property storage referencing an external, read-only memory buffer,
+	///        e.g. a memory-mapped region of a file. The shared pointer keeps the buffer alive.
+	///        The data gets copied into memory owned by the storage by detachExternalData() or when write access is
+	///        requested for the first time.
+	PropertyStorage(size_t elementCount, int dataType, size_t componentCount, size_t stride, const QString& name, std::shared_ptr<const uint8_t> externalData, int type = 0, QStringList componentNames = QStringList());
+
+	/// \brief Copy constructor. The copy always owns its elements, even if the original references an external buffer.
 	PropertyStorage(const PropertyStorage& other);
 
 	/// \brief Move constructor.
@@ -129,9 +135,24 @@ public:
 	
 	/// \brief Returns a read-only pointer to the raw elements stored in this property object.
 	const void* constData() const {
-		return _data.get();
+		return _externalData ? _externalData.get() : _data.get();
 	}
 
+	/// \brief Returns whether the elements are stored in an external buffer, which has not been copied yet.
+	bool hasExternalData() const { return (bool)_externalData; }
+
+	/// \brief Returns the number of bytes of heap memory owned by this storage.
+	size_t ownedMemorySize() const { return _externalData ? 0 : _numElements * _stride; }
+
+	/// \brief Returns a counter that is incremented whenever the storage is handed out for modification in place.
+	///
+	/// Together with the identity of the storage, the revision number identifies the current contents of the array.
+	/// It allows caches to refer to a storage without holding a reference to it.
+	unsigned int revision() const { return _revision; }
+
+	/// \brief Marks the elements of the storage as modified. PropertyObject::modifiableStorage() calls this method.
+	void incrementRevision() { _revision++; }
+
 	/// \brief Returns a read-only pointer to the first integer element stored in this object.
 	/// \note This method may only be used if this property is of data type int32.
 	const int* constDataInt() const {
@@ -281,8 +302,17 @@ public:
 		return boost::make_iterator_range(constDataQuaternion(), constDataQuaternion() + size());
 	}
 
+	/// \brief Copies the contents of the external buffer into memory owned by the storage.
+	///
+	/// The storage must not be accessed by other threads during this call. Code that lets several threads
+	/// write to a storage must call this method beforehand. PropertyObject::modifiableStorage() does so.
+	void detachExternalData();
+
 	/// Returns a read-write pointer to the raw elements in the property storage.
+	/// If the storage references an external buffer, its contents get copied first. This is not thread-safe;
+	/// see detachExternalData().
 	void* data() {
+		if(_externalData) detachExternalData();
 		return _data.get();
 	}
 
@@ -708,6 +738,12 @@ protected:
 
 	/// The internal data array that holds the elements.
 	std::unique_ptr<uint8_t[]> _data;
+
+	/// The external buffer holding the elements until write access is requested.
+	std::shared_ptr<const uint8_t> _externalData;
+
+	/// Counts the modifications of the storage in place.
+	unsigned int _revision = 0;
 };
 
 /// Typically, PropertyStorage objects are shallow copied. That's why we use a shared_ptr to hold on to them.
@@ -26,6 +26,7 @@
 #include <core/app/Application.h>
 #include <core/dataset/scene/PipelineSceneNode.h>
 #include <core/utilities/concurrent/Task.h>
+#include <core/utilities/concurrent/ThreadPool.h>
 #include <core/utilities/units/UnitsManager.h>
 #include "TachyonRenderer.h"
 
@@ -229,8 +230,9 @@ bool TachyonRenderer::renderFrame(FrameBuffer* frameBuffer, StereoRenderingTask
 
 	scenedef* scene = (scenedef*)_rtscene;
 
-	// Use only the number of parallel rendering threads allowed by the user. 
-	scene->numthreads = Application::instance()->idealThreadCount();
+	// Tachyon's own worker threads are not used. Instead, the image rows are traced by the threads of the global thread pool.
+	scene->numthreads = 1;
+	int numRngStreams = Application::instance()->idealThreadCount();
 
 	// If certain key aspects of the scene parameters have been changed
 	// since the last frame rendered, or when rendering the scene the
@@ -245,29 +247,61 @@ bool TachyonRenderer::renderFrame(FrameBuffer* frameBuffer, StereoRenderingTask
 	if(frameBuffer->image().format() != QImage::Format_ARGB32)
 		frameBuffer->image() = frameBuffer->image().convertToFormat(QImage::Format_ARGB32);
 
-	int tileHeight = 16;
-	int tileWidth = scene->numthreads * 4;
+	// Every thread tracing rays concurrently needs its own mailbox array for the grid acceleration structure.
+	// The ray serial number belongs to the mailbox and must keep increasing between uses.
+	// Such trace contexts are created on demand and recycled.
+	ThreadPool& threadPool = ThreadPool::instance();
+	const thr_parms& mainThreadParams = static_cast<thr_parms*>(scene->threadparms)[0];
+	std::deque<thr_parms> traceContexts;
+	std::deque<std::vector<unsigned long>> mailboxes;
+	std::vector<thr_parms*> freeTraceContexts;
+	std::mutex traceContextMutex;
+	auto acquireTraceContext = [&]() {
+		std::lock_guard<std::mutex> lock(traceContextMutex);
+		if(!freeTraceContexts.empty()) {
+			thr_parms* context = freeTraceContexts.back();
+			freeTraceContexts.pop_back();
+			return context;
+		}
+		traceContexts.push_back(mainThreadParams);
+		thr_parms* context = &traceContexts.back();
+		if(mainThreadParams.local_mbox != nullptr) {
+			mailboxes.emplace_back(scene->objgroup.numobjects + 32, 0);
+			context->local_mbox = mailboxes.back().data();
+		}
+		context->serialno = 1;
+		return context;
+	};
+
+	int tileHeight = std::max(16, threadPool.queueCount());
+	int tileWidth = threadPool.queueCount() * 4;
 	QTime renderTime;
 	renderTime.start();
 	for(int ystart = 0; ystart < scene->vres; ystart += tileHeight) {
 		for(int xstart = 0; xstart < scene->hres; ) {
 			int xstop = std::min(scene->hres, xstart + tileWidth);
 			int ystop = std::min(scene->vres, ystart + tileHeight);
-			thr_parms* threadparams = static_cast<thr_parms*>(scene->threadparms);
-			for(int thr = 0; thr < scene->numthreads; thr++) {
-				threadparams[thr].startx = 1 + xstart;
-				threadparams[thr].stopx  = xstop;
-				threadparams[thr].xinc   = 1;
-				threadparams[thr].starty = thr + 1 + ystart;
-				threadparams[thr].stopy  = ystop;
-				threadparams[thr].yinc   = scene->numthreads;
-			}
-
-			// If using threads, wake up the child threads...
-			rt_thread_barrier(threadparams[0].runbar, 1);
 
-			// Ray trace the image tile.
-			thread_trace(threadparams);
+			// Ray trace the rows of the image tile in parallel.
+			threadPool.parallelRange(ystop - ystart, 1, [&](size_t rowBegin, size_t rowEnd) {
+				thr_parms* context = acquireTraceContext();
+				thr_parms params = *context;
+				for(size_t row = rowBegin; row < rowEnd; row++) {
+					int y = ystart + (int)row + 1;
+					// The random number stream of a row only depends on its position, not on the thread tracing it.
+					params.tid = (y - 1) % numRngStreams;
+					params.startx = 1 + xstart;
+					params.stopx  = xstop;
+					params.xinc   = 1;
+					params.starty = y;
+					params.stopy  = y;
+					params.yinc   = 1;
+					thread_trace(&params);
+				}
+				context->serialno = params.serialno;
+				std::lock_guard<std::mutex> lock(traceContextMutex);
+				freeTraceContexts.push_back(context);
+			});
 
 			// Copy rendered image piece back into Ovito's frame buffer.
 			// Flip image since Tachyon fills the buffer upside down.
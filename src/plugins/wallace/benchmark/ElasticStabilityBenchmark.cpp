@@ -0,0 +1,80 @@
+///////////////////////////////////////////////////////////////////////////////
+// Part of the Ovito Wallace Plugin
+//
+// Microbenchmark for the elastic stability kernel. Evaluates a large set of
+// synthetic deformation states with the scalar code path and with the fastest
+// SIMD code path supported by the CPU, and reports the throughput of each.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <plugins/wallace/Wallace.h>
+#include <plugins/wallace/modifier/elastic_stability/ElasticStabilityKernel.h>
+
+#include <random>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <algorithm>
+
+using namespace Ovito;
+using namespace Ovito::Particles;
+
+int main(int argc, char** argv)
+{
+    size_t count = (argc > 1) ? (size_t)std::atoll(argv[1]) : 1000000;
+
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<float> uniform(-1, 1);
+
+    // Cubic SOEC and TOEC of a generic metal (GPa).
+    ElasticStabilityKernel::Matrix6 C2 = ElasticStabilityKernel::Matrix6::Zero();
+    for(int i = 0; i < 3; i++) {
+        for(int j = 0; j < 3; j++)
+            C2(i, j) = (i == j) ? 243 : 145;
+        C2(i + 3, i + 3) = 116;
+    }
+    std::array<ElasticStabilityKernel::Matrix6, 6> C3;
+    for(int k = 0; k < 6; k++)
+        for(int i = 0; i < 6; i++)
+            for(int j = 0; j < 6; j++)
+                C3[k](i, j) = (i < 3 && j < 3 && k < 3) ? ((i == j && j == k) ? -2274 : -1233) : 0;
+    ElasticStabilityKernel kernel(C2, C3);
+
+    // Generate deformation gradients close to the identity and the corresponding Green-Lagrangian strains.
+    std::vector<Matrix3> F(count);
+    std::vector<SymmetricTensor2> strain(count);
+    for(size_t p = 0; p < count; p++) {
+        for(int i = 0; i < 3; i++)
+            for(int j = 0; j < 3; j++)
+                F[p](i, j) = (i == j ? 1 : 0) + (FloatType)0.05 * uniform(rng);
+        Matrix3 C = F[p].transposed() * F[p];
+        strain[p] = SymmetricTensor2((C(0,0) - 1) / 2, (C(1,1) - 1) / 2, (C(2,2) - 1) / 2, C(0,1) / 2, C(0,2) / 2, C(1,2) / 2);
+    }
+
+    std::vector<FloatType> stabilityScalar(count), stabilitySimd(count);
+    std::vector<FloatType> soecDeformed(count * 21), wallaceTensor(count * 21), stress(count * 6);
+
+    auto run = [&](ElasticStabilityKernel::InstructionSet instructionSet, std::vector<FloatType>& stabilityParameter) {
+        auto t0 = std::chrono::steady_clock::now();
+        kernel.evaluateRange(F.data(), strain.data(), count, stabilityParameter.data(),
+                soecDeformed.data(), wallaceTensor.data(), stress.data(), instructionSet);
+        auto t1 = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::nano>(t1 - t0).count() / count;
+    };
+
+    static const char* names[] = { "scalar", "avx2", "avx512" };
+    ElasticStabilityKernel::InstructionSet best = ElasticStabilityKernel::bestInstructionSet();
+    double tScalar = run(ElasticStabilityKernel::Scalar, stabilityScalar);
+    double tSimd = run(best, stabilitySimd);
+
+    double maxDiff = 0;
+    for(size_t p = 0; p < count; p++)
+        maxDiff = std::max(maxDiff, (double)std::abs(stabilityScalar[p] - stabilitySimd[p]));
+
+    std::printf("particles:          %zu\n", count);
+    std::printf("scalar:             %.1f ns/particle\n", tScalar);
+    std::printf("%-19s %.1f ns/particle (%.2fx)\n", (std::string(names[best]) + ":").c_str(), tSimd, tScalar / tSimd);
+    std::printf("max deviation:      %g\n", maxDiff);
+    return 0;
+}
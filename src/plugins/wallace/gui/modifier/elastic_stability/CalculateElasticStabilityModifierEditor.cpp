@@ -46,153 +46,27 @@ void CalculateElasticStabilityModifierEditor::createUI(const RolloutInsertionPar
     sublayout1->setContentsMargins(4,4,4,4);
     crystalStructureUI = new VariantComboBoxParameterUI(this, PROPERTY_FIELD(CalculateElasticStabilityModifier::structure));
 
-    crystalStructureUI->comboBox()->addItem(tr("Cubic m-3m"), QVariant::fromValue((int)ElasticConstants::CUBIC_HIGH));
-    crystalStructureUI->comboBox()->addItem(tr("Hexagonal 6/mmm"), QVariant::fromValue((int)ElasticConstants::HEXAGONAL_HIGH));
+    for (int structure = ElasticConstants::TRICLINIC; structure <= ElasticConstants::ISOTROPIC; structure++)
+        crystalStructureUI->comboBox()->addItem(tr(ElasticConstants::symmetryTable(structure)->name), QVariant::fromValue(structure));
     sublayout1->addWidget(crystalStructureUI->comboBox());
 
     //
-    //stacked layout for SOEC
+    //stacked layouts for SOEC and TOEC, one page per structure type
     //
     QStackedLayout* stackedSoecLayout = new QStackedLayout;
-
     layout->addLayout(stackedSoecLayout);
-
-    //ADD PAGES TO THE QSTACKWIDGET for SOEC
-
-    int currStruct[] = {ElasticConstants::CUBIC_HIGH, ElasticConstants::HEXAGONAL_HIGH};
-    //Should be able to loop over the allowed cases, make some association between list of labels and elastic constants...
-    for ( unsigned int i = 0; i < 2; i++){
-    switch(i) {
-        case(0): {
-
-
-
-            QWidget* CubicHighPage = new QWidget;
-            QGridLayout* sublayout = new QGridLayout(CubicHighPage);
-            stackedSoecLayout->addWidget(CubicHighPage);
-            sublayout -> setContentsMargins(30, 4, 4, 4);
-            SpinnerWidget* soecSpinners[3];
-            QString labels[3] = {"C11", "C12", "C44"};
-            for (int row = 0; row < 3; row++) {
-
-                QLineEdit* lineEdit = new QLineEdit();
-                SpinnerWidget* spinner = new SpinnerWidget();
-                QLabel* currentLabel = new QLabel(labels[row]);
-
-                soecSpinners[row] = spinner;
-                spinner->setProperty("row", row);
-                spinner->setTextBox(lineEdit);
-                sublayout->addWidget(lineEdit, row+1, 4);
-                sublayout->addWidget(spinner, row+1, 4+1);
-                sublayout->addWidget(currentLabel, row+1, 2);
-
-                connect(spinner, &SpinnerWidget::spinnerValueChanged, this, &CalculateElasticStabilityModifierEditor::setSoecSpinners);
-                connect(spinner, &SpinnerWidget::spinnerDragStart, this, &CalculateElasticStabilityModifierEditor::onSpinnerDragStart);
-                connect(spinner, &SpinnerWidget::spinnerDragStop, this, &CalculateElasticStabilityModifierEditor::onSpinnerDragStop);
-                connect(spinner, &SpinnerWidget::spinnerDragAbort, this, &CalculateElasticStabilityModifierEditor::onSpinnerDragAbort);
-            }
-            break;
-        }
-        case(1): {
-            QWidget* HexagonalHighPage = new QWidget;
-            stackedSoecLayout->addWidget(HexagonalHighPage);
-            QGridLayout* sublayout = new QGridLayout(HexagonalHighPage);
-            sublayout -> setContentsMargins(30, 4, 4, 4);
-            SpinnerWidget* soecSpinners[5];
-            QString labels[5] = {"C11", "C12", "C13", "C33", "C44"};
-            for (int row = 0; row < 5; row++) {
-                QLineEdit* lineEdit = new QLineEdit();
-                SpinnerWidget* spinner = new SpinnerWidget();
-                QLabel* currentLabel = new QLabel(labels[row]);
-
-                soecSpinners[row] = spinner;
-                spinner->setProperty("row", row);
-                spinner->setTextBox(lineEdit);
-                sublayout->addWidget(lineEdit, row+1, 4);
-                sublayout->addWidget(spinner, row+1, 4+1);
-                sublayout->addWidget(currentLabel, row+1, 2);
-
-                connect(spinner, &SpinnerWidget::spinnerValueChanged, this, &CalculateElasticStabilityModifierEditor::setSoecSpinners);
-                connect(spinner, &SpinnerWidget::spinnerDragStart, this, &CalculateElasticStabilityModifierEditor::onSpinnerDragStart);
-                connect(spinner, &SpinnerWidget::spinnerDragStop, this, &CalculateElasticStabilityModifierEditor::onSpinnerDragStop);
-                connect(spinner, &SpinnerWidget::spinnerDragAbort, this, &CalculateElasticStabilityModifierEditor::onSpinnerDragAbort);
-                }
-            break;
-            }
-        }
-    }
-    connect(crystalStructureUI->comboBox(), SIGNAL(activated(int)), stackedSoecLayout, SLOT(setCurrentIndex(int)));
-
-
-    //
-    //stacked layout for TOEC
-    //
     QStackedLayout* stackedToecLayout = new QStackedLayout;
-
     layout->addLayout(stackedToecLayout);
 
-    //ADD PAGES TO THE QSTACKWIDGET for TOEC
-
-    //Should be able to loop over the allowed cases, make some association between list of labels and elastic constants...
-    for ( unsigned int i = 0; i < 2; i++){
-    switch(i) {
-        case(0): {
-            QWidget* CubicHighPage = new QWidget;
-            QGridLayout* sublayout = new QGridLayout(CubicHighPage);
-            stackedToecLayout->addWidget(CubicHighPage);
-            sublayout -> setContentsMargins(30, 4, 4, 4);
-            SpinnerWidget* toecSpinners[6];
-            QString labels[6] = {"C111", "C112", "C123", "C144", "C155", "C456"};
-            for (int row = 0; row < 6; row++) {
-
-                QLineEdit* lineEdit = new QLineEdit();
-                SpinnerWidget* spinner = new SpinnerWidget();
-                QLabel* currentLabel = new QLabel(labels[row]);
-
-                toecSpinners[row] = spinner;
-                spinner->setProperty("row", row);
-                spinner->setTextBox(lineEdit);
-                sublayout->addWidget(lineEdit, row+1, 4);
-                sublayout->addWidget(spinner, row+1, 4+1);
-                sublayout->addWidget(currentLabel, row+1, 2);
-
-                connect(spinner, &SpinnerWidget::spinnerValueChanged, this, &CalculateElasticStabilityModifierEditor::setToecSpinners);
-                connect(spinner, &SpinnerWidget::spinnerDragStart, this, &CalculateElasticStabilityModifierEditor::onSpinnerDragStart);
-                connect(spinner, &SpinnerWidget::spinnerDragStop, this, &CalculateElasticStabilityModifierEditor::onSpinnerDragStop);
-                connect(spinner, &SpinnerWidget::spinnerDragAbort, this, &CalculateElasticStabilityModifierEditor::onSpinnerDragAbort);
-
-            }
-            break;
-        }
-        case(1): {
-            QWidget* HexagonalHighPage = new QWidget;
-            stackedToecLayout->addWidget(HexagonalHighPage);
-            QGridLayout* sublayout = new QGridLayout(HexagonalHighPage);
-            sublayout -> setContentsMargins(30, 4, 4, 4);
-            SpinnerWidget* toecSpinners[10];
-            QString labels[10] = {"C111", "C112", "C113", "C123", "C133", "C144", "C155", "C222", "C333", "C344"};
-            for (int row = 0; row < 10; row++) {
-                QLineEdit* lineEdit = new QLineEdit();
-                SpinnerWidget* spinner = new SpinnerWidget();
-                QLabel* currentLabel = new QLabel(labels[row]);
-
-                toecSpinners[row] = spinner;
-                spinner->setProperty("row", row);
-                spinner->setTextBox(lineEdit);
-                sublayout->addWidget(lineEdit, row+1, 4);
-                sublayout->addWidget(spinner, row+1, 4+1);
-                sublayout->addWidget(currentLabel, row+1, 2);
-
-                connect(spinner, &SpinnerWidget::spinnerValueChanged, this, &CalculateElasticStabilityModifierEditor::setToecSpinners);
-                connect(spinner, &SpinnerWidget::spinnerDragStart, this, &CalculateElasticStabilityModifierEditor::onSpinnerDragStart);
-                connect(spinner, &SpinnerWidget::spinnerDragStop, this, &CalculateElasticStabilityModifierEditor::onSpinnerDragStop);
-                connect(spinner, &SpinnerWidget::spinnerDragAbort, this, &CalculateElasticStabilityModifierEditor::onSpinnerDragAbort);
-                }
-            }
-            break;
-        }
+    //The labels of each page come from the symmetry table of the structure
+    for (int structure = ElasticConstants::TRICLINIC; structure <= ElasticConstants::ISOTROPIC; structure++) {
+        const LaueGroupTables::Table* table = ElasticConstants::symmetryTable(structure);
+        stackedSoecLayout->addWidget(createConstantsPage(table->soecNames, table->numberSoec, &CalculateElasticStabilityModifierEditor::setSoecSpinners));
+        stackedToecLayout->addWidget(createConstantsPage(table->toecNames, table->numberToec, &CalculateElasticStabilityModifierEditor::setToecSpinners));
     }
-    connect(crystalStructureUI->comboBox(), SIGNAL(activated(int)), stackedToecLayout, SLOT(setCurrentIndex(int)));
+    //Follow the combo box also when it is updated from the modifier, e.g. for the default structure
+    connect(crystalStructureUI->comboBox(), QOverload<int>::of(&QComboBox::currentIndexChanged), stackedSoecLayout, &QStackedLayout::setCurrentIndex);
+    connect(crystalStructureUI->comboBox(), QOverload<int>::of(&QComboBox::currentIndexChanged), stackedToecLayout, &QStackedLayout::setCurrentIndex);
 
 
     connect(crystalStructureUI->comboBox(), QOverload<int>::of(&QComboBox::currentIndexChanged), this, &CalculateElasticStabilityModifierEditor::onCurrentTextChanged);
@@ -220,6 +94,16 @@ void CalculateElasticStabilityModifierEditor::createUI(const RolloutInsertionPar
         }
     }
 
+    //Optional outputs
+    BooleanParameterUI* calculateWallaceTensorUI = new BooleanParameterUI(this, PROPERTY_FIELD(CalculateElasticStabilityModifier::calculateWallaceTensor));
+    layout->addWidget(calculateWallaceTensorUI->checkBox());
+
+    BooleanParameterUI* calculateSoecDeformedUI = new BooleanParameterUI(this, PROPERTY_FIELD(CalculateElasticStabilityModifier::calculateSoecDeformed));
+    layout->addWidget(calculateSoecDeformedUI->checkBox());
+
+    BooleanParameterUI* calculateStressUI = new BooleanParameterUI(this, PROPERTY_FIELD(CalculateElasticStabilityModifier::calculateStress));
+    layout->addWidget(calculateStressUI->checkBox());
+
     //Press button to do calculation
     QGridLayout* sublayout = new QGridLayout();
     sublayout->setContentsMargins(0,0,0,0);
@@ -235,6 +119,35 @@ void CalculateElasticStabilityModifierEditor::createUI(const RolloutInsertionPar
     layout->addLayout(sublayout);
 } 
 
+/*******************************************
+ * Creates a page with one spinner per elastic constant.
+ * Long lists are split into columns of ten.
+ * ***************************************/
+QWidget* CalculateElasticStabilityModifierEditor::createConstantsPage(const char* const* labels, int count, void (CalculateElasticStabilityModifierEditor::*setter)())
+{
+    QWidget* page = new QWidget;
+    QGridLayout* sublayout = new QGridLayout(page);
+    sublayout -> setContentsMargins(30, 4, 4, 4);
+    for (int row = 0; row < count; row++) {
+        QLineEdit* lineEdit = new QLineEdit();
+        SpinnerWidget* spinner = new SpinnerWidget();
+        QLabel* currentLabel = new QLabel(labels[row]);
+
+        spinner->setProperty("row", row);
+        spinner->setTextBox(lineEdit);
+        int column = (row / 10) * 3;
+        sublayout->addWidget(currentLabel, row % 10 + 1, column);
+        sublayout->addWidget(lineEdit, row % 10 + 1, column + 1);
+        sublayout->addWidget(spinner, row % 10 + 1, column + 2);
+
+        connect(spinner, &SpinnerWidget::spinnerValueChanged, this, setter);
+        connect(spinner, &SpinnerWidget::spinnerDragStart, this, &CalculateElasticStabilityModifierEditor::onSpinnerDragStart);
+        connect(spinner, &SpinnerWidget::spinnerDragStop, this, &CalculateElasticStabilityModifierEditor::onSpinnerDragStop);
+        connect(spinner, &SpinnerWidget::spinnerDragAbort, this, &CalculateElasticStabilityModifierEditor::onSpinnerDragAbort);
+    }
+    return page;
+}
+
 /*******************************************
  * Call when a structure is chosen
  * ***************************************/
@@ -56,6 +56,9 @@ protected:
 
 private:
 
+    /// Creates a page with input fields for the given list of elastic constants.
+    QWidget* createConstantsPage(const char* const* labels, int count, void (CalculateElasticStabilityModifierEditor::*setter)());
+
     VariantComboBoxParameterUI* crystalStructureUI;
 
     std::vector<float> _vecSoec;
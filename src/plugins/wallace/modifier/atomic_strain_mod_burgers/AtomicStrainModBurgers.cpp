@@ -21,6 +21,7 @@
 
 #include <plugins/particles/Particles.h>
 #include <plugins/particles/util/CutoffNeighborFinder.h>
+#include <plugins/particles/util/NeighborFinderCache.h>
 #include <core/dataset/pipeline/ModifierApplication.h>
 #include <plugins/stdobj/simcell/SimulationCellObject.h>
 #include <core/dataset/DataSetContainer.h>
@@ -39,6 +40,12 @@ DEFINE_PROPERTY_FIELD(AtomicStrainModBurgers, selectInvalidParticles);
 DEFINE_PROPERTY_FIELD(AtomicStrainModBurgers, calculateStretchTensors);
 DEFINE_PROPERTY_FIELD(AtomicStrainModBurgers, calculateRotations);
 DEFINE_PROPERTY_FIELD(AtomicStrainModBurgers, burgersContent);
+DEFINE_PROPERTY_FIELD(AtomicStrainModBurgers, additionalBurgersVectors);
+DEFINE_PROPERTY_FIELD(AtomicStrainModBurgers, calculateElasticStability);
+DEFINE_PROPERTY_FIELD(AtomicStrainModBurgers, structure);
+DEFINE_PROPERTY_FIELD(AtomicStrainModBurgers, soec);
+DEFINE_PROPERTY_FIELD(AtomicStrainModBurgers, toec);
+DEFINE_PROPERTY_FIELD(AtomicStrainModBurgers, CTransformation);
 //Need to add property field for use elastic displacements
 SET_PROPERTY_FIELD_LABEL(AtomicStrainModBurgers, cutoff, "Cutoff radius");
 SET_PROPERTY_FIELD_LABEL(AtomicStrainModBurgers, calculateDeformationGradients, "Output deformation gradient tensors");
@@ -47,6 +54,8 @@ SET_PROPERTY_FIELD_LABEL(AtomicStrainModBurgers, calculateNonaffineSquaredDispla
 SET_PROPERTY_FIELD_LABEL(AtomicStrainModBurgers, selectInvalidParticles, "Select invalid particles");
 SET_PROPERTY_FIELD_LABEL(AtomicStrainModBurgers, calculateStretchTensors, "Output stretch tensors");
 SET_PROPERTY_FIELD_LABEL(AtomicStrainModBurgers, calculateRotations, "Output rotations");
+SET_PROPERTY_FIELD_LABEL(AtomicStrainModBurgers, calculateElasticStability, "Output elastic stability parameter");
+SET_PROPERTY_FIELD_LABEL(AtomicStrainModBurgers, CTransformation, "Transformation");
 SET_PROPERTY_FIELD_UNITS_AND_MINIMUM(AtomicStrainModBurgers, cutoff, WorldParameterUnit, 0);
 //Add set property field as above
 
@@ -62,7 +71,12 @@ AtomicStrainModBurgers::AtomicStrainModBurgers(DataSet* dataset) : ReferenceConf
 	_calculateStretchTensors(false), 
 	_calculateRotations(false),
     _selectInvalidParticles(true),
-    _burgersContent(Vector3::Zero())
+    _burgersContent(Vector3::Zero()),
+    _calculateElasticStability(false),
+    _structure(11),
+    _soec(std::vector<float>({0, 0, 0})),
+    _toec(std::vector<float>({0, 0, 0, 0, 0, 0})),
+    _CTransformation(AffineTransformation::Identity())
 {
 }
 
@@ -97,11 +111,16 @@ Future<AsynchronousModifier::ComputeEnginePtr> AtomicStrainModBurgers::createEng
 	ConstPropertyPtr identifierProperty = particles->getPropertyStorage(ParticlesObject::IdentifierProperty);
 	ConstPropertyPtr refIdentifierProperty = refParticles->getPropertyStorage(ParticlesObject::IdentifierProperty);
 
+	// Collect the Burgers vectors to be removed from the displacements.
+	std::vector<Vector3> burgersVectors = additionalBurgersVectors();
+	burgersVectors.insert(burgersVectors.begin(), burgersContent());
+
 	// Create engine object. Pass all relevant modifier parameters to the engine as well as the input data.
 	return std::make_shared<AtomicStrainEngine>(validityInterval, particles, posProperty->storage(), inputCell->data(), refPosProperty->storage(), refCell->data(),
 			std::move(identifierProperty), std::move(refIdentifierProperty),
 			cutoff(), affineMapping(), useMinimumImageConvention(), calculateDeformationGradients(), calculateStrainTensors(),
-            calculateNonaffineSquaredDisplacements(), calculateRotations(), calculateStretchTensors(), selectInvalidParticles(), burgersContent());
+            calculateNonaffineSquaredDisplacements(), calculateRotations(), calculateStretchTensors(), selectInvalidParticles(), burgersVectors,
+            calculateElasticStability() ? _stabilityKernelCache.kernel(structure(), soec(), toec(), CTransformation()) : nullptr);
 }
 
 /******************************************************************************
@@ -151,20 +170,49 @@ void AtomicStrainModBurgers::AtomicStrainEngine::perform()
     task()->setProgressText(tr("Computing atomic strain tensors"));
 	
 	// Prepare the neighbor list for the reference configuration.
-	CutoffNeighborFinder neighborFinder;
-	if(!neighborFinder.prepare(_cutoff, *refPositions(), refCell(), nullptr, task().get()))
+	std::shared_ptr<const CutoffNeighborFinder> neighborFinder = NeighborFinderCache::cutoffNeighborFinder(_cutoff, refPositions(), refCell(), nullptr, task().get());
+	if(!neighborFinder)
 		return;
 
 	// Perform individual strain calculation for each particle.
-	parallelFor(positions()->size(), *task(), [this, &neighborFinder](size_t index) {
-		computeStrain(index, neighborFinder);
+	if(!stabilityParameters()) {
+		parallelFor(positions()->size(), *task(), [this, &neighborFinder](size_t index) {
+			computeStrain(index, *neighborFinder);
+		});
+		return;
+	}
+
+	// In fused mode, the deformation gradients of a block of particles go straight into the
+	// elastic stability kernel instead of being stored as per-particle properties.
+	parallelForChunks(positions()->size(), *task(), [this, &neighborFinder](size_t startIndex, size_t count, PromiseState& promise) {
+		const size_t blockSize = 256;
+		std::vector<Matrix3> F(blockSize);
+		std::vector<SymmetricTensor2> strain(blockSize);
+		std::vector<char> valid(blockSize);
+		for(size_t offset = startIndex; offset < startIndex + count; offset += blockSize) {
+			if(promise.isCanceled()) return;
+			size_t n = std::min(blockSize, startIndex + count - offset);
+			for(size_t i = 0; i < n; i++) {
+				valid[i] = computeStrain(offset + i, *neighborFinder, &F[i], &strain[i]);
+				if(!valid[i]) {
+					F[i] = Matrix3::Identity();
+					strain[i] = SymmetricTensor2::Zero();
+				}
+			}
+			_stabilityKernel->evaluateRange(F.data(), strain.data(), n, stabilityParameters()->dataFloat() + offset, nullptr, nullptr, nullptr);
+			for(size_t i = 0; i < n; i++) {
+				if(!valid[i])
+					stabilityParameters()->setFloat(offset + i, 0);
+			}
+		}
 	});
 }
 
 /******************************************************************************
 * Computes the strain tensor of a single particle.
 ******************************************************************************/
-void AtomicStrainModBurgers::AtomicStrainEngine::computeStrain(size_t particleIndex, CutoffNeighborFinder& neighborFinder)
+bool AtomicStrainModBurgers::AtomicStrainEngine::computeStrain(size_t particleIndex, const CutoffNeighborFinder& neighborFinder,
+		Matrix3* deformationGradient, SymmetricTensor2* strainTensor)
 {
 	// Note: We do the following calculations using double precision numbers to
 	// minimize numerical errors. Final results will be converted back to
@@ -186,11 +234,8 @@ void AtomicStrainModBurgers::AtomicStrainEngine::computeStrain(size_t particleIn
             Vector3 delta_ref = neighQuery.delta(); //Dist between central particle and near neighbor in ref state
             Vector3 delta_cur = delta_ref + neigh_displacement - center_displacement; //Dist between particles in current state
             //Remove effect of burgers vector
-            while((delta_cur - delta_ref - _burgersContent).squaredLength() < (delta_cur - delta_ref).squaredLength())
-               delta_cur -= _burgersContent;
-
-            while((delta_cur - delta_ref + _burgersContent).squaredLength() < (delta_cur - delta_ref).squaredLength())
-               delta_cur += _burgersContent;
+            if(!_burgersReduction.isEmpty())
+               delta_cur = delta_ref + _burgersReduction.reduce(neigh_displacement - center_displacement);
 
 
 			if(affineMapping() == TO_CURRENT_CELL) {
@@ -243,11 +288,13 @@ void AtomicStrainModBurgers::AtomicStrainEngine::computeStrain(size_t particleIn
 		if(stretchTensors())
 			stretchTensors()->setSymmetricTensor2(particleIndex, SymmetricTensor2::Zero());
 		addInvalidParticle();
-		return;
+		return false;
 	}
 
 	// Calculate deformation gradient tensor F.
 	Matrix_3<double> F = W * inverseV;
+	if(deformationGradient)
+		*deformationGradient = static_cast<Matrix3>(F);
 	if(deformationGradients()) {
 		for(Matrix_3<double>::size_type col = 0; col < 3; col++) {
 			for(Matrix_3<double>::size_type row = 0; row < 3; row++) {
@@ -273,6 +320,8 @@ void AtomicStrainModBurgers::AtomicStrainEngine::computeStrain(size_t particleIn
 	SymmetricTensor2T<double> strain = (Product_AtA(F) - SymmetricTensor2T<double>::Identity()) * 0.5;
 	if(strainTensors())
 		strainTensors()->setSymmetricTensor2(particleIndex, (SymmetricTensor2)strain);
+	if(strainTensor)
+		*strainTensor = (SymmetricTensor2)strain;
 
     // Calculate nonaffine displacement.
     if(nonaffineSquaredDisplacements()) {
@@ -329,6 +378,8 @@ void AtomicStrainModBurgers::AtomicStrainEngine::computeStrain(size_t particleIn
 
 	if(invalidParticles())
 		invalidParticles()->setInt(particleIndex, 0);
+
+	return true;
 }
 
 /******************************************************************************
@@ -370,6 +421,9 @@ void AtomicStrainModBurgers::AtomicStrainEngine::emitResults(TimePoint time, Mod
 	if(stretchTensors())
 		particles->createProperty(stretchTensors());
 
+	if(stabilityParameters())
+		particles->createProperty(stabilityParameters());
+
 	state.addAttribute(QStringLiteral("AtomicStrain.invalid_particle_count"), QVariant::fromValue(numInvalidParticles()), modApp);
 
 	if(numInvalidParticles() != 0)
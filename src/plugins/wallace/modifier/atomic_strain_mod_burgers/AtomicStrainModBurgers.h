@@ -27,6 +27,8 @@
 #include <plugins/particles/objects/ParticlesObject.h>
 #include <plugins/particles/util/ParticleOrderingFingerprint.h>
 #include <plugins/stdobj/simcell/SimulationCell.h>
+#include <plugins/wallace/modifier/elastic_stability/ElasticStabilityKernel.h>
+#include <plugins/wallace/modifier/elastic_displacements/BurgersVectorReduction.h>
 
 namespace Ovito { namespace Particles { OVITO_BEGIN_INLINE_NAMESPACE(Modifiers) OVITO_BEGIN_INLINE_NAMESPACE(Analysis)
 
@@ -66,7 +68,7 @@ private:
 				FloatType cutoff, AffineMappingType affineMapping, bool useMinimumImageConvention,
 				bool calculateDeformationGradients, bool calculateStrainTensors,
 				bool calculateNonaffineSquaredDisplacements, bool calculateRotations, bool calculateStretchTensors,
-                bool selectInvalidParticles, Vector3 burgersContent) :
+                bool selectInvalidParticles, const std::vector<Vector3>& burgersVectors, std::shared_ptr<const ElasticStabilityKernel> stabilityKernel) :
 			RefConfigEngineBase(validityInterval, positions, simCell, refPositions, simCellRef,
                 std::move(identifiers), std::move(refIdentifiers), affineMapping, useMinimumImageConvention),
             _cutoff(cutoff),
@@ -79,8 +81,10 @@ private:
 			_invalidParticles(selectInvalidParticles ? ParticlesObject::OOClass().createStandardStorage(fingerprint.particleCount(), ParticlesObject::SelectionProperty, false) : nullptr),
 			_rotations(calculateRotations ? ParticlesObject::OOClass().createStandardStorage(fingerprint.particleCount(), ParticlesObject::RotationProperty, false) : nullptr),
 			_stretchTensors(calculateStretchTensors ? ParticlesObject::OOClass().createStandardStorage(fingerprint.particleCount(), ParticlesObject::StretchTensorProperty, false) : nullptr),
+			_stabilityParameters(stabilityKernel ? std::make_shared<PropertyStorage>(fingerprint.particleCount(), PropertyStorage::Float, 1, 0, tr("Stability Parameter"), false) : nullptr),
             _inputFingerprint(std::move(fingerprint)),
-            _burgersContent(burgersContent) {}
+            _burgersReduction(burgersVectors),
+            _stabilityKernel(std::move(stabilityKernel)) {}
 
 		/// This method is called by the system after the computation was successfully completed.
 		virtual void cleanup() override {
@@ -118,6 +122,9 @@ private:
 		/// Returns the property storage that contains the computed stretch tensors.
 		const PropertyPtr& stretchTensors() const { return _stretchTensors; }
 
+		/// Returns the property storage that contains the elastic stability parameters computed in fused mode.
+		const PropertyPtr& stabilityParameters() const { return _stabilityParameters; }
+
 		/// Returns the number of invalid particles for which the strain tensor could not be computed.
 		size_t numInvalidParticles() const { return _numInvalidParticles.load(); }
 
@@ -129,8 +136,10 @@ private:
 		
 	private:
 
-		/// Computes the strain tensor of a single particle.
-		void computeStrain(size_t particleIndex, CutoffNeighborFinder& neighborListBuilder);
+		/// Computes the strain tensor of a single particle. Optionally passes the deformation gradient and
+		/// strain tensor back to the caller. Returns false if the particle has too few neighbors.
+		bool computeStrain(size_t particleIndex, const CutoffNeighborFinder& neighborListBuilder,
+				Matrix3* deformationGradient = nullptr, SymmetricTensor2* strainTensor = nullptr);
 
 		const FloatType _cutoff;
 		PropertyPtr _displacements;
@@ -143,10 +152,15 @@ private:
 		const PropertyPtr _invalidParticles;
 		const PropertyPtr _rotations;
 		const PropertyPtr _stretchTensors;		
+		const PropertyPtr _stabilityParameters;
 		ParticleOrderingFingerprint _inputFingerprint;
-        const Vector3 _burgersContent;
+        const BurgersVectorReduction _burgersReduction;
+        const std::shared_ptr<const ElasticStabilityKernel> _stabilityKernel;
 	};
 
+	/// The elastic stability kernel for the current parameters, shared by the engines of all frames.
+	ElasticStabilityKernelCache _stabilityKernelCache;
+
 	/// Controls the cutoff radius for the neighbor lists.
 	DECLARE_MODIFIABLE_PROPERTY_FIELD_FLAGS(FloatType, cutoff, setCutoff, PROPERTY_FIELD_MEMORIZE);
 
@@ -170,6 +184,25 @@ private:
 
     /// Allows an input Burgers Vector to remove from displacement
     DECLARE_MODIFIABLE_PROPERTY_FIELD_FLAGS(Vector3, burgersContent, setBurgersContent, PROPERTY_FIELD_MEMORIZE);
+
+	/// Further Burgers vectors (e.g. the other members of a slip family) removed from the displacements.
+	DECLARE_MODIFIABLE_PROPERTY_FIELD(std::vector<Vector3>, additionalBurgersVectors, setAdditionalBurgersVectors);
+
+	/// Controls whether the elastic stability parameter is computed directly from the deformation gradients,
+	/// as the CalculateElasticStabilityModifier would do, without storing the intermediate tensors.
+	DECLARE_MODIFIABLE_PROPERTY_FIELD(bool, calculateElasticStability, setCalculateElasticStability);
+
+	/// The Laue group of the crystal used in the elastic stability calculation.
+	DECLARE_MODIFIABLE_PROPERTY_FIELD_FLAGS(int, structure, setStructure, PROPERTY_FIELD_MEMORIZE);
+
+	/// The independent second order elastic constants used in the elastic stability calculation.
+	DECLARE_MODIFIABLE_PROPERTY_FIELD_FLAGS(std::vector<float>, soec, setSoec, PROPERTY_FIELD_MEMORIZE);
+
+	/// The independent third order elastic constants used in the elastic stability calculation.
+	DECLARE_MODIFIABLE_PROPERTY_FIELD_FLAGS(std::vector<float>, toec, setToec, PROPERTY_FIELD_MEMORIZE);
+
+	/// The rotation of the elastic constants into the simulation frame.
+	DECLARE_MODIFIABLE_PROPERTY_FIELD_FLAGS(AffineTransformation, CTransformation, setCTransformation, PROPERTY_FIELD_MEMORIZE);
 };
 
 OVITO_END_INLINE_NAMESPACE
@@ -0,0 +1,95 @@
+///////////////////////////////////////////////////////////////////////////////
+// Part of the Ovito Wallace Plugin
+//
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <plugins/wallace/Wallace.h>
+
+namespace Ovito { namespace Particles { OVITO_BEGIN_INLINE_NAMESPACE(Modifiers) OVITO_BEGIN_INLINE_NAMESPACE(Analysis)
+
+/**
+* \brief Removes integer multiples of a set of Burgers vectors from displacement vectors.
+*
+* For a single Burgers vector b, the multiple k that minimizes |u - k*b| is obtained in closed form
+* by rounding the projection u.b/|b|^2 to the nearest integer (ties are rounded towards zero, so that
+* u is only changed if its length strictly decreases). Several Burgers vectors, e.g. the members of
+* a slip family, are removed one after the other, and the sweep over all vectors is repeated until
+* the vector no longer changes. The result is then a vector that no single Burgers vector can shorten.
+* For non-orthogonal vectors, this is not necessarily the shortest of all vectors u - sum(k_i * b_i).
+*/
+class BurgersVectorReduction
+{
+public:
+
+    /// Upper bound on the number of sweeps over the Burgers vectors. Every change makes the vector strictly
+    /// shorter, so the sweeps end by themselves; the bound only protects against rounding errors at exact ties.
+    static constexpr int MaxSweeps = 100;
+
+    /// Constructor. Zero vectors and vectors that duplicate an earlier one (up to the sign) are ignored.
+    explicit BurgersVectorReduction(const std::vector<Vector3>& burgersVectors) {
+        for(const Vector3& b : burgersVectors) {
+            if(b.squaredLength() <= FLOATTYPE_EPSILON) continue;
+            if(std::any_of(_vectors.cbegin(), _vectors.cend(), [&b](const Vector3& v) { return v.equals(b) || v.equals(-b); })) continue;
+            _vectors.push_back(b);
+            _projectors.push_back(b / b.squaredLength());
+        }
+    }
+
+    /// Returns true if there is nothing to remove.
+    bool isEmpty() const { return _vectors.empty(); }
+
+    /// Returns the Burgers vectors actually used by the reduction.
+    const std::vector<Vector3>& vectors() const { return _vectors; }
+
+    /// Returns the vector u - sum(k_i * b_i) at which the reduction stops, which no single Burgers vector can shorten.
+    Vector3 reduce(Vector3 u) const {
+        for(int sweep = 0; sweep < MaxSweeps; sweep++) {
+            bool changed = false;
+            for(size_t i = 0; i < _vectors.size(); i++) {
+                FloatType k = multiple(u.dot(_projectors[i]));
+                u -= k * _vectors[i];
+                changed |= (k != 0);
+            }
+            if(!changed || _vectors.size() == 1) break;
+        }
+        return u;
+    }
+
+    /// Reduces a contiguous array of vectors in place. The inner loops run over the array
+    /// without data-dependent branches, so that the compiler can vectorize them.
+    void reduce(Vector3* u, size_t count) const {
+        for(int sweep = 0; sweep < MaxSweeps; sweep++) {
+            bool changed = false;
+            for(size_t i = 0; i < _vectors.size(); i++) {
+                const Vector3 b = _vectors[i];
+                const Vector3 p = _projectors[i];
+                for(size_t j = 0; j < count; j++) {
+                    FloatType k = multiple(u[j].x() * p.x() + u[j].y() * p.y() + u[j].z() * p.z());
+                    u[j].x() -= k * b.x();
+                    u[j].y() -= k * b.y();
+                    u[j].z() -= k * b.z();
+                    changed |= (k != 0);
+                }
+            }
+            if(!changed || _vectors.size() == 1) break;
+        }
+    }
+
+private:
+
+    /// Rounds a projection to the nearest integer, rounding ties towards zero.
+    static FloatType multiple(FloatType t) {
+        return std::copysign(std::ceil(std::abs(t) - FloatType(0.5)), t);
+    }
+
+    std::vector<Vector3> _vectors;
+    std::vector<Vector3> _projectors;
+};
+
+OVITO_END_INLINE_NAMESPACE
+OVITO_END_INLINE_NAMESPACE
+}	// End of namespace
+}	// End of namespace
@@ -30,6 +30,7 @@ namespace Ovito { namespace Particles { OVITO_BEGIN_INLINE_NAMESPACE(Modifiers)
 IMPLEMENT_OVITO_CLASS(CalculateElasticDisplacementsModifier);
 DEFINE_REFERENCE_FIELD(CalculateElasticDisplacementsModifier, vectorVis);
 DEFINE_PROPERTY_FIELD(CalculateElasticDisplacementsModifier, burgersContent);
+DEFINE_PROPERTY_FIELD(CalculateElasticDisplacementsModifier, additionalBurgersVectors);
 
 /******************************************************************************
 * Constructs the modifier object.
@@ -76,13 +77,15 @@ Future<AsynchronousModifier::ComputeEnginePtr> CalculateElasticDisplacementsModi
 	ConstPropertyPtr identifierProperty = particles->getPropertyStorage(ParticlesObject::IdentifierProperty);
 	ConstPropertyPtr refIdentifierProperty = refParticles->getPropertyStorage(ParticlesObject::IdentifierProperty);
 
+	// Collect the Burgers vectors to be removed from the displacements.
+	std::vector<Vector3> burgersVectors = additionalBurgersVectors();
+	burgersVectors.insert(burgersVectors.begin(), burgersContent());
+
 	// Create engine object. Pass all relevant modifier parameters to the engine as well as the input data.
 	return std::make_shared<ElasticDisplacementEngine>(validityInterval, posProperty->storage(), inputCell->data(), 
 			particles, refPosProperty->storage(), refCell->data(),
 			std::move(identifierProperty), std::move(refIdentifierProperty),
-            affineMapping(), useMinimumImageConvention(), burgersContent());
-	
-
+            affineMapping(), useMinimumImageConvention(), burgersVectors);
 }
 
 /******************************************************************************
@@ -99,11 +102,10 @@ void CalculateElasticDisplacementsModifier::ElasticDisplacementEngine::perform()
 	if(affineMapping() != NO_MAPPING) {
 		parallelForChunks(elasticDisplacements()->size(), *task(), [this](size_t startIndex, size_t count, PromiseState& promise) {
 			Vector3* u = elasticDisplacements()->dataVector3() + startIndex;
-			FloatType* umag = elasticDisplacementMagnitudes()->dataFloat() + startIndex;
 			const Point3* p = positions()->constDataPoint3() + startIndex;
 			auto index = currentToRefIndexMap().cbegin() + startIndex;
 			const AffineTransformation& reduced_to_absolute = (affineMapping() == TO_REFERENCE_CELL) ? refCell().matrix() : cell().matrix();
-			for(; count; --count, ++u, ++umag, ++p, ++index) {
+			for(size_t c = count; c; --c, ++u, ++p, ++index) {
 				if(promise.isCanceled()) return;
 				Point3 reduced_current_pos = cell().inverseMatrix() * (*p);
 				Point3 reduced_reference_pos = refCell().inverseMatrix() * refPositions()->getPoint3(*index);
@@ -115,24 +117,16 @@ void CalculateElasticDisplacementsModifier::ElasticDisplacementEngine::perform()
 					}
 				}
 				*u = reduced_to_absolute * delta;
-                //Mod out a burgers vector
-                while((*u - _burgersContent).squaredLength() < u->squaredLength())
-                    *u -= _burgersContent;
-
-                while((*u + _burgersContent).squaredLength() < u->squaredLength())
-                    *u += _burgersContent;
-
-				*umag = u->length();
 			}
+			finishChunk(startIndex, count);
 		});
 	}
 	else {
 		parallelForChunks(elasticDisplacements()->size(), *task(), [this] (size_t startIndex, size_t count, PromiseState& promise) {
 			Vector3* u = elasticDisplacements()->dataVector3() + startIndex;
-			FloatType* umag = elasticDisplacementMagnitudes()->dataFloat() + startIndex;
 			const Point3* p = positions()->constDataPoint3() + startIndex;
 			auto index = currentToRefIndexMap().cbegin() + startIndex;
-			for(; count; --count, ++u, ++umag, ++p, ++index) {
+			for(size_t c = count; c; --c, ++u, ++p, ++index) {
 				if(promise.isCanceled()) return;
                 *u = *p - refPositions()->getPoint3(*index);
 				if(useMinimumImageConvention()) {
@@ -146,19 +140,25 @@ void CalculateElasticDisplacementsModifier::ElasticDisplacementEngine::perform()
 						}
 					}
                }
-                //Mod out a burgers vector
-                while((*u - _burgersContent).squaredLength() < u->squaredLength())
-                    *u -= _burgersContent;
-
-                while((*u + _burgersContent).squaredLength() < u->squaredLength())
-                    *u += _burgersContent;
-
-				*umag = u->length();
 			}
+			finishChunk(startIndex, count);
 		});
 	}
 }
 
+/******************************************************************************
+* Removes the Burgers vectors from a chunk of displacement vectors and computes their magnitudes.
+******************************************************************************/
+void CalculateElasticDisplacementsModifier::ElasticDisplacementEngine::finishChunk(size_t startIndex, size_t count)
+{
+	Vector3* u = elasticDisplacements()->dataVector3() + startIndex;
+	FloatType* umag = elasticDisplacementMagnitudes()->dataFloat() + startIndex;
+	if(!_burgersReduction.isEmpty())
+		_burgersReduction.reduce(u, count);
+	for(size_t i = 0; i < count; i++)
+		umag[i] = u[i].length();
+}
+
 /******************************************************************************
 * Injects the computed results of the engine into the data pipeline.
 ******************************************************************************/
@@ -27,6 +27,7 @@
 #include <plugins/particles/modifier/analysis/ReferenceConfigurationModifier.h>
 #include <plugins/particles/util/ParticleOrderingFingerprint.h>
 #include <plugins/stdobj/simcell/SimulationCell.h>
+#include "BurgersVectorReduction.h"
 
 namespace Ovito { namespace Particles { OVITO_BEGIN_INLINE_NAMESPACE(Modifiers) OVITO_BEGIN_INLINE_NAMESPACE(Analysis)
 
@@ -64,13 +65,13 @@ private:
 				ParticleOrderingFingerprint fingerprint,
 				ConstPropertyPtr refPositions, const SimulationCell& simCellRef,
 				ConstPropertyPtr identifiers, ConstPropertyPtr refIdentifiers,
-                AffineMappingType affineMapping, bool useMinimumImageConvention, Vector3 burgersContent) : // Eric addition vector3
+                AffineMappingType affineMapping, bool useMinimumImageConvention, const std::vector<Vector3>& burgersVectors) :
 			RefConfigEngineBase(validityInterval, positions, simCell, std::move(refPositions), simCellRef,
 				std::move(identifiers), std::move(refIdentifiers), affineMapping, useMinimumImageConvention),
 			_elasticDisplacements(ParticlesObject::OOClass().createStandardStorage(fingerprint.particleCount(), ParticlesObject::DisplacementProperty, false)),
 			_elasticDisplacementMagnitudes(ParticlesObject::OOClass().createStandardStorage(fingerprint.particleCount(), ParticlesObject::ElasticDisplacementMagnitudeProperty, false)),
             _inputFingerprint(std::move(fingerprint)),
-            _burgersContent(burgersContent) {}
+            _burgersReduction(burgersVectors) {}
 
 		/// Computes the modifier's results.
 		virtual void perform() override;
@@ -86,15 +87,21 @@ private:
 		
 	private:
 
+		/// Removes the Burgers vectors from a chunk of displacement vectors and computes their magnitudes.
+		void finishChunk(size_t startIndex, size_t count);
+
 		const PropertyPtr _elasticDisplacements;
 		const PropertyPtr _elasticDisplacementMagnitudes;
 		ParticleOrderingFingerprint _inputFingerprint;
-        const Vector3 _burgersContent;
+        const BurgersVectorReduction _burgersReduction;
 	};
 
 	/// The vis element for rendering the displacement vectors.
 	DECLARE_MODIFIABLE_REFERENCE_FIELD_FLAGS(VectorVis, vectorVis, setVectorVis, PROPERTY_FIELD_DONT_PROPAGATE_MESSAGES | PROPERTY_FIELD_MEMORIZE);
     DECLARE_MODIFIABLE_PROPERTY_FIELD_FLAGS(Vector3, burgersContent, setBurgersContent, PROPERTY_FIELD_MEMORIZE);
+
+	/// Further Burgers vectors (e.g. the other members of a slip family) removed from the displacements.
+	DECLARE_MODIFIABLE_PROPERTY_FIELD(std::vector<Vector3>, additionalBurgersVectors, setAdditionalBurgersVectors);
 };
 
 OVITO_END_INLINE_NAMESPACE
@@ -14,6 +14,7 @@
 #include <plugins/stdobj/simcell/SimulationCell.h>
 #include <core/dataset/pipeline/AsynchronousModifier.h>
 #include "ElasticConstants.h"
+#include "ElasticStabilityKernel.h"
 
 namespace Ovito { namespace Particles { OVITO_BEGIN_INLINE_NAMESPACE(Modifiers) OVITO_BEGIN_INLINE_NAMESPACE(Analysis)
 
@@ -44,22 +45,20 @@ private:
     {
         public:
             ElasticStabilityEngine(ParticleOrderingFingerprint fingerprint, ConstPropertyPtr positions,
-                ConstPropertyPtr deformationGradient, ConstPropertyPtr strainTensors, const SimulationCell& simCell, const int structure,
-                std::vector<float> soec, std::vector<float> toec, AffineTransformation(CTransformation)) :
+                ConstPropertyPtr deformationGradient, ConstPropertyPtr strainTensors, const SimulationCell& simCell,
+                std::shared_ptr<const ElasticStabilityKernel> kernel,
+                bool calculateWallaceTensor, bool calculateSoecDeformed, bool calculateStress) :
                 _positions(std::move(positions)),
                 _strainTensors(std::move(strainTensors)),
                 _deformationGradient(std::move(deformationGradient)),
-                _wallaceTensor(std::make_shared<PropertyStorage>(fingerprint.particleCount(), PropertyStorage::Float, 21, 21 * sizeof(FloatType) , tr("Wallace Tensor"), false)),
+                _wallaceTensor(calculateWallaceTensor ? std::make_shared<PropertyStorage>(fingerprint.particleCount(), PropertyStorage::Float, 21, 21 * sizeof(FloatType) , tr("Wallace Tensor"), false) : nullptr),
                 _stabilityParameter(std::make_shared<PropertyStorage>(fingerprint.particleCount(), PropertyStorage::Float, 1, 0, tr("Stability Parameter"), false)),
                 _simCell(simCell),
                 _inputFingerprint(std::move(fingerprint)),
-                _structure(structure),
-                _soec(soec),
-                _toec(toec),
-                _refStabPar(0),
-                _stressTensor(std::make_shared<PropertyStorage>(fingerprint.particleCount(), PropertyStorage::Float, 6, 6 * sizeof(FloatType) , tr("Stress from elastic deformation"), false)),
-                _soecDeformed(std::make_shared<PropertyStorage>(fingerprint.particleCount(), PropertyStorage::Float, 21, 21 * sizeof(FloatType) , tr("SOEC at finite deformation"), false)),
-                _CTransformation(CTransformation)
+                _stressTensor(calculateStress ? std::make_shared<PropertyStorage>(fingerprint.particleCount(), PropertyStorage::Float, 6, 6 * sizeof(FloatType) , tr("Stress from elastic deformation"), false,
+                    0, QStringList() << "XX" << "YY" << "ZZ" << "XY" << "XZ" << "YZ") : nullptr),
+                _soecDeformed(calculateSoecDeformed ? std::make_shared<PropertyStorage>(fingerprint.particleCount(), PropertyStorage::Float, 21, 21 * sizeof(FloatType) , tr("SOEC at finite deformation"), false) : nullptr),
+                _kernel(std::move(kernel))
             {}
 
             virtual void cleanup() override {
@@ -94,46 +93,43 @@ private:
             ///Returns the SOEC at finite deformation.
             const PropertyPtr& soecDeformed() const { return _soecDeformed; }
 
-            ///Returns the stress calculated with second and third order elastic constants.
+            ///Returns the second Piola-Kirchhoff stress calculated with second and third order elastic constants.
             const PropertyPtr& stressTensor() const { return _stressTensor; }
 
     private:    
 
-        void computeElasticStability(size_t particleIndex);
-        void computeDeformedElasticConstants(size_t particleIndex);
-        void computeStress(size_t particleIndex);
-
         const SimulationCell _simCell;
         ConstPropertyPtr _positions;
         const PropertyPtr _wallaceTensor;
         const PropertyPtr _stabilityParameter;
-        PropertyPtr _soecDeformed;
-        PropertyPtr _stressTensor;
+        const PropertyPtr _soecDeformed;
+        const PropertyPtr _stressTensor;
         ConstPropertyPtr _deformationGradient;
         ConstPropertyPtr _strainTensors;
         ParticleOrderingFingerprint _inputFingerprint;
-        const std::vector<float> _soec;
-        const std::vector<float> _toec;
-        Eigen::TensorFixedSize<float, Eigen::Sizes<6, 6>> _vC2;
-        Eigen::TensorFixedSize<float, Eigen::Sizes<6, 6, 6>> _vC3;
-        //Eigen::TensorFixedSize<float, Eigen::Sizes<6, 6>> _D1;
-        //Eigen::TensorFixedSize<float, Eigen::Sizes<6, 6, 6>> _D2;
-        Eigen::TensorFixedSize<float, Eigen::Sizes<3, 3, 3, 3>> _I4;
-        const AffineTransformation _CTransformation;
-        Eigen::TensorFixedSize<float, Eigen::Sizes<3, 3>> _ETransformation;
-        float _refStabPar;
-        const int _structure; //This is the symmetry type of the input
-        /* This uses the Laue group
-         * 1 -> N (Triclinic)
-         * 2 -> M (Monoclinic)
-         * 3 -> O (Orthorhombic) etc.
-         */
+        const std::shared_ptr<const ElasticStabilityKernel> _kernel; //Rotated constants in Voigt space, shared between frames
     };
 
+    /// The kernel for the current parameters, shared by the engines of all frames.
+    ElasticStabilityKernelCache _kernelCache;
+
    DECLARE_MODIFIABLE_PROPERTY_FIELD_FLAGS(std::vector<float>, soec, setSoec, PROPERTY_FIELD_MEMORIZE);
    DECLARE_MODIFIABLE_PROPERTY_FIELD_FLAGS(std::vector<float>, toec, setToec, PROPERTY_FIELD_MEMORIZE);
+   /// The symmetry type of the input, given as Laue group
+   /// 1 -> N (Triclinic)
+   /// 2 -> M (Monoclinic)
+   /// 3 -> O (Orthorhombic) etc.
    DECLARE_MODIFIABLE_PROPERTY_FIELD_FLAGS(int, structure, setStructure, PROPERTY_FIELD_MEMORIZE);
    DECLARE_MODIFIABLE_PROPERTY_FIELD_FLAGS(AffineTransformation, CTransformation, setCTransformation, PROPERTY_FIELD_MEMORIZE);
+
+   /// Controls whether the symmetric Wallace tensors should be stored.
+   DECLARE_MODIFIABLE_PROPERTY_FIELD(bool, calculateWallaceTensor, setCalculateWallaceTensor);
+
+   /// Controls whether the second order elastic constants at finite deformation should be stored.
+   DECLARE_MODIFIABLE_PROPERTY_FIELD(bool, calculateSoecDeformed, setCalculateSoecDeformed);
+
+   /// Controls whether the per-particle stress should be stored.
+   DECLARE_MODIFIABLE_PROPERTY_FIELD(bool, calculateStress, setCalculateStress);
 };
 
 OVITO_END_INLINE_NAMESPACE
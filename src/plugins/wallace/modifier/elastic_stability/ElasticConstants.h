@@ -2,6 +2,9 @@
 
 #include <eigen3/Eigen/Eigen>
 #include <eigen3/unsupported/Eigen/CXX11/Tensor>
+#include <string>
+#include <vector>
+#include "LaueGroupTables.h"
 
 class ElasticConstants {
 
@@ -30,7 +33,7 @@ public:
     const Eigen::TensorFixedSize<float, Eigen::Sizes<3, 3, 3, 3, 3, 3>> fullToec() const { return _fullToec; }
 
     enum LaueGroups {
-        TRIGONAL = 1,
+        TRICLINIC = 1,
         MONOCLINIC = 2,
         ORTHORHOMBIC = 3,
         TETRAGONAL_LOW = 4,
@@ -45,37 +48,41 @@ public:
         ISOTROPIC = 13
     };
 
+    //returns the symmetry table of a Laue group, or nullptr if the structure type is unknown
+    static const LaueGroupTables::Table* symmetryTable(int structure) {
+        if (structure < TRICLINIC || structure > ISOTROPIC) return nullptr;
+        return &LaueGroupTables::tables[structure - TRICLINIC];
+    }
+
+    //returns whether the structure type is one of the LaueGroups
+    static bool isSupported(int structure) { return symmetryTable(structure) != nullptr; }
+
+    //returns the names of the independent second order constants, in input order
     static std::vector<std::string> uniqueSoec(int structure) {
-        if (structure == 9) {
-            std::vector<std::string> str = {"C11", "C12", "C13"};
-            return str;
-        }
-        else {
-            std::vector<std::string> str = {"Errpr"};
-            return str;
-        }
+        const LaueGroupTables::Table* table = symmetryTable(structure);
+        if (!table) return {};
+        return std::vector<std::string>(table->soecNames, table->soecNames + table->numberSoec);
+    }
+
+    //returns the names of the independent third order constants, in input order
+    static std::vector<std::string> uniqueToec(int structure) {
+        const LaueGroupTables::Table* table = symmetryTable(structure);
+        if (!table) return {};
+        return std::vector<std::string>(table->toecNames, table->toecNames + table->numberToec);
     }
 
     static int numberSoec(int structure) {
-        if (structure == 9) { return 5; }
-        else if (structure == 11) {return 3; }
-        else return -1;
+        const LaueGroupTables::Table* table = symmetryTable(structure);
+        return table ? table->numberSoec : -1;
     }
 
     static int numberToec(int structure) {
-        if (structure == 9) { return 10; }
-        if (structure == 11) { return 6; }
+        const LaueGroupTables::Table* table = symmetryTable(structure);
+        return table ? table->numberToec : -1;
     }
 
-    //Gets voigt notation index from full notation indices
-    static int vID(int i, int j) {
-        if (i==j && i==0) { return 0; }
-        else if (i==j && i==1) { return 1; }
-        else if (i==j && i==2) { return 2; }
-        else if (i != j && i+j==3) { return 3;}
-        else if (i != j && i+j==2) { return 4;}
-        else if (i != j && i+j==1) { return 5; }
-    }
+    //Gets voigt notation index from full notation indices: 00->0, 11->1, 22->2, 12->3, 02->4, 01->5
+    static constexpr int vID(int i, int j) { return (i == j) ? i : 6 - i - j; }
 
 
 
@@ -109,35 +116,11 @@ private:
         Eigen::TensorFixedSize<float, Eigen::Sizes<3, 3, 3, 3>> genFullSoec;
         genFullSoec.setZero();
         float arraySoec [6][6] = { }; //Aggregate initialize to 0
-        //0 -> C11, 1-> C12, etc..
-        switch(type)
-        {
-        case 9: //High symmetry hexagonal - input vector is 5 indices
-            {
-            float A = (soec[0]-soec[1])/2;
-            arraySoec[0][0] = soec[0];
-            arraySoec[0][1] = soec[1];
-            arraySoec[0][2] = soec[2];
-            arraySoec[1][1] = soec[0];
-            arraySoec[1][2] = soec[2];
-            arraySoec[2][2] = soec[3];
-            arraySoec[3][3] = soec[4];
-            arraySoec[4][4] = soec[4];
-            arraySoec[5][5] = A;
-            break;
-            }
-        case 11: //High symmetry cubic - input vector is 3 indices
-            {
-            arraySoec[0][0] = soec[0];
-            arraySoec[0][1] = soec[1];
-            arraySoec[0][2] = soec[1];
-            arraySoec[1][1] = soec[0];
-            arraySoec[1][2] = soec[1];
-            arraySoec[2][2] = soec[0];
-            arraySoec[3][3] = soec[2];
-            arraySoec[4][4] = soec[2];
-            arraySoec[5][5] = soec[2];
-            break;
+        //Sum up the contributions of the independent constants, C11 etc. in the order of the symmetry table
+        if (const LaueGroupTables::Table* table = symmetryTable(type)) {
+            for (int t = 0; t < table->soecTermCount; t++) {
+                const LaueGroupTables::SoecTerm& term = table->soecTerms[t];
+                arraySoec[term.i][term.j] += term.factor * soec[term.constant];
             }
         }
         //Apply general symm
@@ -188,66 +171,12 @@ private:
         Eigen::TensorFixedSize<float, Eigen::Sizes<3, 3, 3, 3, 3, 3>> genFullToec;
         genFullToec.setZero();
         float arrayToec [6][6][6] = { }; //Aggregate initialize to 0
-        //0 -> C111, 1-> C112, etc...
-        switch(type)
-        {
-        case 9: //High symmetry hexagonal - input vector is 10 indices
-            {
-            float A = toec[0]+ toec[1]-toec[7]; //C111+C112-C222
-            float D = -(2*toec[0]+toec[1]-3*toec[7])/4;
-            float I = (2*toec[0]-toec[1]-toec[7])/4;
-            float J = (toec[2]-toec[3])/2;
-            float K = -(toec[5]-toec[6])/2;
-            arrayToec[0][0][0] = toec[0];
-            arrayToec[0][0][1] = toec[1];
-            arrayToec[0][0][2] = toec[2];
-            arrayToec[0][1][1] = A;
-            arrayToec[0][1][2] = toec[3];
-            arrayToec[0][2][2] = toec[4];
-            arrayToec[0][3][3] = toec[5];
-            arrayToec[0][4][4] = toec[6];
-            arrayToec[0][5][5] = D;
-            arrayToec[1][1][1] = toec[7];
-            arrayToec[1][1][2] = toec[2];
-            arrayToec[1][2][2] = toec[4];
-            arrayToec[1][3][3] = toec[6];
-            arrayToec[1][4][4] = toec[5];
-            arrayToec[1][5][5] = I;
-            arrayToec[2][2][2] = toec[8];
-            arrayToec[2][3][3] = toec[9];
-            arrayToec[2][4][4] = toec[9];
-            arrayToec[2][5][5] = J;
-            arrayToec[3][4][5] = K;
-            break;
-
-
+        //Sum up the contributions of the independent constants, C111 etc. in the order of the symmetry table
+        if (const LaueGroupTables::Table* table = symmetryTable(type)) {
+            for (int t = 0; t < table->toecTermCount; t++) {
+                const LaueGroupTables::ToecTerm& term = table->toecTerms[t];
+                arrayToec[term.i][term.j][term.k] += term.factor * toec[term.constant];
             }
-        case 11: //High symmetry cubic input toec vector is 6 indices
-            {
-            arrayToec[0][0][0] = toec[0];
-            arrayToec[0][0][1] = toec[1];
-            arrayToec[0][0][2] = toec[1];
-            arrayToec[0][1][1] = toec[1];
-            arrayToec[0][1][2] = toec[2];
-            arrayToec[0][2][2] = toec[1];
-            arrayToec[0][3][3] = toec[3];
-            arrayToec[0][4][4] = toec[4];
-            arrayToec[0][5][5] = toec[4];
-            arrayToec[1][1][1] = toec[0];
-            arrayToec[1][1][2] = toec[1];
-            arrayToec[1][2][2] = toec[1];
-            arrayToec[1][3][3] = toec[4];
-            arrayToec[1][4][4] = toec[3];
-            arrayToec[1][5][5] = toec[4];
-            arrayToec[2][2][2] = toec[0];
-            arrayToec[2][3][3] = toec[4];
-            arrayToec[2][4][4] = toec[4];
-            arrayToec[2][5][5] = toec[3];
-            arrayToec[3][4][5] = toec[5];
-            break;
-
-            }
-
         }
         //Apply general symm
         for (int i = 0; i < 6; i++) {
@@ -0,0 +1,549 @@
+///////////////////////////////////////////////////////////////////////////////
+// Part of the Ovito Wallace Plugin
+//
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <plugins/wallace/Wallace.h>
+#include <eigen3/Eigen/Eigenvalues>
+#include "ElasticStabilityKernel.h"
+#include "ElasticConstants.h"
+
+namespace Ovito { namespace Particles { OVITO_BEGIN_INLINE_NAMESPACE(Modifiers) OVITO_BEGIN_INLINE_NAMESPACE(Analysis)
+
+namespace {
+
+    /// Full tensor index pairs (i,j) belonging to each Voigt index.
+    const int voigtPairs[6][2] = {{0,0}, {1,1}, {2,2}, {1,2}, {0,2}, {0,1}};
+
+    /// Factor converting tensor shear components to engineering (Voigt) shear components.
+    const float voigtFactor[6] = {1, 1, 1, 2, 2, 2};
+
+    inline float delta(int i, int j) { return (i == j) ? 1.0f : 0.0f; }
+
+    /// Voigt index of each stress component in the output order of SymmetricTensor2 (XX YY ZZ XY XZ YZ).
+    const int stressComponents[6] = {0, 1, 2, 5, 4, 3};
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    #define OVITO_WALLACE_SIMD_DISPATCH
+#endif
+}
+
+#ifdef OVITO_WALLACE_SIMD_DISPATCH
+
+namespace {
+
+    #define OVITO_WALLACE_FORCE_INLINE inline __attribute__((always_inline))
+
+    /// SIMD vector types holding one value per particle of a block (GCC/Clang vector extensions).
+    /// The generic vector code is lowered to the instruction set of the function it gets inlined into.
+    template<int W> struct Lanes {
+        typedef float Vec __attribute__((vector_size(W * sizeof(float))));
+        typedef int Mask __attribute__((vector_size(W * sizeof(int))));
+
+        /// Reciprocal square root by Newton iteration from the classic bit-level estimate.
+        /// Three iterations reach single precision without requiring an ISA-specific instruction.
+        static OVITO_WALLACE_FORCE_INLINE void rsqrt(const Vec& x, Vec& y) {
+            y = (Vec)((Mask{} + 0x5f3759df) - ((Mask)x >> 1));
+            for(int i = 0; i < 3; i++)
+                y = y * (1.5f - 0.5f * x * y * y);
+        }
+    };
+
+    /// Index of the Voigt pair (i,j) with i <= j in the packed upper triangle.
+    inline int packedIndex(int i, int j) { return i * 6 - i * (i - 1) / 2 + (j - i); }
+
+    /// Voigt index of the full tensor component (i,j).
+    inline int voigtIndex(int i, int j) { return (i == j) ? i : 6 - i - j; }
+
+    /******************************************************************************
+    * Evaluates the kernel for a block of W particles stored in structure-of-arrays
+    * layout, one SIMD lane per particle. Follows ElasticStabilityKernel::evaluate()
+    * step by step, except that the minimum eigenvalue is found by a fixed number of
+    * cyclic Jacobi sweeps so that all lanes run the same instruction stream.
+    ******************************************************************************/
+    template<int W>
+    OVITO_WALLACE_FORCE_INLINE void evaluateBlock(const float* C2, const float* const* C3, float refStabPar,
+            const typename Lanes<W>::Vec (&F)[9], const typename Lanes<W>::Vec (&n)[6],
+            typename Lanes<W>::Vec (&Cdef)[21], typename Lanes<W>::Vec (&B)[21], typename Lanes<W>::Vec (&P)[6],
+            typename Lanes<W>::Vec& stab)
+    {
+        typedef typename Lanes<W>::Vec Vec;
+        typedef typename Lanes<W>::Mask Mask;
+        const Vec zero = Vec{};
+
+        // C3.n
+        Vec C3n[6][6];
+        for(int a = 0; a < 6; a++) {
+            for(int b = a; b < 6; b++) {
+                Vec sum = zero;
+                for(int k = 0; k < 6; k++)
+                    sum += C3[k][a * 6 + b] * n[k];
+                C3n[a][b] = C3n[b][a] = sum;
+            }
+        }
+
+        // Second Piola-Kirchhoff stress.
+        for(int a = 0; a < 6; a++) {
+            Vec sum = zero;
+            for(int b = 0; b < 6; b++)
+                sum += (C2[a * 6 + b] + 0.5f * C3n[a][b]) * n[b];
+            P[a] = sum;
+        }
+
+        // D1 term.
+        Vec D1[6][6];
+        for(int w = 0; w < 6; w++) {
+            int i = voigtPairs[w][0], j = voigtPairs[w][1];
+            for(int v = 0; v < 6; v++) {
+                int k = voigtPairs[v][0], m = voigtPairs[v][1];
+                D1[w][v] = 0.5f * (F[k*3+i] * F[m*3+j] + F[m*3+i] * F[k*3+j]);
+            }
+        }
+
+        // T = ((C2 + C3.n) o f f^T) D1
+        Vec T[6][6];
+        for(int w = 0; w < 6; w++) {
+            Vec ct1[6];
+            for(int z = 0; z < 6; z++)
+                ct1[z] = (C2[w * 6 + z] + C3n[w][z]) * (voigtFactor[w] * voigtFactor[z]);
+            for(int v = 0; v < 6; v++) {
+                Vec sum = zero;
+                for(int z = 0; z < 6; z++)
+                    sum += ct1[z] * D1[z][v];
+                T[w][v] = sum;
+            }
+        }
+
+        // M = F H F^T, with H the Voigt-weighted stress (see evaluate()).
+        Vec H[3][3] = {{P[0], zero, zero}, {voigtFactor[5] * P[5], P[1], zero}, {voigtFactor[4] * P[4], voigtFactor[3] * P[3], P[2]}};
+        Vec FH[3][3], M[3][3];
+        for(int i = 0; i < 3; i++)
+            for(int j = 0; j < 3; j++)
+                FH[i][j] = F[i*3+0] * H[0][j] + F[i*3+1] * H[1][j] + F[i*3+2] * H[2][j];
+        for(int i = 0; i < 3; i++)
+            for(int j = 0; j < 3; j++)
+                M[i][j] = FH[i][0] * F[j*3+0] + FH[i][1] * F[j*3+1] + FH[i][2] * F[j*3+2];
+
+        Vec J = F[0] * (F[4] * F[8] - F[5] * F[7])
+              - F[1] * (F[3] * F[8] - F[5] * F[6])
+              + F[2] * (F[3] * F[7] - F[4] * F[6]);
+        Vec invJ = 1.0f / J;
+
+        // Cdef = 1/J * (D1^T T + D2 term), upper triangle only.
+        for(int v = 0; v < 6; v++) {
+            int r = voigtPairs[v][0], s = voigtPairs[v][1];
+            for(int y = v; y < 6; y++) {
+                int t = voigtPairs[y][0], u = voigtPairs[y][1];
+                Vec sum = zero;
+                for(int w = 0; w < 6; w++)
+                    sum += D1[w][v] * T[w][y];
+                Vec K = M[s][t] * delta(r, u) + M[s][u] * delta(r, t) + M[r][t] * delta(s, u) + M[r][u] * delta(s, t)
+                      + M[u][r] * delta(t, s) + M[u][s] * delta(t, r) + M[t][r] * delta(u, s) + M[t][s] * delta(u, r);
+                Cdef[packedIndex(v, y)] = (sum + 0.125f * K) * invJ;
+            }
+        }
+
+        // Symmetric Wallace tensor.
+        Vec A[6][6];
+        for(int w = 0; w < 6; w++) {
+            int i = voigtPairs[w][0], j = voigtPairs[w][1];
+            for(int v = w; v < 6; v++) {
+                int k = voigtPairs[v][0], m = voigtPairs[v][1];
+                Vec st = P[voigtIndex(i, m)] * delta(j, k) + P[voigtIndex(j, m)] * delta(i, k)
+                       + P[voigtIndex(i, k)] * delta(j, m) + P[voigtIndex(j, k)] * delta(i, m)
+                       - P[voigtIndex(i, j)] * delta(k, m) - P[voigtIndex(k, m)] * delta(i, j);
+                Vec b = Cdef[packedIndex(w, v)] + 0.5f * st;
+                B[packedIndex(w, v)] = b;
+                A[w][v] = A[v][w] = b;
+            }
+        }
+
+        // Smallest eigenvalue by cyclic Jacobi rotations.
+        const Mask signBit = Mask{} + (int)0x80000000;
+        for(int sweep = 0; sweep < ElasticStabilityKernel::JacobiSweeps; sweep++) {
+            for(int p = 0; p < 5; p++) {
+                for(int q = p + 1; q < 6; q++) {
+                    Vec d = A[q][q] - A[p][p];
+                    Vec absd = (Vec)((Mask)d & ~signBit);
+                    Vec absApp = (Vec)((Mask)A[p][p] & ~signBit);
+                    Vec absAqq = (Vec)((Mask)A[q][q] & ~signBit);
+                    Vec absApq = (Vec)((Mask)A[p][q] & ~signBit);
+                    // Skip rotations of negligible elements, which would otherwise drift into denormals.
+                    Vec apq = (Vec)((absApq > 1e-7f * (absApp + absAqq)) & (Mask)A[p][q]);
+                    // t = sign(d) * 2 apq / (|d| + sqrt(d^2 + 4 apq^2))
+                    Vec num = (Vec)(((Mask)(2.0f * apq)) ^ ((Mask)d & signBit));
+                    Vec r2 = d * d + 4.0f * apq * apq, rr, c;
+                    Lanes<W>::rsqrt(r2, rr);
+                    Vec t = num / (absd + r2 * rr + std::numeric_limits<float>::min());
+                    Lanes<W>::rsqrt(1.0f + t * t, c);
+                    Vec sn = t * c;
+                    A[p][p] -= t * apq;
+                    A[q][q] += t * apq;
+                    A[p][q] = A[q][p] = zero;
+                    for(int k = 0; k < 6; k++) {
+                        if(k == p || k == q) continue;
+                        Vec akp = A[k][p], akq = A[k][q];
+                        A[k][p] = A[p][k] = c * akp - sn * akq;
+                        A[k][q] = A[q][k] = sn * akp + c * akq;
+                    }
+                }
+            }
+        }
+        for(int l = 0; l < W; l++) {
+            float minEig = A[0][0][l];
+            for(int k = 1; k < 6; k++)
+                minEig = std::min(minEig, A[k][k][l]);
+            stab[l] = (refStabPar - minEig) / refStabPar;
+        }
+    }
+
+    /******************************************************************************
+    * Gathers particles into blocks of W, evaluates them, and scatters the results.
+    ******************************************************************************/
+    template<int W>
+    OVITO_WALLACE_FORCE_INLINE void evaluateRangeBatched(const ElasticStabilityKernel& kernel,
+            const Matrix3* Fin, const SymmetricTensor2* strain, size_t count,
+            FloatType* stabilityParameter, FloatType* soecDeformed, FloatType* wallaceTensor, FloatType* stress)
+    {
+        typedef typename Lanes<W>::Vec Vec;
+
+        const float* C2 = kernel.C2().data();
+        const float* C3[6];
+        for(int k = 0; k < 6; k++) C3[k] = kernel.C3()[k].data();
+
+        for(size_t start = 0; start < count; start += W) {
+            int lanes = (int)std::min<size_t>(W, count - start);
+            Vec F[9], n[6];
+            for(int l = 0; l < W; l++) {
+                // Unused lanes are padded with the undeformed state.
+                if(l < lanes) {
+                    const Matrix3& Fp = Fin[start + l];
+                    const SymmetricTensor2& E = strain[start + l];
+                    for(int i = 0; i < 3; i++)
+                        for(int j = 0; j < 3; j++)
+                            F[i*3+j][l] = (float)Fp(i, j);
+                    n[0][l] = (float)E.xx();
+                    n[1][l] = (float)E.yy();
+                    n[2][l] = (float)E.zz();
+                    n[3][l] = (float)E.yz() * 2;
+                    n[4][l] = (float)E.xz() * 2;
+                    n[5][l] = (float)E.xy() * 2;
+                }
+                else {
+                    for(int i = 0; i < 9; i++) F[i][l] = (i % 4 == 0) ? 1.0f : 0.0f;
+                    for(int i = 0; i < 6; i++) n[i][l] = 0;
+                }
+            }
+
+            Vec Cdef[21], B[21], P[6], stab;
+            evaluateBlock<W>(C2, C3, kernel.referenceEigenvalue(), F, n, Cdef, B, P, stab);
+
+            for(int l = 0; l < lanes; l++) {
+                size_t index = start + l;
+                if(stabilityParameter) stabilityParameter[index] = stab[l];
+                if(soecDeformed)
+                    for(int c = 0; c < 21; c++) soecDeformed[index * 21 + c] = Cdef[c][l];
+                if(wallaceTensor)
+                    for(int c = 0; c < 21; c++) wallaceTensor[index * 21 + c] = B[c][l];
+                if(stress)
+                    for(int c = 0; c < 6; c++) stress[index * 6 + c] = P[stressComponents[c]][l];
+            }
+        }
+    }
+
+    __attribute__((target("avx2,fma")))
+    void evaluateRangeAVX2(const ElasticStabilityKernel& kernel, const Matrix3* F, const SymmetricTensor2* strain, size_t count,
+            FloatType* stabilityParameter, FloatType* soecDeformed, FloatType* wallaceTensor, FloatType* stress)
+    {
+        evaluateRangeBatched<8>(kernel, F, strain, count, stabilityParameter, soecDeformed, wallaceTensor, stress);
+    }
+
+    __attribute__((target("avx512f")))
+    void evaluateRangeAVX512(const ElasticStabilityKernel& kernel, const Matrix3* F, const SymmetricTensor2* strain, size_t count,
+            FloatType* stabilityParameter, FloatType* soecDeformed, FloatType* wallaceTensor, FloatType* stress)
+    {
+        evaluateRangeBatched<16>(kernel, F, strain, count, stabilityParameter, soecDeformed, wallaceTensor, stress);
+    }
+}
+
+#endif
+
+/******************************************************************************
+* Constructor. Computes the reference eigenvalue of the undeformed SOEC.
+******************************************************************************/
+ElasticStabilityKernel::ElasticStabilityKernel(const Matrix6& C2, const std::array<Matrix6, 6>& C3) :
+    _C2(C2), _C3(C3), _refStabPar(minEigenvalue(C2))
+{
+}
+
+/******************************************************************************
+* Rotates the elastic constants into the simulation frame and packs them in Voigt form.
+******************************************************************************/
+std::shared_ptr<const ElasticStabilityKernel> ElasticStabilityKernel::create(int structure,
+        const std::vector<float>& soec, const std::vector<float>& toec, const AffineTransformation& CTransformation)
+{
+    //Get transformation matrix
+    Eigen::TensorFixedSize<float, Eigen::Sizes<3, 3>> ETransformation;
+    ETransformation.setZero();
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            ETransformation(i, j) = static_cast<float>(CTransformation[i][j]);
+        }
+    }
+
+    //Get approp elastic constants
+    ElasticConstants elasticConstants(structure, soec, toec);
+
+    Eigen::array<Eigen::IndexPair<int>, 1> pdT1 = { Eigen::IndexPair<int>(1, 0) };
+    Eigen::array<Eigen::IndexPair<int>, 1> pdT2 = { Eigen::IndexPair<int>(1, 1) };
+    Eigen::array<Eigen::IndexPair<int>, 1> pdT3 = { Eigen::IndexPair<int>(1, 2) };
+    Eigen::array<Eigen::IndexPair<int>, 1> pdT4 = { Eigen::IndexPair<int>(1, 3) };
+    Eigen::array<Eigen::IndexPair<int>, 1> pdT5 = { Eigen::IndexPair<int>(1, 4) };
+    Eigen::array<Eigen::IndexPair<int>, 1> pdT6 = { Eigen::IndexPair<int>(1, 5) };
+
+
+    Eigen::TensorFixedSize<float, Eigen::Sizes<3, 3, 3, 3>> fC2 = elasticConstants.fullSoec();
+    //fC2 =  (((fC2.contract(_ETransformation, pdT1)).contract(_ETransformation, pdT2)).contract(_ETransformation, pdT3)).contract(_ETransformation, pdT4);
+    //fC2 = ETransformation.contract((ETransformation.contract(ETransformation.contract(ETransformation.contract(fC2, pdT4).eval(), pdT4).eval(), pdT4)),pdT4).eval();
+    Eigen::TensorFixedSize<float, Eigen::Sizes<3, 3, 3, 3, 3, 3>> fC3 = elasticConstants.fullToec();
+    //fC3 = ETransformation.contract(ETransformation.contract(ETransformation.contract(ETransformation.contract(ETransformation.contract(ETransformation.contract(fC3, pdT6).eval(), pdT6).eval(), pdT6).eval(), pdT6).eval(), pdT6).eval(), pdT6).eval();
+    for (int i=0; i<4; i++) {
+        fC2 = ETransformation.contract(fC2, pdT4).eval();
+    }
+    for (int i=0; i<6; i++) {
+        fC3 = ETransformation.contract(fC3, pdT6).eval();
+    }
+    //fC3 = fC3.contract(_ETransformation, pdT1).eval();
+
+    //put into voigt forms
+    Eigen::TensorFixedSize<float, Eigen::Sizes<6, 6>> vC2;
+    vC2.setZero();
+    for (int i=0; i<3; i++) {
+        for (int j=0; j<3; j++) {
+            for (int k=0; k<3; k++){
+                for (int l=0; l<3; l++)
+                {   int w = ElasticConstants::vID(i, j);
+                    int v = ElasticConstants::vID(k, l);
+                    //WTensor(w, v)= L(i, j, k, l);
+                    vC2(w, v) = fC2(i, j, k, l);
+                }
+            }
+        }
+    }
+
+
+    Eigen::TensorFixedSize<float, Eigen::Sizes<6, 6, 6>> vC3;
+    vC3.setZero();
+    for (int i=0; i<3; i++) {
+        for (int j=0; j< 3; j++) {
+            for (int k=0; k < 3; k++){
+                for (int l=0; l < 3; l++) {
+                    for (int m = 0; m < 3; m++) {
+                        for (int n = 0; n < 3; n++) {
+                            int v = ElasticConstants::vID(i, j);
+                            int w = ElasticConstants::vID(k, l);
+                            int x = ElasticConstants::vID(m, n);
+                            vC3(v, w, x) = fC3(i, j, k, l, m, n);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+
+    // The kernel works on the Voigt forms only.
+    Matrix6 C2;
+    std::array<Matrix6, 6> C3;
+    for (int i = 0; i < 6; i++) {
+        for (int j = 0; j < 6; j++) {
+            C2(i, j) = vC2(i, j);
+            for (int k = 0; k < 6; k++)
+                C3[k](i, j) = vC3(i, j, k);
+        }
+    }
+    return std::make_shared<ElasticStabilityKernel>(C2, C3);
+}
+
+/******************************************************************************
+* Returns the kernel for the given parameters. Builds a new one only if they
+* differ from the parameters of the cached kernel.
+******************************************************************************/
+std::shared_ptr<const ElasticStabilityKernel> ElasticStabilityKernelCache::kernel(int structure,
+        const std::vector<float>& soec, const std::vector<float>& toec, const AffineTransformation& CTransformation)
+{
+    if(_kernel && _structure == structure && _soec == soec && _toec == toec && _CTransformation == CTransformation)
+        return _kernel;
+
+    // Check the elastic constants against the symmetry of the selected structure.
+    if(!ElasticConstants::isSupported(structure))
+        throw Exception(tr("Unsupported crystal structure type: %1").arg(structure));
+    if((int)soec.size() != ElasticConstants::numberSoec(structure))
+        throw Exception(tr("The selected structure requires %1 second order elastic constants, but %2 were given.")
+            .arg(ElasticConstants::numberSoec(structure)).arg(soec.size()));
+    if((int)toec.size() != ElasticConstants::numberToec(structure))
+        throw Exception(tr("The selected structure requires %1 third order elastic constants, but %2 were given.")
+            .arg(ElasticConstants::numberToec(structure)).arg(toec.size()));
+
+    _kernel = ElasticStabilityKernel::create(structure, soec, toec, CTransformation);
+    _structure = structure;
+    _soec = soec;
+    _toec = toec;
+    _CTransformation = CTransformation;
+    return _kernel;
+}
+
+/******************************************************************************
+* Smallest eigenvalue of a symmetric 6x6 matrix. Uses fixed-size storage only.
+******************************************************************************/
+float ElasticStabilityKernel::minEigenvalue(const Matrix6& m)
+{
+    Eigen::SelfAdjointEigenSolver<Matrix6> solver(m, Eigen::EigenvaluesOnly);
+    // Eigenvalues are returned in increasing order.
+    return solver.eigenvalues()(0);
+}
+
+/******************************************************************************
+* Evaluates the kernel for a single particle.
+*
+* With n the Voigt strain and D1, D2 the derivatives of the Lagrangian strain,
+* the deformed constants are
+*   Cdef = 1/J * [ D1^T ((C2 + C3.n) o f f^T) D1 + ((C2 + C3.n/2).n o f) . D2 ]
+* and the Wallace tensor adds the stress terms of the second Piola-Kirchhoff stress
+* P = (C2 + C3.n/2).n. The D2 contraction is carried out in closed form through
+* the 3x3 matrix M = F H F^T, with H the Voigt-weighted stress.
+******************************************************************************/
+void ElasticStabilityKernel::evaluate(const Matrix3& F, const SymmetricTensor2& strain, Result& result) const
+{
+    // Voigt form of the strain (engineering shear components).
+    Vector6 n;
+    n << (float)strain.xx(), (float)strain.yy(), (float)strain.zz(),
+         (float)strain.yz() * 2, (float)strain.xz() * 2, (float)strain.xy() * 2;
+
+    // C3.n
+    Matrix6 C3n = _C3[0] * n(0);
+    for(int k = 1; k < 6; k++)
+        C3n.noalias() += _C3[k] * n(k);
+
+    // Second Piola-Kirchhoff stress.
+    Vector6& P = result.stress;
+    P.noalias() = (_C2 + 0.5f * C3n) * n;
+
+    Eigen::Matrix3f Fe;
+    for(int i = 0; i < 3; i++)
+        for(int j = 0; j < 3; j++)
+            Fe(i, j) = (float)F(i, j);
+    float J = (float)F.determinant();
+
+    // D1 term in Voigt form.
+    Matrix6 D1;
+    for(int w = 0; w < 6; w++) {
+        int i = voigtPairs[w][0], j = voigtPairs[w][1];
+        for(int v = 0; v < 6; v++) {
+            int k = voigtPairs[v][0], l = voigtPairs[v][1];
+            D1(w, v) = 0.5f * (Fe(k, i) * Fe(l, j) + Fe(l, i) * Fe(k, j));
+        }
+    }
+
+    Matrix6 ct1;
+    for(int w = 0; w < 6; w++)
+        for(int v = 0; v < 6; v++)
+            ct1(w, v) = (_C2(w, v) + C3n(w, v)) * voigtFactor[w] * voigtFactor[v];
+
+    Matrix6& Cdef = result.soecDeformed;
+    Cdef.noalias() = D1.transpose() * (ct1 * D1);
+
+    // D2 term. The first Voigt index of D2 picks the (j,i) component with j >= i.
+    Eigen::Matrix3f H = Eigen::Matrix3f::Zero();
+    H(0, 0) = P(0);
+    H(1, 1) = P(1);
+    H(2, 2) = P(2);
+    H(2, 1) = P(3) * voigtFactor[3];
+    H(2, 0) = P(4) * voigtFactor[4];
+    H(1, 0) = P(5) * voigtFactor[5];
+    Eigen::Matrix3f M = Fe * H * Fe.transpose();
+
+    for(int v = 0; v < 6; v++) {
+        int r = voigtPairs[v][0], s = voigtPairs[v][1];
+        for(int y = v; y < 6; y++) {
+            int t = voigtPairs[y][0], u = voigtPairs[y][1];
+            float K1 = M(s, t) * delta(r, u) + M(s, u) * delta(r, t) + M(r, t) * delta(s, u) + M(r, u) * delta(s, t);
+            float K2 = M(u, r) * delta(t, s) + M(u, s) * delta(t, r) + M(t, r) * delta(u, s) + M(t, s) * delta(u, r);
+            float d2 = 0.125f * (K1 + K2);
+            Cdef(v, y) = (Cdef(v, y) + d2) / J;
+            if(y != v) Cdef(y, v) = Cdef(v, y);
+        }
+    }
+
+    // Symmetric Wallace tensor: B = Cdef + 1/2 (stress terms).
+    Eigen::Matrix3f S;
+    for(int i = 0; i < 3; i++)
+        for(int j = 0; j < 3; j++)
+            S(i, j) = P(i == j ? i : 6 - i - j);
+
+    Matrix6& B = result.wallaceTensor;
+    for(int w = 0; w < 6; w++) {
+        int i = voigtPairs[w][0], j = voigtPairs[w][1];
+        for(int v = w; v < 6; v++) {
+            int k = voigtPairs[v][0], l = voigtPairs[v][1];
+            float st = S(i, l) * delta(j, k) + S(j, l) * delta(i, k) + S(i, k) * delta(j, l) + S(j, k) * delta(i, l)
+                     - S(i, j) * delta(k, l) - S(k, l) * delta(i, j);
+            B(w, v) = B(v, w) = Cdef(w, v) + 0.5f * st;
+        }
+    }
+
+    result.stabilityParameter = (_refStabPar - minEigenvalue(B)) / _refStabPar;
+}
+
+/******************************************************************************
+* Determines the fastest code path supported by the executing CPU.
+******************************************************************************/
+ElasticStabilityKernel::InstructionSet ElasticStabilityKernel::bestInstructionSet()
+{
+#ifdef OVITO_WALLACE_SIMD_DISPATCH
+    static const InstructionSet best = []() {
+        __builtin_cpu_init();
+        if(__builtin_cpu_supports("avx512f")) return AVX512;
+        if(__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) return AVX2;
+        return Scalar;
+    }();
+    return best;
+#else
+    return Scalar;
+#endif
+}
+
+/******************************************************************************
+* Evaluates the kernel for a contiguous range of particles.
+******************************************************************************/
+void ElasticStabilityKernel::evaluateRange(const Matrix3* F, const SymmetricTensor2* strain, size_t count,
+        FloatType* stabilityParameter, FloatType* soecDeformed, FloatType* wallaceTensor, FloatType* stress,
+        InstructionSet instructionSet) const
+{
+#ifdef OVITO_WALLACE_SIMD_DISPATCH
+    if(instructionSet == AVX512) {
+        evaluateRangeAVX512(*this, F, strain, count, stabilityParameter, soecDeformed, wallaceTensor, stress);
+        return;
+    }
+    if(instructionSet == AVX2) {
+        evaluateRangeAVX2(*this, F, strain, count, stabilityParameter, soecDeformed, wallaceTensor, stress);
+        return;
+    }
+#endif
+
+    Result result;
+    for(size_t index = 0; index < count; index++) {
+        evaluate(F[index], strain[index], result);
+        if(stabilityParameter) stabilityParameter[index] = result.stabilityParameter;
+        if(soecDeformed) packUpperTriangle(result.soecDeformed, soecDeformed + index * 21);
+        if(wallaceTensor) packUpperTriangle(result.wallaceTensor, wallaceTensor + index * 21);
+        if(stress)
+            for(int c = 0; c < 6; c++) stress[index * 6 + c] = result.stress(stressComponents[c]);
+    }
+}
+
+OVITO_END_INLINE_NAMESPACE
+OVITO_END_INLINE_NAMESPACE
+}
+}
@@ -0,0 +1,131 @@
+///////////////////////////////////////////////////////////////////////////////
+// Part of the Ovito Wallace Plugin
+//
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <plugins/wallace/Wallace.h>
+#include <eigen3/Eigen/Dense>
+#include <array>
+
+namespace Ovito { namespace Particles { OVITO_BEGIN_INLINE_NAMESPACE(Modifiers) OVITO_BEGIN_INLINE_NAMESPACE(Analysis)
+
+/**
+* \brief Per-particle evaluation of the deformed elastic constants, the symmetric Wallace tensor
+*        and the elastic stability parameter.
+*
+* All operations are carried out directly in 6x6 Voigt space using fixed-size storage,
+* so that evaluating a particle does not touch the heap. The kernel is immutable after construction
+* and may be shared by all worker threads.
+*
+* Besides the per-particle evaluate() method, evaluateRange() processes blocks of 8 or 16 particles
+* in structure-of-arrays layout, which lets the compiler map the particles of a block onto SIMD lanes.
+* The instruction set is chosen at runtime; the per-particle code serves as fallback.
+*/
+class ElasticStabilityKernel
+{
+public:
+
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    using Matrix6 = Eigen::Matrix<float, 6, 6>;
+    using Vector6 = Eigen::Matrix<float, 6, 1>;
+
+    /// Output of a single kernel evaluation.
+    struct Result {
+        Matrix6 soecDeformed;       ///< Second order elastic constants at finite deformation (Voigt).
+        Matrix6 wallaceTensor;      ///< Symmetric Wallace tensor B (Voigt).
+        Vector6 stress;             ///< Second Piola-Kirchhoff stress (Voigt).
+        float stabilityParameter;   ///< Relative change of the minimum eigenvalue of B.
+    };
+
+    /// Code paths available for evaluateRange().
+    enum InstructionSet {
+        Scalar,     ///< One particle at a time through evaluate().
+        AVX2,       ///< Blocks of 8 particles using AVX2/FMA instructions.
+        AVX512      ///< Blocks of 16 particles using AVX-512 instructions.
+    };
+
+    /// Constructor taking the rotated SOEC and TOEC in Voigt notation.
+    /// The TOEC are given as six 6x6 slices: C3[k](i,j) = C_ijk.
+    ElasticStabilityKernel(const Matrix6& C2, const std::array<Matrix6, 6>& C3);
+
+    /// Builds the kernel from the independent elastic constants of the given Laue group (see ElasticConstants),
+    /// rotated into the simulation frame by the given transformation.
+    static std::shared_ptr<const ElasticStabilityKernel> create(int structure, const std::vector<float>& soec,
+            const std::vector<float>& toec, const AffineTransformation& CTransformation);
+
+    /// Evaluates the kernel for one particle, given its deformation gradient and Green-Lagrangian strain tensor.
+    void evaluate(const Matrix3& F, const SymmetricTensor2& strain, Result& result) const;
+
+    /// Evaluates the kernel for a contiguous range of particles. The results are written to the given output
+    /// arrays, which hold 1, 21, 21 and 6 values per particle respectively. Output pointers may be null.
+    /// The stress is written in the component order of SymmetricTensor2 (XX YY ZZ XY XZ YZ).
+    void evaluateRange(const Matrix3* F, const SymmetricTensor2* strain, size_t count,
+            FloatType* stabilityParameter, FloatType* soecDeformed, FloatType* wallaceTensor, FloatType* stress,
+            InstructionSet instructionSet = bestInstructionSet()) const;
+
+    /// Returns the fastest code path supported by the CPU we are running on.
+    static InstructionSet bestInstructionSet();
+
+    /// Returns the minimum eigenvalue of the undeformed SOEC matrix.
+    float referenceEigenvalue() const { return _refStabPar; }
+
+    /// Returns the SOEC in Voigt notation.
+    const Matrix6& C2() const { return _C2; }
+
+    /// Returns the TOEC slices in Voigt notation.
+    const std::array<Matrix6, 6>& C3() const { return _C3; }
+
+    /// Returns the smallest eigenvalue of a symmetric 6x6 matrix.
+    static float minEigenvalue(const Matrix6& m);
+
+    /// Packs the upper triangle of a symmetric 6x6 matrix into 21 values (M11 M12 ... M16 M22 ... M66).
+    static void packUpperTriangle(const Matrix6& m, FloatType* out) {
+        for(int i = 0; i < 6; i++)
+            for(int j = i; j < 6; j++)
+                *out++ = (FloatType)m(i, j);
+    }
+
+    /// Number of Jacobi sweeps used by the batched eigenvalue solver.
+    static constexpr int JacobiSweeps = 6;
+
+private:
+
+    Matrix6 _C2;
+    std::array<Matrix6, 6> _C3;
+    float _refStabPar;
+};
+
+/**
+* \brief Keeps the kernel built for the most recent set of modifier parameters.
+*
+* The rotated elastic constants only depend on the parameters, so a modifier can hand the
+* same kernel to the engines of all animation frames.
+*/
+class ElasticStabilityKernelCache
+{
+    Q_DECLARE_TR_FUNCTIONS(ElasticStabilityKernelCache);
+
+public:
+
+    /// Returns the kernel for the given parameters, reusing the cached one if none of them has changed.
+    /// Throws an exception if the constants do not match the structure type.
+    std::shared_ptr<const ElasticStabilityKernel> kernel(int structure, const std::vector<float>& soec,
+            const std::vector<float>& toec, const AffineTransformation& CTransformation);
+
+private:
+
+    std::shared_ptr<const ElasticStabilityKernel> _kernel;
+    int _structure = 0;
+    std::vector<float> _soec;
+    std::vector<float> _toec;
+    AffineTransformation _CTransformation;
+};
+
+OVITO_END_INLINE_NAMESPACE
+OVITO_END_INLINE_NAMESPACE
+}
+}
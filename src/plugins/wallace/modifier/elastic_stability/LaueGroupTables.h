@@ -0,0 +1,856 @@
+///////////////////////////////////////////////////////////////////////////////
+// Part of the Ovito Wallace Plugin
+//
+// Symmetry tables of the second and third order elastic constants for the
+// Laue groups listed in ElasticConstants::LaueGroups. Generated from the
+// invariance of the elastic tensors under the generators of each group.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+namespace LaueGroupTables {
+
+/// Contribution of an independent constant to the second order constant C_ij (Voigt indices, i <= j).
+struct SoecTerm {
+    int i, j;
+    int constant;   ///< Index into the input vector of independent constants.
+    float factor;
+};
+
+/// Contribution of an independent constant to the third order constant C_ijk (Voigt indices, i <= j <= k).
+struct ToecTerm {
+    int i, j, k;
+    int constant;   ///< Index into the input vector of independent constants.
+    float factor;
+};
+
+/// Independent constants of a Laue group and how they map onto the Voigt components.
+struct Table {
+    const char* name;
+    int numberSoec;
+    const char* const* soecNames;
+    int soecTermCount;
+    const SoecTerm* soecTerms;
+    int numberToec;
+    const char* const* toecNames;
+    int toecTermCount;
+    const ToecTerm* toecTerms;
+};
+
+/******************************************************************************
+* Triclinic (-1)
+******************************************************************************/
+constexpr const char* triclinicSoecNames[] = {
+    "C11", "C12", "C13", "C14", "C15", "C16", "C22", "C23", "C24", "C25",
+    "C26", "C33", "C34", "C35", "C36", "C44", "C45", "C46", "C55", "C56",
+    "C66"
+};
+constexpr SoecTerm triclinicSoec[] = {
+    {0, 0, 0, 1},
+    {0, 1, 1, 1},
+    {0, 2, 2, 1},
+    {0, 3, 3, 1},
+    {0, 4, 4, 1},
+    {0, 5, 5, 1},
+    {1, 1, 6, 1},
+    {1, 2, 7, 1},
+    {1, 3, 8, 1},
+    {1, 4, 9, 1},
+    {1, 5, 10, 1},
+    {2, 2, 11, 1},
+    {2, 3, 12, 1},
+    {2, 4, 13, 1},
+    {2, 5, 14, 1},
+    {3, 3, 15, 1},
+    {3, 4, 16, 1},
+    {3, 5, 17, 1},
+    {4, 4, 18, 1},
+    {4, 5, 19, 1},
+    {5, 5, 20, 1}
+};
+constexpr const char* triclinicToecNames[] = {
+    "C111", "C112", "C113", "C114", "C115", "C116", "C122", "C123", "C124", "C125",
+    "C126", "C133", "C134", "C135", "C136", "C144", "C145", "C146", "C155", "C156",
+    "C166", "C222", "C223", "C224", "C225", "C226", "C233", "C234", "C235", "C236",
+    "C244", "C245", "C246", "C255", "C256", "C266", "C333", "C334", "C335", "C336",
+    "C344", "C345", "C346", "C355", "C356", "C366", "C444", "C445", "C446", "C455",
+    "C456", "C466", "C555", "C556", "C566", "C666"
+};
+constexpr ToecTerm triclinicToec[] = {
+    {0, 0, 0, 0, 1},
+    {0, 0, 1, 1, 1},
+    {0, 0, 2, 2, 1},
+    {0, 0, 3, 3, 1},
+    {0, 0, 4, 4, 1},
+    {0, 0, 5, 5, 1},
+    {0, 1, 1, 6, 1},
+    {0, 1, 2, 7, 1},
+    {0, 1, 3, 8, 1},
+    {0, 1, 4, 9, 1},
+    {0, 1, 5, 10, 1},
+    {0, 2, 2, 11, 1},
+    {0, 2, 3, 12, 1},
+    {0, 2, 4, 13, 1},
+    {0, 2, 5, 14, 1},
+    {0, 3, 3, 15, 1},
+    {0, 3, 4, 16, 1},
+    {0, 3, 5, 17, 1},
+    {0, 4, 4, 18, 1},
+    {0, 4, 5, 19, 1},
+    {0, 5, 5, 20, 1},
+    {1, 1, 1, 21, 1},
+    {1, 1, 2, 22, 1},
+    {1, 1, 3, 23, 1},
+    {1, 1, 4, 24, 1},
+    {1, 1, 5, 25, 1},
+    {1, 2, 2, 26, 1},
+    {1, 2, 3, 27, 1},
+    {1, 2, 4, 28, 1},
+    {1, 2, 5, 29, 1},
+    {1, 3, 3, 30, 1},
+    {1, 3, 4, 31, 1},
+    {1, 3, 5, 32, 1},
+    {1, 4, 4, 33, 1},
+    {1, 4, 5, 34, 1},
+    {1, 5, 5, 35, 1},
+    {2, 2, 2, 36, 1},
+    {2, 2, 3, 37, 1},
+    {2, 2, 4, 38, 1},
+    {2, 2, 5, 39, 1},
+    {2, 3, 3, 40, 1},
+    {2, 3, 4, 41, 1},
+    {2, 3, 5, 42, 1},
+    {2, 4, 4, 43, 1},
+    {2, 4, 5, 44, 1},
+    {2, 5, 5, 45, 1},
+    {3, 3, 3, 46, 1},
+    {3, 3, 4, 47, 1},
+    {3, 3, 5, 48, 1},
+    {3, 4, 4, 49, 1},
+    {3, 4, 5, 50, 1},
+    {3, 5, 5, 51, 1},
+    {4, 4, 4, 52, 1},
+    {4, 4, 5, 53, 1},
+    {4, 5, 5, 54, 1},
+    {5, 5, 5, 55, 1}
+};
+
+/******************************************************************************
+* Monoclinic (2/m), diad parallel to x2
+******************************************************************************/
+constexpr const char* monoclinicSoecNames[] = {
+    "C11", "C12", "C13", "C15", "C22", "C23", "C25", "C33", "C35", "C44",
+    "C46", "C55", "C66"
+};
+constexpr SoecTerm monoclinicSoec[] = {
+    {0, 0, 0, 1},
+    {0, 1, 1, 1},
+    {0, 2, 2, 1},
+    {0, 4, 3, 1},
+    {1, 1, 4, 1},
+    {1, 2, 5, 1},
+    {1, 4, 6, 1},
+    {2, 2, 7, 1},
+    {2, 4, 8, 1},
+    {3, 3, 9, 1},
+    {3, 5, 10, 1},
+    {4, 4, 11, 1},
+    {5, 5, 12, 1}
+};
+constexpr const char* monoclinicToecNames[] = {
+    "C111", "C112", "C113", "C115", "C122", "C123", "C125", "C133", "C135", "C144",
+    "C146", "C155", "C166", "C222", "C223", "C225", "C233", "C235", "C244", "C246",
+    "C255", "C266", "C333", "C335", "C344", "C346", "C355", "C366", "C445", "C456",
+    "C555", "C566"
+};
+constexpr ToecTerm monoclinicToec[] = {
+    {0, 0, 0, 0, 1},
+    {0, 0, 1, 1, 1},
+    {0, 0, 2, 2, 1},
+    {0, 0, 4, 3, 1},
+    {0, 1, 1, 4, 1},
+    {0, 1, 2, 5, 1},
+    {0, 1, 4, 6, 1},
+    {0, 2, 2, 7, 1},
+    {0, 2, 4, 8, 1},
+    {0, 3, 3, 9, 1},
+    {0, 3, 5, 10, 1},
+    {0, 4, 4, 11, 1},
+    {0, 5, 5, 12, 1},
+    {1, 1, 1, 13, 1},
+    {1, 1, 2, 14, 1},
+    {1, 1, 4, 15, 1},
+    {1, 2, 2, 16, 1},
+    {1, 2, 4, 17, 1},
+    {1, 3, 3, 18, 1},
+    {1, 3, 5, 19, 1},
+    {1, 4, 4, 20, 1},
+    {1, 5, 5, 21, 1},
+    {2, 2, 2, 22, 1},
+    {2, 2, 4, 23, 1},
+    {2, 3, 3, 24, 1},
+    {2, 3, 5, 25, 1},
+    {2, 4, 4, 26, 1},
+    {2, 5, 5, 27, 1},
+    {3, 3, 4, 28, 1},
+    {3, 4, 5, 29, 1},
+    {4, 4, 4, 30, 1},
+    {4, 5, 5, 31, 1}
+};
+
+/******************************************************************************
+* Orthorhombic (mmm)
+******************************************************************************/
+constexpr const char* orthorhombicSoecNames[] = {
+    "C11", "C12", "C13", "C22", "C23", "C33", "C44", "C55", "C66"
+};
+constexpr SoecTerm orthorhombicSoec[] = {
+    {0, 0, 0, 1},
+    {0, 1, 1, 1},
+    {0, 2, 2, 1},
+    {1, 1, 3, 1},
+    {1, 2, 4, 1},
+    {2, 2, 5, 1},
+    {3, 3, 6, 1},
+    {4, 4, 7, 1},
+    {5, 5, 8, 1}
+};
+constexpr const char* orthorhombicToecNames[] = {
+    "C111", "C112", "C113", "C122", "C123", "C133", "C144", "C155", "C166", "C222",
+    "C223", "C233", "C244", "C255", "C266", "C333", "C344", "C355", "C366", "C456"
+};
+constexpr ToecTerm orthorhombicToec[] = {
+    {0, 0, 0, 0, 1},
+    {0, 0, 1, 1, 1},
+    {0, 0, 2, 2, 1},
+    {0, 1, 1, 3, 1},
+    {0, 1, 2, 4, 1},
+    {0, 2, 2, 5, 1},
+    {0, 3, 3, 6, 1},
+    {0, 4, 4, 7, 1},
+    {0, 5, 5, 8, 1},
+    {1, 1, 1, 9, 1},
+    {1, 1, 2, 10, 1},
+    {1, 2, 2, 11, 1},
+    {1, 3, 3, 12, 1},
+    {1, 4, 4, 13, 1},
+    {1, 5, 5, 14, 1},
+    {2, 2, 2, 15, 1},
+    {2, 3, 3, 16, 1},
+    {2, 4, 4, 17, 1},
+    {2, 5, 5, 18, 1},
+    {3, 4, 5, 19, 1}
+};
+
+/******************************************************************************
+* Tetragonal low (4/m)
+******************************************************************************/
+constexpr const char* tetragonalLowSoecNames[] = {
+    "C11", "C12", "C13", "C16", "C33", "C44", "C66"
+};
+constexpr SoecTerm tetragonalLowSoec[] = {
+    {0, 0, 0, 1},
+    {0, 1, 1, 1},
+    {0, 2, 2, 1},
+    {0, 5, 3, 1},
+    {1, 1, 0, 1},
+    {1, 2, 2, 1},
+    {1, 5, 3, -1},
+    {2, 2, 4, 1},
+    {3, 3, 5, 1},
+    {4, 4, 5, 1},
+    {5, 5, 6, 1}
+};
+constexpr const char* tetragonalLowToecNames[] = {
+    "C111", "C112", "C113", "C116", "C123", "C133", "C136", "C144", "C145", "C155",
+    "C166", "C333", "C344", "C366", "C446", "C456"
+};
+constexpr ToecTerm tetragonalLowToec[] = {
+    {0, 0, 0, 0, 1},
+    {0, 0, 1, 1, 1},
+    {0, 0, 2, 2, 1},
+    {0, 0, 5, 3, 1},
+    {0, 1, 1, 1, 1},
+    {0, 1, 2, 4, 1},
+    {0, 2, 2, 5, 1},
+    {0, 2, 5, 6, 1},
+    {0, 3, 3, 7, 1},
+    {0, 3, 4, 8, 1},
+    {0, 4, 4, 9, 1},
+    {0, 5, 5, 10, 1},
+    {1, 1, 1, 0, 1},
+    {1, 1, 2, 2, 1},
+    {1, 1, 5, 3, -1},
+    {1, 2, 2, 5, 1},
+    {1, 2, 5, 6, -1},
+    {1, 3, 3, 9, 1},
+    {1, 3, 4, 8, -1},
+    {1, 4, 4, 7, 1},
+    {1, 5, 5, 10, 1},
+    {2, 2, 2, 11, 1},
+    {2, 3, 3, 12, 1},
+    {2, 4, 4, 12, 1},
+    {2, 5, 5, 13, 1},
+    {3, 3, 5, 14, 1},
+    {3, 4, 5, 15, 1},
+    {4, 4, 5, 14, -1}
+};
+
+/******************************************************************************
+* Tetragonal high (4/mmm)
+******************************************************************************/
+constexpr const char* tetragonalHighSoecNames[] = {
+    "C11", "C12", "C13", "C33", "C44", "C66"
+};
+constexpr SoecTerm tetragonalHighSoec[] = {
+    {0, 0, 0, 1},
+    {0, 1, 1, 1},
+    {0, 2, 2, 1},
+    {1, 1, 0, 1},
+    {1, 2, 2, 1},
+    {2, 2, 3, 1},
+    {3, 3, 4, 1},
+    {4, 4, 4, 1},
+    {5, 5, 5, 1}
+};
+constexpr const char* tetragonalHighToecNames[] = {
+    "C111", "C112", "C113", "C123", "C133", "C144", "C155", "C166", "C333", "C344",
+    "C366", "C456"
+};
+constexpr ToecTerm tetragonalHighToec[] = {
+    {0, 0, 0, 0, 1},
+    {0, 0, 1, 1, 1},
+    {0, 0, 2, 2, 1},
+    {0, 1, 1, 1, 1},
+    {0, 1, 2, 3, 1},
+    {0, 2, 2, 4, 1},
+    {0, 3, 3, 5, 1},
+    {0, 4, 4, 6, 1},
+    {0, 5, 5, 7, 1},
+    {1, 1, 1, 0, 1},
+    {1, 1, 2, 2, 1},
+    {1, 2, 2, 4, 1},
+    {1, 3, 3, 6, 1},
+    {1, 4, 4, 5, 1},
+    {1, 5, 5, 7, 1},
+    {2, 2, 2, 8, 1},
+    {2, 3, 3, 9, 1},
+    {2, 4, 4, 9, 1},
+    {2, 5, 5, 10, 1},
+    {3, 4, 5, 11, 1}
+};
+
+/******************************************************************************
+* Rhombohedral low (-3)
+******************************************************************************/
+constexpr const char* rhombohedralLowSoecNames[] = {
+    "C11", "C12", "C13", "C14", "C15", "C33", "C44"
+};
+constexpr SoecTerm rhombohedralLowSoec[] = {
+    {0, 0, 0, 1},
+    {0, 1, 1, 1},
+    {0, 2, 2, 1},
+    {0, 3, 3, 1},
+    {0, 4, 4, 1},
+    {1, 1, 0, 1},
+    {1, 2, 2, 1},
+    {1, 3, 3, -1},
+    {1, 4, 4, -1},
+    {2, 2, 5, 1},
+    {3, 3, 6, 1},
+    {3, 5, 4, -1},
+    {4, 4, 6, 1},
+    {4, 5, 3, 1},
+    {5, 5, 0, 0.5f},
+    {5, 5, 1, -0.5f}
+};
+constexpr const char* rhombohedralLowToecNames[] = {
+    "C111", "C112", "C113", "C114", "C115", "C116", "C123", "C124", "C125", "C133",
+    "C134", "C135", "C144", "C145", "C155", "C222", "C333", "C344", "C444", "C445"
+};
+constexpr ToecTerm rhombohedralLowToec[] = {
+    {0, 0, 0, 0, 1},
+    {0, 0, 1, 1, 1},
+    {0, 0, 2, 2, 1},
+    {0, 0, 3, 3, 1},
+    {0, 0, 4, 4, 1},
+    {0, 0, 5, 5, 1},
+    {0, 1, 1, 0, 1},
+    {0, 1, 1, 1, 1},
+    {0, 1, 1, 15, -1},
+    {0, 1, 2, 6, 1},
+    {0, 1, 3, 7, 1},
+    {0, 1, 4, 8, 1},
+    {0, 1, 5, 5, -1},
+    {0, 2, 2, 9, 1},
+    {0, 2, 3, 10, 1},
+    {0, 2, 4, 11, 1},
+    {0, 3, 3, 12, 1},
+    {0, 3, 4, 13, 1},
+    {0, 3, 5, 4, -0.5f},
+    {0, 3, 5, 8, -1.5f},
+    {0, 4, 4, 14, 1},
+    {0, 4, 5, 3, 0.5f},
+    {0, 4, 5, 7, 1.5f},
+    {0, 5, 5, 0, -0.5f},
+    {0, 5, 5, 1, -0.25f},
+    {0, 5, 5, 15, 0.75f},
+    {1, 1, 1, 15, 1},
+    {1, 1, 2, 2, 1},
+    {1, 1, 3, 3, -1},
+    {1, 1, 3, 7, -2},
+    {1, 1, 4, 4, -1},
+    {1, 1, 4, 8, -2},
+    {1, 1, 5, 5, 1},
+    {1, 2, 2, 9, 1},
+    {1, 2, 3, 10, -1},
+    {1, 2, 4, 11, -1},
+    {1, 3, 3, 14, 1},
+    {1, 3, 4, 13, -1},
+    {1, 3, 5, 4, -0.5f},
+    {1, 3, 5, 8, 0.5f},
+    {1, 4, 4, 12, 1},
+    {1, 4, 5, 3, 0.5f},
+    {1, 4, 5, 7, -0.5f},
+    {1, 5, 5, 0, 0.5f},
+    {1, 5, 5, 1, -0.25f},
+    {1, 5, 5, 15, -0.25f},
+    {2, 2, 2, 16, 1},
+    {2, 3, 3, 17, 1},
+    {2, 3, 5, 11, -1},
+    {2, 4, 4, 17, 1},
+    {2, 4, 5, 10, 1},
+    {2, 5, 5, 2, 0.5f},
+    {2, 5, 5, 6, -0.5f},
+    {3, 3, 3, 18, 1},
+    {3, 3, 4, 19, 1},
+    {3, 3, 5, 13, 1},
+    {3, 4, 4, 18, -1},
+    {3, 4, 5, 12, -0.5f},
+    {3, 4, 5, 14, 0.5f},
+    {3, 5, 5, 7, 1},
+    {4, 4, 4, 19, -1},
+    {4, 4, 5, 13, -1},
+    {4, 5, 5, 8, 1},
+    {5, 5, 5, 5, -1}
+};
+
+/******************************************************************************
+* Rhombohedral high (-3m), diad parallel to x1
+******************************************************************************/
+constexpr const char* rhombohedralHighSoecNames[] = {
+    "C11", "C12", "C13", "C14", "C33", "C44"
+};
+constexpr SoecTerm rhombohedralHighSoec[] = {
+    {0, 0, 0, 1},
+    {0, 1, 1, 1},
+    {0, 2, 2, 1},
+    {0, 3, 3, 1},
+    {1, 1, 0, 1},
+    {1, 2, 2, 1},
+    {1, 3, 3, -1},
+    {2, 2, 4, 1},
+    {3, 3, 5, 1},
+    {4, 4, 5, 1},
+    {4, 5, 3, 1},
+    {5, 5, 0, 0.5f},
+    {5, 5, 1, -0.5f}
+};
+constexpr const char* rhombohedralHighToecNames[] = {
+    "C111", "C112", "C113", "C114", "C123", "C124", "C133", "C134", "C144", "C155",
+    "C222", "C333", "C344", "C444"
+};
+constexpr ToecTerm rhombohedralHighToec[] = {
+    {0, 0, 0, 0, 1},
+    {0, 0, 1, 1, 1},
+    {0, 0, 2, 2, 1},
+    {0, 0, 3, 3, 1},
+    {0, 1, 1, 0, 1},
+    {0, 1, 1, 1, 1},
+    {0, 1, 1, 10, -1},
+    {0, 1, 2, 4, 1},
+    {0, 1, 3, 5, 1},
+    {0, 2, 2, 6, 1},
+    {0, 2, 3, 7, 1},
+    {0, 3, 3, 8, 1},
+    {0, 4, 4, 9, 1},
+    {0, 4, 5, 3, 0.5f},
+    {0, 4, 5, 5, 1.5f},
+    {0, 5, 5, 0, -0.5f},
+    {0, 5, 5, 1, -0.25f},
+    {0, 5, 5, 10, 0.75f},
+    {1, 1, 1, 10, 1},
+    {1, 1, 2, 2, 1},
+    {1, 1, 3, 3, -1},
+    {1, 1, 3, 5, -2},
+    {1, 2, 2, 6, 1},
+    {1, 2, 3, 7, -1},
+    {1, 3, 3, 9, 1},
+    {1, 4, 4, 8, 1},
+    {1, 4, 5, 3, 0.5f},
+    {1, 4, 5, 5, -0.5f},
+    {1, 5, 5, 0, 0.5f},
+    {1, 5, 5, 1, -0.25f},
+    {1, 5, 5, 10, -0.25f},
+    {2, 2, 2, 11, 1},
+    {2, 3, 3, 12, 1},
+    {2, 4, 4, 12, 1},
+    {2, 4, 5, 7, 1},
+    {2, 5, 5, 2, 0.5f},
+    {2, 5, 5, 4, -0.5f},
+    {3, 3, 3, 13, 1},
+    {3, 4, 4, 13, -1},
+    {3, 4, 5, 8, -0.5f},
+    {3, 4, 5, 9, 0.5f},
+    {3, 5, 5, 5, 1}
+};
+
+/******************************************************************************
+* Hexagonal low (6/m)
+******************************************************************************/
+constexpr const char* hexagonalLowSoecNames[] = {
+    "C11", "C12", "C13", "C33", "C44"
+};
+constexpr SoecTerm hexagonalLowSoec[] = {
+    {0, 0, 0, 1},
+    {0, 1, 1, 1},
+    {0, 2, 2, 1},
+    {1, 1, 0, 1},
+    {1, 2, 2, 1},
+    {2, 2, 3, 1},
+    {3, 3, 4, 1},
+    {4, 4, 4, 1},
+    {5, 5, 0, 0.5f},
+    {5, 5, 1, -0.5f}
+};
+constexpr const char* hexagonalLowToecNames[] = {
+    "C111", "C112", "C113", "C116", "C123", "C133", "C144", "C145", "C155", "C222",
+    "C333", "C344"
+};
+constexpr ToecTerm hexagonalLowToec[] = {
+    {0, 0, 0, 0, 1},
+    {0, 0, 1, 1, 1},
+    {0, 0, 2, 2, 1},
+    {0, 0, 5, 3, 1},
+    {0, 1, 1, 0, 1},
+    {0, 1, 1, 1, 1},
+    {0, 1, 1, 9, -1},
+    {0, 1, 2, 4, 1},
+    {0, 1, 5, 3, -1},
+    {0, 2, 2, 5, 1},
+    {0, 3, 3, 6, 1},
+    {0, 3, 4, 7, 1},
+    {0, 4, 4, 8, 1},
+    {0, 5, 5, 0, -0.5f},
+    {0, 5, 5, 1, -0.25f},
+    {0, 5, 5, 9, 0.75f},
+    {1, 1, 1, 9, 1},
+    {1, 1, 2, 2, 1},
+    {1, 1, 5, 3, 1},
+    {1, 2, 2, 5, 1},
+    {1, 3, 3, 8, 1},
+    {1, 3, 4, 7, -1},
+    {1, 4, 4, 6, 1},
+    {1, 5, 5, 0, 0.5f},
+    {1, 5, 5, 1, -0.25f},
+    {1, 5, 5, 9, -0.25f},
+    {2, 2, 2, 10, 1},
+    {2, 3, 3, 11, 1},
+    {2, 4, 4, 11, 1},
+    {2, 5, 5, 2, 0.5f},
+    {2, 5, 5, 4, -0.5f},
+    {3, 3, 5, 7, 1},
+    {3, 4, 5, 6, -0.5f},
+    {3, 4, 5, 8, 0.5f},
+    {4, 4, 5, 7, -1},
+    {5, 5, 5, 3, -1}
+};
+
+/******************************************************************************
+* Hexagonal high (6/mmm)
+******************************************************************************/
+constexpr const char* hexagonalHighSoecNames[] = {
+    "C11", "C12", "C13", "C33", "C44"
+};
+constexpr SoecTerm hexagonalHighSoec[] = {
+    {0, 0, 0, 1},
+    {0, 1, 1, 1},
+    {0, 2, 2, 1},
+    {1, 1, 0, 1},
+    {1, 2, 2, 1},
+    {2, 2, 3, 1},
+    {3, 3, 4, 1},
+    {4, 4, 4, 1},
+    {5, 5, 0, 0.5f},
+    {5, 5, 1, -0.5f}
+};
+constexpr const char* hexagonalHighToecNames[] = {
+    "C111", "C112", "C113", "C123", "C133", "C144", "C155", "C222", "C333", "C344"
+};
+constexpr ToecTerm hexagonalHighToec[] = {
+    {0, 0, 0, 0, 1},
+    {0, 0, 1, 1, 1},
+    {0, 0, 2, 2, 1},
+    {0, 1, 1, 0, 1},
+    {0, 1, 1, 1, 1},
+    {0, 1, 1, 7, -1},
+    {0, 1, 2, 3, 1},
+    {0, 2, 2, 4, 1},
+    {0, 3, 3, 5, 1},
+    {0, 4, 4, 6, 1},
+    {0, 5, 5, 0, -0.5f},
+    {0, 5, 5, 1, -0.25f},
+    {0, 5, 5, 7, 0.75f},
+    {1, 1, 1, 7, 1},
+    {1, 1, 2, 2, 1},
+    {1, 2, 2, 4, 1},
+    {1, 3, 3, 6, 1},
+    {1, 4, 4, 5, 1},
+    {1, 5, 5, 0, 0.5f},
+    {1, 5, 5, 1, -0.25f},
+    {1, 5, 5, 7, -0.25f},
+    {2, 2, 2, 8, 1},
+    {2, 3, 3, 9, 1},
+    {2, 4, 4, 9, 1},
+    {2, 5, 5, 2, 0.5f},
+    {2, 5, 5, 3, -0.5f},
+    {3, 4, 5, 5, -0.5f},
+    {3, 4, 5, 6, 0.5f}
+};
+
+/******************************************************************************
+* Cubic low (m-3)
+******************************************************************************/
+constexpr const char* cubicLowSoecNames[] = {
+    "C11", "C12", "C44"
+};
+constexpr SoecTerm cubicLowSoec[] = {
+    {0, 0, 0, 1},
+    {0, 1, 1, 1},
+    {0, 2, 1, 1},
+    {1, 1, 0, 1},
+    {1, 2, 1, 1},
+    {2, 2, 0, 1},
+    {3, 3, 2, 1},
+    {4, 4, 2, 1},
+    {5, 5, 2, 1}
+};
+constexpr const char* cubicLowToecNames[] = {
+    "C111", "C112", "C113", "C123", "C144", "C155", "C166", "C456"
+};
+constexpr ToecTerm cubicLowToec[] = {
+    {0, 0, 0, 0, 1},
+    {0, 0, 1, 1, 1},
+    {0, 0, 2, 2, 1},
+    {0, 1, 1, 2, 1},
+    {0, 1, 2, 3, 1},
+    {0, 2, 2, 1, 1},
+    {0, 3, 3, 4, 1},
+    {0, 4, 4, 5, 1},
+    {0, 5, 5, 6, 1},
+    {1, 1, 1, 0, 1},
+    {1, 1, 2, 1, 1},
+    {1, 2, 2, 2, 1},
+    {1, 3, 3, 6, 1},
+    {1, 4, 4, 4, 1},
+    {1, 5, 5, 5, 1},
+    {2, 2, 2, 0, 1},
+    {2, 3, 3, 5, 1},
+    {2, 4, 4, 6, 1},
+    {2, 5, 5, 4, 1},
+    {3, 4, 5, 7, 1}
+};
+
+/******************************************************************************
+* Cubic high (m-3m)
+******************************************************************************/
+constexpr const char* cubicHighSoecNames[] = {
+    "C11", "C12", "C44"
+};
+constexpr SoecTerm cubicHighSoec[] = {
+    {0, 0, 0, 1},
+    {0, 1, 1, 1},
+    {0, 2, 1, 1},
+    {1, 1, 0, 1},
+    {1, 2, 1, 1},
+    {2, 2, 0, 1},
+    {3, 3, 2, 1},
+    {4, 4, 2, 1},
+    {5, 5, 2, 1}
+};
+constexpr const char* cubicHighToecNames[] = {
+    "C111", "C112", "C123", "C144", "C155", "C456"
+};
+constexpr ToecTerm cubicHighToec[] = {
+    {0, 0, 0, 0, 1},
+    {0, 0, 1, 1, 1},
+    {0, 0, 2, 1, 1},
+    {0, 1, 1, 1, 1},
+    {0, 1, 2, 2, 1},
+    {0, 2, 2, 1, 1},
+    {0, 3, 3, 3, 1},
+    {0, 4, 4, 4, 1},
+    {0, 5, 5, 4, 1},
+    {1, 1, 1, 0, 1},
+    {1, 1, 2, 1, 1},
+    {1, 2, 2, 1, 1},
+    {1, 3, 3, 4, 1},
+    {1, 4, 4, 3, 1},
+    {1, 5, 5, 4, 1},
+    {2, 2, 2, 0, 1},
+    {2, 3, 3, 4, 1},
+    {2, 4, 4, 4, 1},
+    {2, 5, 5, 3, 1},
+    {3, 4, 5, 5, 1}
+};
+
+/******************************************************************************
+* Transversely isotropic about x3
+******************************************************************************/
+constexpr const char* transverselyIsotropicSoecNames[] = {
+    "C11", "C12", "C13", "C33", "C44"
+};
+constexpr SoecTerm transverselyIsotropicSoec[] = {
+    {0, 0, 0, 1},
+    {0, 1, 1, 1},
+    {0, 2, 2, 1},
+    {1, 1, 0, 1},
+    {1, 2, 2, 1},
+    {2, 2, 3, 1},
+    {3, 3, 4, 1},
+    {4, 4, 4, 1},
+    {5, 5, 0, 0.5f},
+    {5, 5, 1, -0.5f}
+};
+constexpr const char* transverselyIsotropicToecNames[] = {
+    "C111", "C112", "C113", "C123", "C133", "C144", "C155", "C333", "C344"
+};
+constexpr ToecTerm transverselyIsotropicToec[] = {
+    {0, 0, 0, 0, 1},
+    {0, 0, 1, 1, 1},
+    {0, 0, 2, 2, 1},
+    {0, 1, 1, 1, 1},
+    {0, 1, 2, 3, 1},
+    {0, 2, 2, 4, 1},
+    {0, 3, 3, 5, 1},
+    {0, 4, 4, 6, 1},
+    {0, 5, 5, 0, 0.25f},
+    {0, 5, 5, 1, -0.25f},
+    {1, 1, 1, 0, 1},
+    {1, 1, 2, 2, 1},
+    {1, 2, 2, 4, 1},
+    {1, 3, 3, 6, 1},
+    {1, 4, 4, 5, 1},
+    {1, 5, 5, 0, 0.25f},
+    {1, 5, 5, 1, -0.25f},
+    {2, 2, 2, 7, 1},
+    {2, 3, 3, 8, 1},
+    {2, 4, 4, 8, 1},
+    {2, 5, 5, 2, 0.5f},
+    {2, 5, 5, 3, -0.5f},
+    {3, 4, 5, 5, -0.5f},
+    {3, 4, 5, 6, 0.5f}
+};
+
+/******************************************************************************
+* Isotropic
+******************************************************************************/
+constexpr const char* isotropicSoecNames[] = {
+    "C11", "C12"
+};
+constexpr SoecTerm isotropicSoec[] = {
+    {0, 0, 0, 1},
+    {0, 1, 1, 1},
+    {0, 2, 1, 1},
+    {1, 1, 0, 1},
+    {1, 2, 1, 1},
+    {2, 2, 0, 1},
+    {3, 3, 0, 0.5f},
+    {3, 3, 1, -0.5f},
+    {4, 4, 0, 0.5f},
+    {4, 4, 1, -0.5f},
+    {5, 5, 0, 0.5f},
+    {5, 5, 1, -0.5f}
+};
+constexpr const char* isotropicToecNames[] = {
+    "C111", "C112", "C123"
+};
+constexpr ToecTerm isotropicToec[] = {
+    {0, 0, 0, 0, 1},
+    {0, 0, 1, 1, 1},
+    {0, 0, 2, 1, 1},
+    {0, 1, 1, 1, 1},
+    {0, 1, 2, 2, 1},
+    {0, 2, 2, 1, 1},
+    {0, 3, 3, 1, 0.5f},
+    {0, 3, 3, 2, -0.5f},
+    {0, 4, 4, 0, 0.25f},
+    {0, 4, 4, 1, -0.25f},
+    {0, 5, 5, 0, 0.25f},
+    {0, 5, 5, 1, -0.25f},
+    {1, 1, 1, 0, 1},
+    {1, 1, 2, 1, 1},
+    {1, 2, 2, 1, 1},
+    {1, 3, 3, 0, 0.25f},
+    {1, 3, 3, 1, -0.25f},
+    {1, 4, 4, 1, 0.5f},
+    {1, 4, 4, 2, -0.5f},
+    {1, 5, 5, 0, 0.25f},
+    {1, 5, 5, 1, -0.25f},
+    {2, 2, 2, 0, 1},
+    {2, 3, 3, 0, 0.25f},
+    {2, 3, 3, 1, -0.25f},
+    {2, 4, 4, 0, 0.25f},
+    {2, 4, 4, 1, -0.25f},
+    {2, 5, 5, 1, 0.5f},
+    {2, 5, 5, 2, -0.5f},
+    {3, 4, 5, 0, 0.125f},
+    {3, 4, 5, 1, -0.375f},
+    {3, 4, 5, 2, 0.25f}
+};
+
+/// Tables indexed by ElasticConstants::LaueGroups - 1.
+constexpr Table tables[] = {
+    {"Triclinic (-1)",
+        sizeof(triclinicSoecNames) / sizeof(const char*), triclinicSoecNames, sizeof(triclinicSoec) / sizeof(SoecTerm), triclinicSoec,
+        sizeof(triclinicToecNames) / sizeof(const char*), triclinicToecNames, sizeof(triclinicToec) / sizeof(ToecTerm), triclinicToec},
+    {"Monoclinic (2/m), diad parallel to x2",
+        sizeof(monoclinicSoecNames) / sizeof(const char*), monoclinicSoecNames, sizeof(monoclinicSoec) / sizeof(SoecTerm), monoclinicSoec,
+        sizeof(monoclinicToecNames) / sizeof(const char*), monoclinicToecNames, sizeof(monoclinicToec) / sizeof(ToecTerm), monoclinicToec},
+    {"Orthorhombic (mmm)",
+        sizeof(orthorhombicSoecNames) / sizeof(const char*), orthorhombicSoecNames, sizeof(orthorhombicSoec) / sizeof(SoecTerm), orthorhombicSoec,
+        sizeof(orthorhombicToecNames) / sizeof(const char*), orthorhombicToecNames, sizeof(orthorhombicToec) / sizeof(ToecTerm), orthorhombicToec},
+    {"Tetragonal low (4/m)",
+        sizeof(tetragonalLowSoecNames) / sizeof(const char*), tetragonalLowSoecNames, sizeof(tetragonalLowSoec) / sizeof(SoecTerm), tetragonalLowSoec,
+        sizeof(tetragonalLowToecNames) / sizeof(const char*), tetragonalLowToecNames, sizeof(tetragonalLowToec) / sizeof(ToecTerm), tetragonalLowToec},
+    {"Tetragonal high (4/mmm)",
+        sizeof(tetragonalHighSoecNames) / sizeof(const char*), tetragonalHighSoecNames, sizeof(tetragonalHighSoec) / sizeof(SoecTerm), tetragonalHighSoec,
+        sizeof(tetragonalHighToecNames) / sizeof(const char*), tetragonalHighToecNames, sizeof(tetragonalHighToec) / sizeof(ToecTerm), tetragonalHighToec},
+    {"Rhombohedral low (-3)",
+        sizeof(rhombohedralLowSoecNames) / sizeof(const char*), rhombohedralLowSoecNames, sizeof(rhombohedralLowSoec) / sizeof(SoecTerm), rhombohedralLowSoec,
+        sizeof(rhombohedralLowToecNames) / sizeof(const char*), rhombohedralLowToecNames, sizeof(rhombohedralLowToec) / sizeof(ToecTerm), rhombohedralLowToec},
+    {"Rhombohedral high (-3m), diad parallel to x1",
+        sizeof(rhombohedralHighSoecNames) / sizeof(const char*), rhombohedralHighSoecNames, sizeof(rhombohedralHighSoec) / sizeof(SoecTerm), rhombohedralHighSoec,
+        sizeof(rhombohedralHighToecNames) / sizeof(const char*), rhombohedralHighToecNames, sizeof(rhombohedralHighToec) / sizeof(ToecTerm), rhombohedralHighToec},
+    {"Hexagonal low (6/m)",
+        sizeof(hexagonalLowSoecNames) / sizeof(const char*), hexagonalLowSoecNames, sizeof(hexagonalLowSoec) / sizeof(SoecTerm), hexagonalLowSoec,
+        sizeof(hexagonalLowToecNames) / sizeof(const char*), hexagonalLowToecNames, sizeof(hexagonalLowToec) / sizeof(ToecTerm), hexagonalLowToec},
+    {"Hexagonal high (6/mmm)",
+        sizeof(hexagonalHighSoecNames) / sizeof(const char*), hexagonalHighSoecNames, sizeof(hexagonalHighSoec) / sizeof(SoecTerm), hexagonalHighSoec,
+        sizeof(hexagonalHighToecNames) / sizeof(const char*), hexagonalHighToecNames, sizeof(hexagonalHighToec) / sizeof(ToecTerm), hexagonalHighToec},
+    {"Cubic low (m-3)",
+        sizeof(cubicLowSoecNames) / sizeof(const char*), cubicLowSoecNames, sizeof(cubicLowSoec) / sizeof(SoecTerm), cubicLowSoec,
+        sizeof(cubicLowToecNames) / sizeof(const char*), cubicLowToecNames, sizeof(cubicLowToec) / sizeof(ToecTerm), cubicLowToec},
+    {"Cubic high (m-3m)",
+        sizeof(cubicHighSoecNames) / sizeof(const char*), cubicHighSoecNames, sizeof(cubicHighSoec) / sizeof(SoecTerm), cubicHighSoec,
+        sizeof(cubicHighToecNames) / sizeof(const char*), cubicHighToecNames, sizeof(cubicHighToec) / sizeof(ToecTerm), cubicHighToec},
+    {"Transversely isotropic about x3",
+        sizeof(transverselyIsotropicSoecNames) / sizeof(const char*), transverselyIsotropicSoecNames, sizeof(transverselyIsotropicSoec) / sizeof(SoecTerm), transverselyIsotropicSoec,
+        sizeof(transverselyIsotropicToecNames) / sizeof(const char*), transverselyIsotropicToecNames, sizeof(transverselyIsotropicToec) / sizeof(ToecTerm), transverselyIsotropicToec},
+    {"Isotropic",
+        sizeof(isotropicSoecNames) / sizeof(const char*), isotropicSoecNames, sizeof(isotropicSoec) / sizeof(SoecTerm), isotropicSoec,
+        sizeof(isotropicToecNames) / sizeof(const char*), isotropicToecNames, sizeof(isotropicToec) / sizeof(ToecTerm), isotropicToec}
+};
+
+}
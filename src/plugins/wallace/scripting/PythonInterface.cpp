@@ -91,6 +91,26 @@ PYBIND11_MODULE(Wallace, m)
                 "Set the burgers vector to be disincluded from the atomic strain calculation."
                 "\n\n"
                 ":Default: `{0, 0, 0}`\n")
+        .def_property("burgers_vectors", &AtomicStrainModBurgers::additionalBurgersVectors, &AtomicStrainModBurgers::setAdditionalBurgersVectors,
+                "A list of further Burgers vectors, e.g. the other members of a slip family, which are removed from the displacements "
+                "together with :py:attr:`.burgersContent`. Integer multiples of the vectors are removed one after the other until no single vector shortens the displacement any further."
+                "\n\n"
+                ":Default: ``[]``\n")
+        .def_property("output_stability_parameter", &AtomicStrainModBurgers::calculateElasticStability, &AtomicStrainModBurgers::setCalculateElasticStability,
+                "Computes the elastic stability parameter of :py:class:`CalculateElasticStabilityModifier` directly from the local deformation gradients "
+                "and outputs it in the ``\"Stability Parameter\"`` particle property. The deformation gradients and strain tensors are only stored "
+                "if requested with :py:attr:`.output_deformation_gradients` and :py:attr:`.output_strain_tensors`. "
+                "The elastic constants are given by :py:attr:`.set_structure`, :py:attr:`.set_soec`, :py:attr:`.set_toec` and :py:attr:`.set_transformation_matrix`."
+                "\n\n"
+                ":Default: ``False``\n")
+        .def_property("set_structure", &AtomicStrainModBurgers::structure, &AtomicStrainModBurgers::setStructure,
+                "The structure type used in the elastic stability calculation, one of the values of :py:class:`CalculateElasticStabilityModifier.Lattice`.")
+        .def_property("set_soec", &AtomicStrainModBurgers::soec, &AtomicStrainModBurgers::setSoec,
+                "The second order elastic constants used in the elastic stability calculation.")
+        .def_property("set_toec", &AtomicStrainModBurgers::toec, &AtomicStrainModBurgers::setToec,
+                "The third order elastic constants used in the elastic stability calculation.")
+        .def_property("set_transformation_matrix", &AtomicStrainModBurgers::CTransformation, &AtomicStrainModBurgers::setCTransformation,
+                "The transformation that rotates the elastic constants into the simulation frame.")
     ;
 
 
@@ -125,6 +145,11 @@ PYBIND11_MODULE(Wallace, m)
                 "Set the burgers vector to be disincluded from the atomic strain calculation."
                 "\n\n"
                 ":Default: `{0, 0, 0}`\n")
+        .def_property("burgers_vectors", &CalculateElasticDisplacementsModifier::additionalBurgersVectors, &CalculateElasticDisplacementsModifier::setAdditionalBurgersVectors,
+                "A list of further Burgers vectors, e.g. the other members of a slip family, which are removed from the displacements "
+                "together with :py:attr:`.burgersContent`. Integer multiples of the vectors are removed one after the other until no single vector shortens the displacement any further."
+                "\n\n"
+                ":Default: ``[]``\n")
     ;
 
 
@@ -136,13 +161,26 @@ PYBIND11_MODULE(Wallace, m)
         "**Modifier outputs**"
         "* ``Stability Parameter`` (:py:class`~ovito.data.ParticleProperty`):\n"
         "The elastic stability parameter described in..."
+        "\n"
+        "* ``Wallace Tensor`` (:py:class`~ovito.data.ParticleProperty`):\n"
+        "The 21 independent components of the symmetric Wallace tensor B11 B12 ... B16 B22 ... B66.\n"
+        "Output of this property must be explicitly enabled with the :py:attr:`.output_wallace_tensor` flag.\n"
+        "* ``SOEC at finite deformation`` (:py:class`~ovito.data.ParticleProperty`):\n"
+        "The 21 independent second order elastic constants at finite deformation C11 C12 ... C16 C22 ... C66.\n"
+        "Output of this property must be explicitly enabled with the :py:attr:`.output_deformed_soec` flag.\n"
+        "* ``Stress from elastic deformation`` (:py:class`~ovito.data.ParticleProperty`):\n"
+        "The second Piola-Kirchhoff stress computed from the second and third order elastic constants, with the components XX YY ZZ XY XZ YZ. "
+        "It is kept separate from a ``Stress Tensor`` property loaded from the input file.\n"
+        "Output of this property must be explicitly enabled with the :py:attr:`.output_stress` flag.\n"
         "\n\n",
         "CalculateElasticStabilityModifier")
        .def_property("set_structure", &CalculateElasticStabilityModifier::structure, &CalculateElasticStabilityModifier::setStructure,
-                     "Choose the structure type by Laue group. "
-                     "Currently must be one of the following: \n"
-                     "Hexagonal_High \n"
-                     "Cubic_High \n")
+                     "Choose the structure type by Laue group, one of the values of :py:class:`Lattice`. "
+                     "The structure determines the number and order of the constants expected by :py:attr:`.set_soec` and :py:attr:`.set_toec`, "
+                     "e.g. C11 C12 C44 and C111 C112 C123 C144 C155 C456 for ``Cubic_High``, "
+                     "or C11 C12 C13 C33 C44 and C111 C112 C113 C123 C133 C144 C155 C222 C333 C344 for ``Hexagonal_High``. "
+                     "The symmetry axis of tetragonal, rhombohedral, hexagonal and transversely isotropic structures is x3, "
+                     "the diad of monoclinic structures is x2, and the diad of rhombohedral high structures is x1.\n")
        .def_property("set_soec", &CalculateElasticStabilityModifier::soec, &CalculateElasticStabilityModifier::setSoec,
                     "Sets the second order elastic constants. "
                      "Must be in standard reference framen \n"
@@ -155,14 +193,37 @@ PYBIND11_MODULE(Wallace, m)
                      "Set a transformation matrix "
                      "to go from standard to current frame. "
                      "This just rotates the elastic constants.")
+       .def_property("output_wallace_tensor", &CalculateElasticStabilityModifier::calculateWallaceTensor, &CalculateElasticStabilityModifier::setCalculateWallaceTensor,
+                    "Controls the output of the per-particle Wallace tensors. If ``False``, the tensors are not stored to save memory."
+                    "\n\n"
+                    ":Default: ``False``\n")
+       .def_property("output_deformed_soec", &CalculateElasticStabilityModifier::calculateSoecDeformed, &CalculateElasticStabilityModifier::setCalculateSoecDeformed,
+                    "Controls the output of the per-particle second order elastic constants at finite deformation. If ``False``, they are not stored to save memory."
+                    "\n\n"
+                    ":Default: ``False``\n")
+       .def_property("output_stress", &CalculateElasticStabilityModifier::calculateStress, &CalculateElasticStabilityModifier::setCalculateStress,
+                    "Controls the output of the per-particle stress tensors. If ``False``, the stress is not stored to save memory."
+                    "\n\n"
+                    ":Default: ``False``\n")
 
     ;
 
 
 
     py::enum_<ElasticConstants::LaueGroups>(CalculateElasticStabilityModifier_py, "Lattice")
+        .value("Triclinic", ElasticConstants::TRICLINIC)
+        .value("Monoclinic", ElasticConstants::MONOCLINIC)
+        .value("Orthorhombic", ElasticConstants::ORTHORHOMBIC)
+        .value("Tetragonal_Low", ElasticConstants::TETRAGONAL_LOW)
+        .value("Tetragonal_High", ElasticConstants::TETRAGONAL_HIGH)
+        .value("Rhombohedral_Low", ElasticConstants::RHOMBOHEDRAL_LOW)
+        .value("Rhombohedral_High", ElasticConstants::RHOMBOHEDRAL_HIGH)
+        .value("Hexagonal_Low", ElasticConstants::HEXAGONAL_LOW)
         .value("Hexagonal_High", ElasticConstants::HEXAGONAL_HIGH)
+        .value("Cubic_Low", ElasticConstants::CUBIC_LOW)
         .value("Cubic_High", ElasticConstants::CUBIC_HIGH)
+        .value("Transversely_Isotropic", ElasticConstants::TRANSVERSELEY_ISOTROPIC)
+        .value("Isotropic", ElasticConstants::ISOTROPIC)
     ;
 
 
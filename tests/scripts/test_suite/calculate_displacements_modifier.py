@@ -0,0 +1,29 @@
+from ovito.io import import_file
+from ovito.modifiers import CalculateDisplacementsModifier, PythonScriptModifier
+import numpy
+
+def compute_displacements(id_mapping = None):
+    pipeline = import_file("../../files/LAMMPS/water.wrapped.lammpstrj.gz")
+    if id_mapping:
+        def relabel(frame, data):
+            ids = data.particles_['Particle Identifier_']
+            with ids:
+                ids[...] = id_mapping(ids[...])
+        pipeline.modifiers.append(PythonScriptModifier(function = relabel))
+    pipeline.modifiers.append(CalculateDisplacementsModifier())
+    return [pipeline.compute(frame).particles['Displacement'][...] for frame in range(pipeline.source.num_frames)]
+
+# Dense identifiers are mapped through a direct-indexed table.
+reference = compute_displacements()
+assert(numpy.any(reference[-1] != 0))
+assert(all(numpy.array_equal(a, b) for a, b in zip(reference, compute_displacements(lambda ids: ids + 1000000))))
+
+# Sparse identifiers are mapped through a hash table.
+assert(all(numpy.array_equal(a, b) for a, b in zip(reference, compute_displacements(lambda ids: ids * 1000003 - 7))))
+
+# Duplicate identifiers are detected.
+try:
+    compute_displacements(lambda ids: ids // 2)
+    assert(False)
+except RuntimeError:
+    pass
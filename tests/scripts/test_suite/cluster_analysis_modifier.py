@@ -44,4 +44,47 @@ assert(data.attributes['ClusterAnalysis.largest_size'] >= 1)
 pipeline.modifiers.insert(2, VoronoiAnalysisModifier(generate_bonds=True))
 modifier.neighbor_mode = ClusterAnalysisModifier.NeighborMode.Bonding
 data = pipeline.compute()
-assert(data.attributes['ClusterAnalysis.largest_size'] == data.particles.count)
\ No newline at end of file
+assert(data.attributes['ClusterAnalysis.largest_size'] == data.particles.count)
+
+# Cluster sizes and centers of mass of the clusters in a column of particles that crosses the periodic boundaries in X and Y.
+# The particles have different masses, which weight them in the centers of mass.
+pipeline = import_file("../../files/CFG/shear.void.120.cfg")
+pipeline.modifiers.append(ComputePropertyModifier(output_property = 'Mass', expressions = ['1 + ParticleIndex % 3']))
+pipeline.modifiers.append(ExpressionSelectionModifier(expression = "(Position.X < 5 || Position.X > CellSize.X - 5) && (Position.Y < 5 || Position.Y > CellSize.Y - 5)"))
+modifier = ClusterAnalysisModifier(cutoff = 3.2, only_selected = True, sort_by_size = True, compute_com = True)
+pipeline.modifiers.append(modifier)
+data = pipeline.compute()
+cluster_ids = data.particles['Cluster'][...]
+clusters = data.series['clusters']
+sizes = clusters['Cluster Size'][...]
+centers = clusters['Center of Mass'][...]
+assert(len(sizes) == data.attributes['ClusterAnalysis.cluster_count'])
+assert(np.array_equal(sizes, np.bincount(cluster_ids)[1:]))
+assert(sizes[0] == data.attributes['ClusterAnalysis.largest_size'])
+# The column is infinite along Z, where its center of mass is not well-defined, so only X and Y are compared.
+cell_size = np.diagonal(data.cell[:,:3])[:2]
+unwrap = lambda xy: np.where(xy > cell_size / 2, xy - cell_size, xy)
+periodic_close = lambda a, b: np.allclose(a - b - np.round((a - b) / cell_size) * cell_size, 0, rtol=0, atol=1e-6)
+masses = data.particles['Mass'][cluster_ids == 1]
+expected_center = np.average(unwrap(data.particles['Position'][cluster_ids == 1][:,:2]), axis=0, weights=masses)
+assert(np.all((centers[:,:2] >= 0) & (centers[:,:2] < cell_size)))
+assert(periodic_close(centers[0][:2], expected_center))
+for cluster in range(1, len(sizes)):
+    positions = data.particles['Position'][cluster_ids == cluster + 1][:,:2]
+    reference = positions[0]
+    unwrapped = positions - np.round((positions - reference) / cell_size) * cell_size
+    expected = np.average(unwrapped, axis=0, weights=data.particles['Mass'][cluster_ids == cluster + 1])
+    assert(periodic_close(centers[cluster][:2], expected))
+
+# Bonds created with the same cutoff yield the same clusters and centers of mass, using the PBC shift vectors of the bonds.
+pipeline.modifiers.insert(len(pipeline.modifiers) - 1, CreateBondsModifier(cutoff = 3.2))
+modifier.neighbor_mode = ClusterAnalysisModifier.NeighborMode.Bonding
+bond_data = pipeline.compute()
+assert(np.array_equal(bond_data.particles['Cluster'], cluster_ids))
+assert(periodic_close(bond_data.series['clusters']['Center of Mass'][:,:2], centers[:,:2]))
+
+# Without sorting, the clusters are numbered in the order of their first particles.
+modifier.sort_by_size = False
+cluster_ids = pipeline.compute().particles['Cluster'][...]
+first_occurrence = np.unique(cluster_ids[cluster_ids != 0], return_index=True)[1]
+assert(np.all(np.diff(first_occurrence) > 0))
@@ -0,0 +1,46 @@
+import gzip
+import os
+import random
+import tempfile
+from ovito.io import import_file
+from ovito.plugins.PyScript import FileSourceImporter
+import numpy
+
+# Record decompression checkpoints every 16 KB, so that the frames below lie between many checkpoints.
+FileSourceImporter._set_gzip_checkpoint_interval(16 * 1024)
+
+rng = numpy.random.RandomState(3)
+num_frames = 24
+count = 400
+
+with tempfile.TemporaryDirectory() as tmpdir:
+    plain = os.path.join(tmpdir, "trajectory.dump")
+    with open(plain, "w") as f:
+        for frame in range(num_frames):
+            f.write("ITEM: TIMESTEP\n%d\nITEM: NUMBER OF ATOMS\n%d\n" % (frame * 100, count))
+            f.write("ITEM: BOX BOUNDS pp pp pp\n0 20\n0 20\n0 20\nITEM: ATOMS id type x y z\n")
+            positions = rng.uniform(0.0, 20.0, (count, 3))
+            for i, p in enumerate(positions):
+                f.write("%d %d %.8f %.8f %.8f\n" % (i + 1, i % 3 + 1, p[0], p[1], p[2]))
+
+    # Python's gzip module writes no seek index, so the reader has to rely on its own checkpoints.
+    compressed = plain + ".gz"
+    with open(plain, "rb") as fin, gzip.open(compressed, "wb") as fout:
+        fout.write(fin.read())
+    assert(os.path.getsize(plain) > 8 * 16 * 1024)
+
+    reference = import_file(plain, multiple_frames = True)
+    expected = [reference.compute(frame) for frame in range(num_frames)]
+
+    # Jump to the frames in random order, restarting decompression at the recorded checkpoints.
+    # The second pipeline reads the checkpoints stored in the cache directory by the first one.
+    for seed in [5, 6]:
+        imported = import_file(compressed, multiple_frames = True)
+        assert(imported.source.num_frames == num_frames)
+        order = list(range(num_frames))
+        random.Random(seed).shuffle(order)
+        for frame in order:
+            data = imported.compute(frame)
+            assert(data.attributes['Timestep'] == expected[frame].attributes['Timestep'])
+            assert(numpy.array_equal(data.particles['Position'][...], expected[frame].particles['Position'][...]))
+            assert(numpy.array_equal(data.particles['Particle Type'][...], expected[frame].particles['Particle Type'][...]))
@@ -48,3 +48,23 @@ for i in range(ntypes):
         my_total_rdf += factor * partial_rdfs[:,idx]
         idx += 1
 assert(np.allclose(my_total_rdf, total_rdf.y))
+
+# Modifiers analyzing the same particles share the neighbor finder. A finder prepared for a
+# slightly larger cutoff serves the smaller one and must yield the same neighbors.
+def compute(*modifiers):
+    pipeline = import_file("../../files/CFG/shear.void.120.cfg")
+    for m in modifiers:
+        pipeline.modifiers.append(m)
+    return pipeline.compute()
+shared = compute(CoordinationAnalysisModifier(cutoff = 3.2), CoordinationAnalysisModifier(cutoff = 3.0), ClusterAnalysisModifier(cutoff = 3.0))
+assert(np.array_equal(shared.particles['Coordination'][...], compute(CoordinationAnalysisModifier(cutoff = 3.0)).particles['Coordination'][...]))
+assert(np.array_equal(shared.particles['Cluster'][...], compute(ClusterAnalysisModifier(cutoff = 3.0)).particles['Cluster'][...]))
+
+# A Verlet list reused across the frames of a trajectory must yield the same neighbors as a list rebuilt for every frame.
+def compute_trajectory(verlet_skin):
+    pipeline = import_file("../../files/LAMMPS/water.wrapped.lammpstrj.gz")
+    pipeline.modifiers.append(CoordinationAnalysisModifier(cutoff = 3.0, verlet_skin = verlet_skin))
+    return [pipeline.compute(frame) for frame in range(pipeline.source.num_frames)]
+for a, b in zip(compute_trajectory(0.0), compute_trajectory(0.5)):
+    assert(np.array_equal(a.particles['Coordination'][...], b.particles['Coordination'][...]))
+    assert(np.allclose(a.series["coordination-rdf"].y, b.series["coordination-rdf"].y))
@@ -48,3 +48,14 @@ assert(modifier.get_pairwise_cutoff("Ti", "W") == 3.0)
 data = pipeline.compute()
 assert(data.bonds.count == 8)
 
+
+# Bonds of a larger system are created in parallel, but listed in the order of their first particle, as by a sequential loop.
+pipeline = import_file("../../files/CFG/shear.void.120.cfg")
+pipeline.modifiers.append(CreateBondsModifier(cutoff = 3.1))
+single_count = pipeline.compute().bonds.count
+pipeline.modifiers.insert(0, ReplicateModifier(num_x = 3, num_y = 3, num_z = 3))
+data = pipeline.compute()
+assert(data.bonds.count == 27 * single_count)
+topology = data.bonds['Topology'][...]
+assert(np.all(np.diff(topology[:,0]) >= 0))
+assert(len(np.unique(np.sort(topology, axis=1), axis=0)) == data.bonds.count)
@@ -0,0 +1,56 @@
+from ovito.io import import_file
+from ovito.modifiers import CalculateElasticDisplacementsModifier, PythonScriptModifier
+import numpy as np
+
+# Places the particles at the origin in the reference frame and displaces them by the given vectors in frame 1,
+# then lets the modifier remove the Burgers vectors from the displacements.
+def reduce_displacements(displacements, burgers, family = []):
+    pipeline = import_file("../../files/LAMMPS/animation.dump.gz")
+    def place(frame, data):
+        ids = data.particles['Particle Identifier']
+        with data.particles_['Position_'] as pos:
+            pos[...] = displacements[ids - 1] if frame == 1 else 0
+    pipeline.modifiers.append(PythonScriptModifier(function = place))
+    pipeline.modifiers.append(CalculateElasticDisplacementsModifier(minimum_image_convention = False,
+        burgersContent = burgers, burgers_vectors = family))
+    data = pipeline.compute(1)
+    order = np.argsort(data.particles['Particle Identifier'])
+    return data.particles['Displacement'][order]
+
+# The stepping loop the modifier used before the closed-form reduction.
+def reduce_by_stepping(u, b):
+    u = np.array(u)
+    while np.dot(u - b, u - b) < np.dot(u, u): u -= b
+    while np.dot(u + b, u + b) < np.dot(u, u): u += b
+    return u
+
+rng = np.random.RandomState(1)
+count = 32
+
+# A single Burgers vector gives the same result as the stepping loop.
+b = np.array([1.3, -0.4, 0.7])
+u = rng.uniform(-8.0, 8.0, (count, 3))
+reduced = reduce_displacements(u, b)
+assert(np.allclose(reduced, [reduce_by_stepping(v, b) for v in u], atol = 1e-10))
+
+# Exact ties are rounded towards zero, like the strict comparisons of the stepping loop.
+b = np.array([2.0, 0.0, 0.0])
+u = np.zeros((count, 3))
+u[:4,0] = [1.0, -1.0, 3.0, -5.0]
+reduced = reduce_displacements(u, b)
+assert(np.array_equal(reduced[:4,0], [1.0, -1.0, 1.0, -1.0]))
+assert(np.array_equal(reduced[:4], [reduce_by_stepping(v, b) for v in u[:4]]))
+
+# A slip family of non-orthogonal vectors in the (111) plane of an fcc crystal: the result differs from the
+# input by an integer combination of the vectors and cannot be shortened by any single vector.
+family = np.array([[0.5, -0.5, 0.0], [0.5, 0.0, -0.5], [0.0, 0.5, -0.5]]) * 3.6
+normal = np.array([1.0, 1.0, 1.0]) / np.sqrt(3.0)
+u = rng.uniform(-10.0, 10.0, (count, 3))
+reduced = reduce_displacements(u, family[0], family[1:])
+for v, r in zip(u, reduced):
+    coefficients = np.linalg.lstsq(family[:2].T, v - r, rcond = None)[0]
+    assert(np.allclose(coefficients, np.round(coefficients), atol = 1e-8))
+    assert(np.isclose(np.dot(v - r, normal), 0.0, atol = 1e-8))
+    for b in family:
+        assert(np.dot(r - b, r - b) >= np.dot(r, r) - 1e-10)
+        assert(np.dot(r + b, r + b) >= np.dot(r, r) - 1e-10)
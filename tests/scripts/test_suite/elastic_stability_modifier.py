@@ -0,0 +1,180 @@
+from ovito.io import *
+from ovito.modifiers import AffineTransformationModifier, AtomicStrainModBurgers, CalculateElasticStabilityModifier
+import numpy as np
+
+# Reference implementation of the per-particle computation, written as a direct
+# translation of the original full-notation tensor algebra.
+
+voigt = [[0, 5, 4], [5, 1, 3], [4, 3, 2]]
+
+def full_cubic(soec, toec):
+    c2 = np.zeros((6,6))
+    c2[0,0] = c2[1,1] = c2[2,2] = soec[0]
+    c2[0,1] = c2[0,2] = c2[1,2] = soec[1]
+    c2[3,3] = c2[4,4] = c2[5,5] = soec[2]
+    c2 = np.triu(c2) + np.triu(c2, 1).T
+    c3 = np.zeros((6,6,6))
+    entries = {(0,0,0): toec[0], (0,0,1): toec[1], (0,0,2): toec[1], (0,1,1): toec[1], (0,1,2): toec[2],
+               (0,2,2): toec[1], (0,3,3): toec[3], (0,4,4): toec[4], (0,5,5): toec[4], (1,1,1): toec[0],
+               (1,1,2): toec[1], (1,2,2): toec[1], (1,3,3): toec[4], (1,4,4): toec[3], (1,5,5): toec[4],
+               (2,2,2): toec[0], (2,3,3): toec[4], (2,4,4): toec[4], (2,5,5): toec[3], (3,4,5): toec[5]}
+    for (i,j,k),v in entries.items():
+        for p in [(i,j,k),(i,k,j),(j,i,k),(j,k,i),(k,i,j),(k,j,i)]:
+            c3[p] = v
+    f2 = np.zeros((3,3,3,3))
+    f3 = np.zeros((3,3,3,3,3,3))
+    for idx in np.ndindex(3,3,3,3):
+        f2[idx] = c2[voigt[idx[0]][idx[1]], voigt[idx[2]][idx[3]]]
+    for idx in np.ndindex(3,3,3,3,3,3):
+        f3[idx] = c3[voigt[idx[0]][idx[1]], voigt[idx[2]][idx[3]], voigt[idx[4]][idx[5]]]
+    return f2, f3
+
+def to_voigt(t):
+    v = np.zeros((6,) * (t.ndim // 2))
+    for idx in np.ndindex(*t.shape):
+        v[tuple(voigt[idx[2*a]][idx[2*a+1]] for a in range(t.ndim // 2))] = t[idx]
+    return v
+
+def reference_stability(F, strain, soec, toec, rotation):
+    f2, f3 = full_cubic(soec, toec)
+    for i in range(4): f2 = np.tensordot(rotation, f2, axes=([1],[3]))
+    for i in range(6): f3 = np.tensordot(rotation, f3, axes=([1],[5]))
+    vC2 = to_voigt(f2)
+    vC3 = to_voigt(f3)
+    ref = np.linalg.eigvals(vC2).real.min()
+
+    I4 = np.zeros((3,3,3,3))
+    for i,j,k,l in np.ndindex(3,3,3,3):
+        I4[i,j,k,l] = 0.5 * ((i==l and j==k) + (i==k and j==l))
+    fcorr = np.array([1,1,1,2,2,2])
+
+    n = np.array([strain[0], strain[1], strain[2], 2*strain[5], 2*strain[4], 2*strain[3]])
+    C3n = np.tensordot(vC3, n, axes=([2],[0]))
+    D1f = np.zeros((3,3,3,3))
+    for i,j,k,l in np.ndindex(3,3,3,3):
+        D1f[i,j,k,l] = 0.5 * (F[k,i]*F[l,j] + F[l,i]*F[k,j])
+    D1v = to_voigt(D1f)
+    D2A1 = np.tensordot(np.multiply.outer(F, F), I4, axes=([0],[1]))
+    D2A1 = np.tensordot(D2A1, I4, axes=([1,3],[1,0]))
+    D2f = 0.5 * (D2A1 + np.transpose(D2A1, (0,1,4,5,2,3)))
+    D2v = to_voigt(D2f)
+    ct1 = (vC2 + C3n) * np.outer(fcorr, fcorr)
+    ct2 = (vC2 + 0.5 * C3n) * fcorr[:,None]
+    Cdef1 = D1v.T @ ct1 @ D1v
+    Cdef2 = np.tensordot(np.tensordot(ct2, D2v, axes=([0],[0])), n, axes=([0],[0]))
+    Cdef = (Cdef1 + Cdef2) / np.linalg.det(F)
+    Pkst = vC2 @ n + 0.5 * C3n @ n
+    P = np.array([[Pkst[voigt[i][j]] for j in range(3)] for i in range(3)])
+    d = np.eye(3)
+    B = np.zeros((6,6))
+    for i,j,k,l in np.ndindex(3,3,3,3):
+        B[voigt[i][j], voigt[k][l]] = Cdef[voigt[i][j], voigt[k][l]] + 0.5 * (P[i,l]*d[j,k] + P[j,l]*d[i,k] + P[i,k]*d[j,l] + P[j,k]*d[i,l] - P[i,j]*d[k,l] - P[k,l]*d[i,j])
+    return (ref - np.linalg.eigvals(B).real.min()) / ref, B, Pkst
+
+pipeline = import_file("../../files/POSCAR/Ti_n1_PBE.n54_G7_V15.000.poscar.000")
+
+# Apply some strain to the atoms.
+pipeline.modifiers.append(AffineTransformationModifier(
+    transformation = [[1.02,0.03,0,0],[0,0.99,0.01,0],[0.02,0,1.01,0]],
+    transform_box = True
+))
+
+strain = AtomicStrainModBurgers(cutoff = 3.2, output_deformation_gradients = True, output_strain_tensors = True)
+strain.reference.load("../../files/POSCAR/Ti_n1_PBE.n54_G7_V15.000.poscar.000")
+pipeline.modifiers.append(strain)
+
+soec = [243.0, 145.0, 116.0]
+toec = [-2274.0, -1233.0, -48.0, -4.0, -681.0, 166.0]
+c, s = np.cos(0.3), np.sin(0.3)
+rotation = np.array([[c,-s,0],[s,c,0],[0,0,1]])
+
+modifier = CalculateElasticStabilityModifier()
+modifier.set_structure = CalculateElasticStabilityModifier.Lattice.Cubic_High
+modifier.set_soec = soec
+modifier.set_toec = toec
+modifier.set_transformation_matrix = np.hstack((rotation, np.zeros((3,1)))).tolist()
+pipeline.modifiers.append(modifier)
+
+data = pipeline.compute()
+print(data.particles['Stability Parameter'][...])
+
+for index in range(data.particles.count):
+    F = np.reshape(data.particles['Deformation Gradient'][index], (3,3), order='F')
+    E = data.particles['Strain Tensor'][index]
+    if not F.any(): continue
+    # The modifier stores the transformation column-major and applies its transpose.
+    expected = reference_stability(F, E, soec, toec, rotation.T)[0]
+    assert(np.isclose(data.particles['Stability Parameter'][index], expected, rtol=1e-3, atol=1e-3))
+
+# Changing a parameter must invalidate the constants cached by the modifier.
+soec = [250.0, 140.0, 120.0]
+modifier.set_soec = soec
+data = pipeline.compute()
+for index in range(data.particles.count):
+    F = np.reshape(data.particles['Deformation Gradient'][index], (3,3), order='F')
+    E = data.particles['Strain Tensor'][index]
+    if not F.any(): continue
+    expected = reference_stability(F, E, soec, toec, rotation.T)[0]
+    assert(np.isclose(data.particles['Stability Parameter'][index], expected, rtol=1e-3, atol=1e-3))
+
+# The optional tensor outputs are only created when requested.
+assert('Wallace Tensor' not in data.particles)
+assert('SOEC at finite deformation' not in data.particles)
+assert('Stress from elastic deformation' not in data.particles)
+
+modifier.output_wallace_tensor = True
+modifier.output_stress = True
+data = pipeline.compute()
+assert('Wallace Tensor' in data.particles)
+assert('SOEC at finite deformation' not in data.particles)
+assert('Stress from elastic deformation' in data.particles)
+assert('Stress Tensor' not in data.particles)
+
+upper = np.triu_indices(6)
+for index in range(data.particles.count):
+    F = np.reshape(data.particles['Deformation Gradient'][index], (3,3), order='F')
+    E = data.particles['Strain Tensor'][index]
+    if not F.any(): continue
+    stab, B, Pkst = reference_stability(F, E, soec, toec, rotation.T)
+    assert(np.allclose(data.particles['Wallace Tensor'][index], B[upper], rtol=1e-3, atol=1e-2))
+    # The stress is stored as XX YY ZZ XY XZ YZ.
+    assert(np.allclose(data.particles['Stress from elastic deformation'][index], Pkst[[0,1,2,5,4,3]], rtol=1e-3, atol=1e-3))
+
+# A lower symmetry given the constants of a cubic crystal must reproduce the cubic result.
+cubic_result = np.copy(data.particles['Stability Parameter'][...])
+modifier.set_structure = CalculateElasticStabilityModifier.Lattice.Orthorhombic
+modifier.set_soec = [soec[0], soec[1], soec[1], soec[0], soec[1], soec[0], soec[2], soec[2], soec[2]]
+modifier.set_toec = [toec[0], toec[1], toec[1], toec[1], toec[2], toec[1], toec[3], toec[4], toec[4], toec[0],
+                     toec[1], toec[1], toec[4], toec[3], toec[4], toec[0], toec[4], toec[4], toec[3], toec[5]]
+data = pipeline.compute()
+assert(np.allclose(data.particles['Stability Parameter'][...], cubic_result, rtol=1e-4, atol=1e-5))
+
+# The number of constants must match the selected structure.
+modifier.set_structure = CalculateElasticStabilityModifier.Lattice.Hexagonal_Low
+try:
+    pipeline.compute()
+    assert(False)
+except RuntimeError:
+    pass
+
+# The fused mode of the strain modifier computes the same stability parameter without
+# storing the intermediate tensors.
+modifier.set_structure = CalculateElasticStabilityModifier.Lattice.Cubic_High
+modifier.set_soec = soec
+modifier.set_toec = toec
+data = pipeline.compute()
+valid = data.particles['Deformation Gradient'][...].any(axis=1)
+
+fused_pipeline = import_file("../../files/POSCAR/Ti_n1_PBE.n54_G7_V15.000.poscar.000")
+fused_pipeline.modifiers.append(pipeline.modifiers[0])
+fused = AtomicStrainModBurgers(cutoff = 3.2, output_stability_parameter = True)
+fused.reference.load("../../files/POSCAR/Ti_n1_PBE.n54_G7_V15.000.poscar.000")
+fused.set_structure = CalculateElasticStabilityModifier.Lattice.Cubic_High
+fused.set_soec = soec
+fused.set_toec = toec
+fused.set_transformation_matrix = modifier.set_transformation_matrix
+fused_pipeline.modifiers.append(fused)
+fused_data = fused_pipeline.compute()
+assert('Deformation Gradient' not in fused_data.particles)
+assert('Strain Tensor' not in fused_data.particles)
+assert(np.allclose(fused_data.particles['Stability Parameter'][...][valid], data.particles['Stability Parameter'][...][valid], rtol=1e-4, atol=1e-5))
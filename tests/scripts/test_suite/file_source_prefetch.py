@@ -0,0 +1,48 @@
+from ovito.io import import_file
+import numpy as np
+
+# Positions of all frames of the trajectory, computed in an order without any sequential access pattern.
+# Such requests must not cause any frames to be loaded ahead of time.
+reference_pipeline = import_file("../../files/LAMMPS/animation.dump.gz")
+assert(reference_pipeline.source.num_frames == 11)
+reference = {}
+for frame in [0, 4, 1, 7, 2, 9, 5, 10, 3, 8, 6]:
+    data = reference_pipeline.compute(frame)
+    assert(reference_pipeline.source._prefetched_frames == [])
+    reference[frame] = np.array(data.particles['Position'])
+
+def check_frame(pipeline, frame, expected_prefetched_frames):
+    data = pipeline.compute(frame)
+    assert(data.attributes['SourceFrame'] == frame)
+    assert(np.array_equal(data.particles['Position'], reference[frame]))
+    assert(pipeline.source._prefetched_frames == expected_prefetched_frames)
+
+pipeline = import_file("../../files/LAMMPS/animation.dump.gz")
+
+# A single request of a frame does not load any other frames.
+check_frame(pipeline, 0, [])
+
+# Forward playback loads the following frames, which later requests pick up.
+check_frame(pipeline, 1, [2, 3])
+check_frame(pipeline, 2, [3, 4])
+check_frame(pipeline, 3, [4, 5])
+
+# A jump to another frame cancels the loading of the frames ahead.
+check_frame(pipeline, 9, [])
+
+# Backward playback loads the preceding frames.
+check_frame(pipeline, 8, [6, 7])
+check_frame(pipeline, 7, [5, 6])
+
+# Visiting every third frame loads the frames with the same stride once the pattern has been seen twice.
+# A separate pipeline is used, because frames whose results are still cached are not loaded again.
+strided_pipeline = import_file("../../files/LAMMPS/animation.dump.gz")
+check_frame(strided_pipeline, 0, [])
+check_frame(strided_pipeline, 3, [])
+check_frame(strided_pipeline, 6, [9])
+check_frame(strided_pipeline, 9, [])
+
+# Reloading the input file discards the frames loaded ahead of time.
+pipeline.source.load("../../files/LAMMPS/animation.dump.gz")
+assert(pipeline.source._prefetched_frames == [])
+check_frame(pipeline, 4, [])
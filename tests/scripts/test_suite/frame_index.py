@@ -0,0 +1,53 @@
+import gzip
+import os
+import tempfile
+from ovito.io import import_file
+import numpy as np
+
+# Split the reference trajectory into its frames.
+with gzip.open("../../files/LAMMPS/animation.dump.gz", "rt") as f:
+    frames = ["ITEM: TIMESTEP" + chunk for chunk in f.read().split("ITEM: TIMESTEP")[1:]]
+assert(len(frames) == 11)
+reference = import_file("../../files/LAMMPS/animation.dump.gz")
+timesteps = [reference.compute(i).attributes['Timestep'] for i in range(len(frames))]
+positions = [np.array(reference.compute(i).particles['Position']) for i in range(len(frames))]
+
+# Writes the given frames of the reference trajectory to the file and gives it a new modification time.
+def write_frames(filename, indices, mtime):
+    with open(filename, "w") as f:
+        for i in indices:
+            f.write(frames[i])
+    os.utime(filename, (mtime, mtime))
+
+# Checks that the pipeline yields the given frames of the reference trajectory.
+def check_frames(pipeline, indices):
+    assert(pipeline.source.num_frames == len(indices))
+    for frame, i in enumerate(indices):
+        data = pipeline.compute(frame)
+        assert(data.attributes['Timestep'] == timesteps[i])
+        assert(np.array_equal(data.particles['Position'], positions[i]))
+
+with tempfile.TemporaryDirectory() as tmpdir:
+    filename = os.path.join(tmpdir, "growing.dump")
+
+    # The first scan of the file writes the frame index, which a second import of the unchanged file reuses.
+    write_frames(filename, range(6), 1e9)
+    check_frames(import_file(filename), range(6))
+    pipeline = import_file(filename)
+    check_frames(pipeline, range(6))
+
+    # Frames appended to the file are found by resuming the scan after the indexed frames.
+    write_frames(filename, range(11), 1e9 + 10)
+    pipeline.source.load(filename)
+    check_frames(pipeline, range(11))
+    check_frames(import_file(filename), range(11))
+
+    # A file that has been rewritten with different contents is scanned again, even if it has grown.
+    rewritten = [10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0, 5]
+    write_frames(filename, rewritten, 1e9 + 20)
+    pipeline.source.load(filename)
+    check_frames(pipeline, rewritten)
+
+    # A file that has shrunk is scanned again.
+    write_frames(filename, [3, 4], 1e9 + 30)
+    check_frames(import_file(filename), [3, 4])
@@ -0,0 +1,58 @@
+import os
+import sys
+import tempfile
+from ovito.io import import_file
+from ovito.modifiers import SelectTypeModifier
+import numpy
+
+# Implausible atom counts in a single-frame file are rejected before any memory is allocated.
+with tempfile.TemporaryDirectory() as tmpdir:
+    filename = os.path.join(tmpdir, "corrupt.dump")
+    for count in [b"-1", b"18446744073709551615"]:
+        with open(filename, "wb") as f:
+            f.write(b"ITEM: TIMESTEP\n0\nITEM: NUMBER OF ATOMS\n" + count + b"\n")
+            f.write(b"ITEM: BOX BOUNDS pp pp pp\n0 10\n0 10\n0 10\nITEM: ATOMS type\n1\n")
+        try:
+            import_file(filename).compute()
+            assert(False)
+        except RuntimeError:
+            pass
+
+# This test imports a system with more than 2^31 particles. It needs several GB of disk space
+# and about 48 GB of memory, and is therefore only run if explicitly requested.
+if not os.environ.get('OVITO_LARGE_SYSTEM_TESTS'):
+    print("Note: Skipping large system test. Set OVITO_LARGE_SYSTEM_TESTS=1 to enable it.")
+    sys.exit()
+if not hasattr(os, 'sysconf') or os.sysconf('SC_PAGE_SIZE') * os.sysconf('SC_PHYS_PAGES') < 48 * 1024**3:
+    print("Note: Skipping large system test, because the machine has less than 48 GB of memory.")
+    sys.exit()
+
+count = 2**31 + 3
+
+with tempfile.TemporaryDirectory() as tmpdir:
+    filename = os.path.join(tmpdir, "large.dump")
+    with open(filename, "wb") as f:
+        f.write(b"ITEM: TIMESTEP\n0\n")
+        f.write(b"ITEM: NUMBER OF ATOMS\n%d\n" % count)
+        f.write(b"ITEM: BOX BOUNDS pp pp pp\n0 1000\n0 1000\n0 1000\n")
+        f.write(b"ITEM: ATOMS type\n")
+        # Particle types alternate between 1 and 2.
+        block = b"1\n2\n" * (1 << 20)
+        written = 0
+        while written + 2 * (1 << 20) <= count:
+            f.write(block)
+            written += 2 * (1 << 20)
+        f.write(block[:2 * (count - written)])
+
+    pipeline = import_file(filename)
+    pipeline.modifiers.append(SelectTypeModifier(property = 'Particle Type', types = {2}))
+    data = pipeline.compute()
+
+    assert(data.particles.count == count)
+    types = data.particles['Particle Type'][...]
+    assert(types[0] == 1 and types[-1] == 1 and types[-2] == 2)
+    assert(numpy.count_nonzero(types == 1) == (count + 1) // 2)
+    assert(data.attributes['SelectType.num_selected'] == count // 2)
+    del types
+    del data
+    del pipeline
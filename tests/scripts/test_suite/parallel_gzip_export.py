@@ -0,0 +1,44 @@
+import gzip
+import os
+import struct
+import tempfile
+from ovito.io import import_file, export_file
+from ovito.modifiers import ReplicateModifier
+import numpy
+
+# Replicate the system to produce more output than the spacing of the seek index entries (16 MB).
+pipeline = import_file("../../files/LAMMPS/water.wrapped.lammpstrj.gz")
+pipeline.modifiers.append(ReplicateModifier(num_x = 3, num_y = 3, num_z = 3))
+columns = ["Particle Identifier", "Particle Type", "Position.X", "Position.Y", "Position.Z",
+           "Velocity.X", "Velocity.Y", "Velocity.Z", "Force.X", "Force.Y", "Force.Z"]
+
+with tempfile.TemporaryDirectory() as tmpdir:
+    plain = os.path.join(tmpdir, "water.dump")
+    compressed = os.path.join(tmpdir, "water.dump.gz")
+    export_file(pipeline, plain, "lammps/dump", columns = columns, multiple_frames = True)
+    export_file(pipeline, compressed, "lammps/dump", columns = columns, multiple_frames = True)
+
+    # The blocks compressed in parallel form a gzip stream that standard decompressors accept.
+    with open(plain, "rb") as f:
+        text = f.read()
+    assert(len(text) > 16 * 1024 * 1024)
+    with gzip.open(compressed, "rb") as f:
+        assert(f.read() == text)
+
+    # The seek index is stored in empty gzip members following the compressed data.
+    with open(compressed, "rb") as f:
+        data = f.read()
+    locator = data[-38:]
+    assert(locator[:4] == b"\x1f\x8b\x08\x04" and locator[12:14] == b"OL")
+    index_start, count = struct.unpack("<QI", locator[16:28])
+    assert(count >= 1 and index_start < len(data) - len(locator))
+
+    # The importer uses the index to jump to frames in the compressed file.
+    reference = import_file(plain)
+    imported = import_file(compressed)
+    assert(imported.source.num_frames == pipeline.source.num_frames)
+    for frame in [imported.source.num_frames - 1, 1]:
+        data1 = reference.compute(frame)
+        data2 = imported.compute(frame)
+        assert(data1.attributes['Timestep'] == data2.attributes['Timestep'])
+        assert(numpy.array_equal(data1.particles['Position'][...], data2.particles['Position'][...]))
@@ -0,0 +1,97 @@
+import gzip
+import os
+import shutil
+import tempfile
+from ovito.io import import_file
+from ovito.modifiers import AffineTransformationModifier
+import numpy
+
+with tempfile.TemporaryDirectory() as tmpdir:
+    filename = os.path.join(tmpdir, "animation.dump")
+    with gzip.open("../../files/LAMMPS/animation.dump.gz", "rb") as fin, open(filename, "wb") as fout:
+        shutil.copyfileobj(fin, fout)
+
+    # The first pipeline parses the file and fills the cache, the second one reads from the cache.
+    reference = import_file(filename, cache_parsed_frames = True)
+    cached = import_file(filename, cache_parsed_frames = True)
+    assert(reference.source.num_frames == cached.source.num_frames)
+
+    for frame in [0, 1, reference.source.num_frames - 1]:
+        data1 = reference.compute(frame)
+        data2 = cached.compute(frame)
+        assert(data1.particles.count == data2.particles.count)
+        assert(numpy.array_equal(data1.cell[...], data2.cell[...]))
+        assert(data1.attributes['Timestep'] == data2.attributes['Timestep'])
+        for name in data1.particles.keys():
+            assert(numpy.array_equal(data1.particles[name][...], data2.particles[name][...]))
+        types1 = data1.particles['Particle Type'].types
+        types2 = data2.particles['Particle Type'].types
+        assert([t.id for t in types1] == [t.id for t in types2])
+        assert([t.name for t in types1] == [t.name for t in types2])
+
+    # Frames loaded from the cache reference the memory-mapped file. Modifiers operate on a private copy.
+    cached.modifiers.append(AffineTransformationModifier(transformation = [[2,0,0,0],[0,1,0,0],[0,0,1,0]]))
+    positions = reference.compute(1).particles['Position'][...]
+    transformed = cached.compute(1).particles['Position'][...]
+    assert(numpy.allclose(transformed[:,0], 2 * positions[:,0]))
+    del cached.modifiers[0]
+    assert(numpy.array_equal(cached.compute(1).particles['Position'][...], positions))
+    assert(numpy.array_equal(import_file(filename, cache_parsed_frames = True).compute(1).particles['Position'][...], positions))
+
+    # After clearing the cache, the frames are parsed again and yield the same data.
+    import ovito.io
+    ovito.io.clear_parsed_frame_cache()
+    assert(numpy.array_equal(import_file(filename, cache_parsed_frames = True).compute(1).particles['Position'][...], positions))
+    assert(numpy.array_equal(import_file(filename, cache_parsed_frames = True).compute(1).particles['Position'][...], positions))
+
+    # A modified file must be parsed again.
+    shutil.copyfile("../../files/LAMMPS/animation1.dump", filename)
+    os.utime(filename, (1e9, 1e9))
+    fresh = import_file(filename, cache_parsed_frames = True)
+    uncached = import_file(filename)
+    assert(numpy.array_equal(fresh.compute().particles['Position'][...], uncached.compute().particles['Position'][...]))
+
+# Modifiers that write a copy of a cached property from several threads at once must see the complete data.
+from ovito.modifiers import ExpandSelectionModifier
+with tempfile.TemporaryDirectory() as tmpdir:
+    filename = os.path.join(tmpdir, "selection.dump")
+    lattice = numpy.array([(x, y, z) for x in range(12) for y in range(12) for z in range(12)], dtype=float) * 1.5
+    selection = (numpy.arange(len(lattice)) % 97 == 0).astype(int)
+    with open(filename, "w") as f:
+        f.write("ITEM: TIMESTEP\n0\nITEM: NUMBER OF ATOMS\n%d\n" % len(lattice))
+        f.write("ITEM: BOX BOUNDS pp pp pp\n0 18\n0 18\n0 18\n")
+        f.write("ITEM: ATOMS id x y z selection\n")
+        for i, (p, s) in enumerate(zip(lattice, selection)):
+            f.write("%d %g %g %g %d\n" % (i + 1, p[0], p[1], p[2], s))
+
+    def expand(pipeline):
+        pipeline.modifiers.append(ExpandSelectionModifier(mode = ExpandSelectionModifier.ExpansionMode.Cutoff, cutoff = 1.6, iterations = 2))
+        return pipeline.compute().particles['Selection'][...]
+
+    uncached = expand(import_file(filename))
+    assert(numpy.count_nonzero(uncached) > numpy.count_nonzero(selection))
+    import_file(filename, cache_parsed_frames = True).compute()
+    cached = import_file(filename, cache_parsed_frames = True)
+    assert(numpy.array_equal(expand(cached), uncached))
+    # The cached input selection itself remains unchanged.
+    assert(numpy.array_equal(import_file(filename, cache_parsed_frames = True).compute().particles['Selection'][...], selection))
+
+# Frames served from the cache do not hold on to a file descriptor while their data is in use.
+if os.path.isdir("/proc/self/fd"):
+    with tempfile.TemporaryDirectory() as tmpdir:
+        filename = os.path.join(tmpdir, "frames.dump")
+        num_frames = 64
+        with open(filename, "w") as f:
+            for frame in range(num_frames):
+                f.write("ITEM: TIMESTEP\n%d\nITEM: NUMBER OF ATOMS\n2\n" % frame)
+                f.write("ITEM: BOX BOUNDS pp pp pp\n0 10\n0 10\n0 10\nITEM: ATOMS id x y z\n")
+                f.write("1 %d 0 0\n2 0 %d 0\n" % (frame % 10, frame % 10))
+        filler = import_file(filename, cache_parsed_frames = True, multiple_frames = True)
+        for frame in range(num_frames):
+            filler.compute(frame)
+        cached = import_file(filename, cache_parsed_frames = True, multiple_frames = True)
+        open_before = len(os.listdir("/proc/self/fd"))
+        frames = [cached.compute(frame) for frame in range(num_frames)]
+        assert(len(os.listdir("/proc/self/fd")) < open_before + num_frames // 2)
+        assert(all(data.particles['Position'][0][0] == frame % 10 for frame, data in enumerate(frames)))
+        del frames
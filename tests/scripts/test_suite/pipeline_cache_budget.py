@@ -0,0 +1,49 @@
+from ovito.io import import_file
+from ovito.modifiers import PythonScriptModifier
+from ovito.pipeline import Pipeline
+import numpy as np
+import time
+
+# Each frame carries a large payload array. Evaluating frame 2 is much more expensive than the others.
+payload_components = 2000
+evaluations = []
+def modify(frame, data):
+    evaluations.append(frame)
+    if frame == 2: time.sleep(1.0)
+    data.particles_.create_property('Payload', dtype=float, components=payload_components,
+        data=np.full((data.particles.count, payload_components), frame, dtype=float))
+
+def create_pipeline():
+    pipeline = import_file("../../files/LAMMPS/animation.dump.gz")
+    pipeline.modifiers.append(PythonScriptModifier(function = modify))
+    return pipeline
+
+# Returns the frames for which the modifier had to be evaluated.
+def visit(pipeline, frames):
+    del evaluations[:]
+    for frame in frames:
+        assert(np.all(pipeline.compute(frame).particles['Payload'] == frame))
+    return list(evaluations)
+
+frames = [1, 2, 3, 4, 5]
+
+# With a large budget, all visited frames are kept.
+Pipeline.cache_memory_budget = 1 << 30
+pipeline = create_pipeline()
+assert(visit(pipeline, frames) == frames)
+assert(visit(pipeline, frames) == [])
+
+# Without a budget, only the most recent frame is kept.
+Pipeline.cache_memory_budget = 0
+pipeline = create_pipeline()
+assert(visit(pipeline, frames) == frames)
+assert(visit(pipeline, [1]) == [1])
+
+# A budget for a single additional frame keeps the expensive frame and evicts the cheap ones.
+payload_bytes = 32 * payload_components * 8
+Pipeline.cache_memory_budget = payload_bytes * 3 // 2
+pipeline = create_pipeline()
+assert(visit(pipeline, frames) == frames)
+assert(visit(pipeline, [2]) == [])
+assert(visit(pipeline, [1]) == [1])
+assert(visit(pipeline, [3]) == [3])
@@ -0,0 +1,36 @@
+import gzip
+import os
+import tempfile
+from ovito.io import import_file, export_file
+from ovito.modifiers import CoordinationAnalysisModifier
+
+pipeline = import_file("../../files/LAMMPS/animation.dump.gz")
+pipeline.modifiers.append(CoordinationAnalysisModifier(cutoff = 3.0))
+num_frames = pipeline.source.num_frames
+columns = ["Particle Identifier", "Particle Type", "Position.X", "Position.Y", "Position.Z", "Coordination"]
+
+def read(filename):
+    with (gzip.open(filename, "rb") if filename.endswith(".gz") else open(filename, "rb")) as f:
+        return f.read()
+
+with tempfile.TemporaryDirectory() as tmpdir:
+    def path(name):
+        return os.path.join(tmpdir, name)
+
+    # Frames written to a single file must appear in their original order.
+    for suffix in [".xyz", ".xyz.gz"]:
+        export_file(pipeline, path("serial" + suffix), "xyz", columns = columns, multiple_frames = True)
+        export_file(pipeline, path("pipelined" + suffix), "xyz", columns = columns, multiple_frames = True, frames_in_flight = 4)
+        assert(read(path("serial" + suffix)) == read(path("pipelined" + suffix)))
+
+    # Frames written to separate files.
+    export_file(pipeline, path("serial.*.dump"), "lammps/dump", columns = columns, multiple_frames = True, every_nth_frame = 2)
+    export_file(pipeline, path("pipelined.*.dump"), "lammps/dump", columns = columns, multiple_frames = True, every_nth_frame = 2, frames_in_flight = 3)
+    for frame in range(0, num_frames, 2):
+        assert(read(path("serial.%i.dump" % frame)) == read(path("pipelined.%i.dump" % frame)))
+    assert(not os.path.exists(path("pipelined.1.dump")))
+
+    # Exporters that write frames in the main thread still get the pipeline output computed ahead of time.
+    export_file(pipeline, path("serial.txt"), "txt/attr", columns = ["Timestep", "SourceFrame"], multiple_frames = True)
+    export_file(pipeline, path("pipelined.txt"), "txt/attr", columns = ["Timestep", "SourceFrame"], multiple_frames = True, frames_in_flight = 4)
+    assert(read(path("serial.txt")) == read(path("pipelined.txt")))